@@ -0,0 +1,210 @@
+#ifndef CLP_ARENABACKEDSTRINGMAP_HPP
+#define CLP_ARENABACKEDSTRINGMAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "ErrorCode.hpp"
+#include "TraceableException.hpp"
+
+namespace clp {
+/**
+ * Template class of map from strings to values, where the keys are appended to a single contiguous
+ * arena and the table is an open-addressing (linear probing) array of offsets into the arena.
+ * Compared to `std::unordered_map<std::string, ValueType>`, inserting a key doesn't allocate a node
+ * or a string, and keys can be looked up with a `std::string_view` without being copied. Keys can't
+ * be removed individually.
+ * @tparam ValueType
+ */
+template <typename ValueType>
+class ArenaBackedStringMap {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+
+        // Methods
+        char const* what() const noexcept override {
+            return "ArenaBackedStringMap operation failed";
+        }
+    };
+
+    // Constructors
+    ArenaBackedStringMap() : m_slots(cInitialCapacity) {}
+
+    // Methods
+    /**
+     * @return The number of keys in the map
+     */
+    [[nodiscard]] auto size() const -> size_t { return m_size; }
+
+    /**
+     * @return Whether the map is empty
+     */
+    [[nodiscard]] auto empty() const -> bool { return 0 == m_size; }
+
+    /**
+     * @return The number of bytes used by the keys in the arena
+     */
+    [[nodiscard]] auto get_arena_size() const -> size_t { return m_arena.size(); }
+
+    /**
+     * @param key
+     * @return A pointer to the value mapped to the given key, or nullptr if the key doesn't exist
+     */
+    [[nodiscard]] auto find(std::string_view key) const -> ValueType const*;
+
+    /**
+     * Inserts the given key and value if the key doesn't exist
+     * @param key
+     * @param value
+     * @return A pair containing a pointer to the value mapped to the key, and whether the key was
+     * inserted. The pointer is invalidated by the next insertion.
+     * @throw ArenaBackedStringMap::OperationFailed if the key is too long
+     */
+    auto try_emplace(std::string_view key, ValueType value) -> std::pair<ValueType const*, bool>;
+
+    /**
+     * Removes all keys from the map, releasing the memory used by the arena and table
+     */
+    void clear();
+
+private:
+    // Types
+    struct Slot {
+        uint64_t hash{0};
+        // Offset of the key in the arena, or cEmptySlotOffset if the slot is empty
+        uint64_t key_offset{cEmptySlotOffset};
+        uint32_t key_length{0};
+        ValueType value{};
+    };
+
+    // Constants
+    static constexpr uint64_t cEmptySlotOffset{std::numeric_limits<uint64_t>::max()};
+    // Must be a power of two
+    static constexpr size_t cInitialCapacity{1024};
+
+    // Methods
+    /**
+     * @param key
+     * @return The hash of the given key
+     */
+    [[nodiscard]] static auto hash(std::string_view key) -> uint64_t {
+        return std::hash<std::string_view>{}(key);
+    }
+
+    /**
+     * @param hash
+     * @param key
+     * @return The index of the slot containing the given key, or of the empty slot where it would
+     * be inserted
+     */
+    [[nodiscard]] auto find_slot(uint64_t hash, std::string_view key) const -> size_t;
+
+    /**
+     * Doubles the table's capacity and reinserts every key
+     */
+    void grow();
+
+    // Variables
+    std::vector<char> m_arena;
+    std::vector<Slot> m_slots;
+    size_t m_size{0};
+};
+
+template <typename ValueType>
+auto ArenaBackedStringMap<ValueType>::find(std::string_view key) const -> ValueType const* {
+    auto const& slot = m_slots[find_slot(hash(key), key)];
+    if (cEmptySlotOffset == slot.key_offset) {
+        return nullptr;
+    }
+    return &slot.value;
+}
+
+template <typename ValueType>
+auto ArenaBackedStringMap<ValueType>::try_emplace(std::string_view key, ValueType value)
+        -> std::pair<ValueType const*, bool> {
+    if (key.length() > std::numeric_limits<uint32_t>::max()) {
+        throw OperationFailed(ErrorCode_BadParam, __FILENAME__, __LINE__);
+    }
+
+    auto const key_hash = hash(key);
+    auto slot_ix = find_slot(key_hash, key);
+    if (cEmptySlotOffset != m_slots[slot_ix].key_offset) {
+        return {&m_slots[slot_ix].value, false};
+    }
+
+    // Keep the load factor at or below 3/4 so probe sequences stay short
+    if ((m_size + 1) * 4 > m_slots.size() * 3) {
+        grow();
+        slot_ix = find_slot(key_hash, key);
+    }
+
+    auto& slot = m_slots[slot_ix];
+    slot.hash = key_hash;
+    slot.key_offset = m_arena.size();
+    slot.key_length = static_cast<uint32_t>(key.length());
+    slot.value = std::move(value);
+    m_arena.insert(m_arena.end(), key.cbegin(), key.cend());
+    ++m_size;
+
+    return {&slot.value, true};
+}
+
+template <typename ValueType>
+void ArenaBackedStringMap<ValueType>::clear() {
+    m_arena = {};
+    m_slots = std::vector<Slot>(cInitialCapacity);
+    m_size = 0;
+}
+
+template <typename ValueType>
+auto ArenaBackedStringMap<ValueType>::find_slot(uint64_t hash, std::string_view key) const
+        -> size_t {
+    // The table is never full, so the probe sequence always reaches an empty slot
+    auto const slot_ix_mask = m_slots.size() - 1;
+    auto slot_ix = static_cast<size_t>(hash) & slot_ix_mask;
+    while (true) {
+        auto const& slot = m_slots[slot_ix];
+        if (cEmptySlotOffset == slot.key_offset) {
+            return slot_ix;
+        }
+        // Only compare the keys' bytes if their hashes and lengths match
+        if (hash == slot.hash && key.length() == slot.key_length
+            && key == std::string_view{m_arena.data() + slot.key_offset, slot.key_length})
+        {
+            return slot_ix;
+        }
+        slot_ix = (slot_ix + 1) & slot_ix_mask;
+    }
+}
+
+template <typename ValueType>
+void ArenaBackedStringMap<ValueType>::grow() {
+    auto const old_slots = std::exchange(m_slots, std::vector<Slot>(m_slots.size() * 2));
+
+    // Since every key is unique, each one can be placed in the first empty slot of its probe
+    // sequence without comparing keys
+    auto const slot_ix_mask = m_slots.size() - 1;
+    for (auto const& old_slot : old_slots) {
+        if (cEmptySlotOffset == old_slot.key_offset) {
+            continue;
+        }
+        auto slot_ix = static_cast<size_t>(old_slot.hash) & slot_ix_mask;
+        while (cEmptySlotOffset != m_slots[slot_ix].key_offset) {
+            slot_ix = (slot_ix + 1) & slot_ix_mask;
+        }
+        m_slots[slot_ix] = old_slot;
+    }
+}
+}  // namespace clp
+
+#endif  // CLP_ARENABACKEDSTRINGMAP_HPP
@@ -29,7 +29,8 @@ CurlDownloadHandler::CurlDownloadHandler(
         bool disable_caching,
         std::chrono::seconds connection_timeout,
         std::chrono::seconds overall_timeout,
-        std::optional<std::unordered_map<std::string, std::string>> const& http_header_kv_pairs
+        std::optional<std::unordered_map<std::string, std::string>> const& http_header_kv_pairs,
+        std::optional<size_t> end_offset
 )
         : m_error_msg_buf{std::move(error_msg_buf)} {
     if (nullptr != m_error_msg_buf) {
@@ -66,7 +67,26 @@ CurlDownloadHandler::CurlDownloadHandler(
             cCacheControlHeaderName,
             cPragmaHeaderName
     };
-    if (0 != offset) {
+    if (end_offset.has_value()) {
+        if (end_offset.value() <= offset) {
+            throw CurlOperationFailed(
+                    ErrorCode_BadParam,
+                    __FILE__,
+                    __LINE__,
+                    CURLE_BAD_FUNCTION_ARGUMENT,
+                    fmt::format(
+                            "`CurlDownloadHandler` failed to construct with an empty byte range: "
+                            "[{}, {})",
+                            offset,
+                            end_offset.value()
+                    )
+            );
+        }
+        // The last byte position in an HTTP range is inclusive
+        m_http_headers.append(
+                fmt::format("{}: bytes={}-{}", cRangeHeaderName, offset, end_offset.value() - 1)
+        );
+    } else if (0 != offset) {
         m_http_headers.append(fmt::format("{}: bytes={}-", cRangeHeaderName, offset));
     }
     if (disable_caching) {
@@ -58,6 +58,8 @@ public:
      * `connection_timeout`. Doc: https://curl.se/libcurl/c/CURLOPT_TIMEOUT.html
      * @param http_header_kv_pairs Key-value pairs representing HTTP headers to pass to the server
      * in the download request. Doc: https://curl.se/libcurl/c/CURLOPT_HTTPHEADER.html
+     * @param end_offset Index of the byte at which to stop the download (exclusive), or
+     * `std::nullopt` to download until the end of the data.
      * @throw CurlOperationFailed if an error occurs.
      */
     explicit CurlDownloadHandler(
@@ -71,7 +73,8 @@ public:
             std::chrono::seconds connection_timeout = cDefaultConnectionTimeout,
             std::chrono::seconds overall_timeout = cDefaultOverallTimeout,
             std::optional<std::unordered_map<std::string, std::string>> const& http_header_kv_pairs
-            = std::nullopt
+            = std::nullopt,
+            std::optional<size_t> end_offset = std::nullopt
     );
 
     // Disable copy/move constructors/assignment operators
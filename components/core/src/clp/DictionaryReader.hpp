@@ -1,7 +1,10 @@
 #ifndef CLP_DICTIONARYREADER_HPP
 #define CLP_DICTIONARYREADER_HPP
 
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <boost/algorithm/string.hpp>
@@ -9,6 +12,7 @@
 
 #include "dictionary_utils.hpp"
 #include "DictionaryEntry.hpp"
+#include "DictionaryWildcardIndex.hpp"
 #include "FileReader.hpp"
 #include "streaming_compression/passthrough/Decompressor.hpp"
 #include "streaming_compression/zstd/Decompressor.hpp"
@@ -87,7 +91,9 @@ public:
     std::vector<EntryType const*>
     get_entry_matching_value(std::string const& search_string, bool ignore_case) const;
     /**
-     * Gets the entries that match a given wildcard string
+     * Gets the entries that match a given wildcard string. Wildcard strings with a literal prefix
+     * or suffix are only matched against the entries with that prefix or suffix, using an index
+     * that is built the second time such a wildcard string is searched for.
      * @param wildcard_string
      * @param ignore_case
      * @param entries Set in which to store found entries
@@ -105,6 +111,22 @@ protected:
      */
     void read_segment_ids();
 
+    /**
+     * Gets the wildcard index over the entries' values (or their lower-cased values when
+     * `ignore_case` is true), building it if necessary.
+     * @param wildcard_string
+     * @param ignore_case
+     * @return The wildcard index, or nullptr if the wildcard string has no literal prefix or suffix
+     * or the dictionary hasn't been searched often enough to be worth indexing
+     */
+    DictionaryWildcardIndex const*
+    try_get_wildcard_index(std::string const& wildcard_string, bool ignore_case) const;
+
+    /**
+     * Clears the wildcard indexes, e.g., after the entries have changed.
+     */
+    void clear_wildcard_indexes();
+
     // Variables
     bool m_is_open;
     std::unique_ptr<FileReader> m_dictionary_file_reader;
@@ -120,6 +142,13 @@ protected:
 #endif
     size_t m_num_segments_read_from_index;
     std::vector<EntryType> m_entries;
+
+    // Wildcard indexes built on demand by `get_entries_matching_wildcard_string`
+    static constexpr size_t cNumAnchoredWildcardScansBeforeIndexing = 1;
+    mutable size_t m_num_anchored_wildcard_scans{0};
+    mutable std::unique_ptr<DictionaryWildcardIndex> m_wildcard_index;
+    mutable std::vector<std::string> m_lowercase_values;
+    mutable std::unique_ptr<DictionaryWildcardIndex> m_lowercase_wildcard_index;
 };
 
 template <typename DictionaryIdType, typename EntryType>
@@ -164,6 +193,7 @@ void DictionaryReader<DictionaryIdType, EntryType>::close() {
 
     m_num_segments_read_from_index = 0;
     m_entries.clear();
+    clear_wildcard_indexes();
 
     m_is_open = false;
 }
@@ -184,6 +214,7 @@ void DictionaryReader<DictionaryIdType, EntryType>::read_new_entries() {
 
     // Read new dictionary entries
     if (num_dictionary_entries > m_entries.size()) {
+        clear_wildcard_indexes();
         auto prev_num_dictionary_entries = m_entries.size();
         m_entries.resize(num_dictionary_entries);
 
@@ -267,7 +298,30 @@ void DictionaryReader<DictionaryIdType, EntryType>::get_entries_matching_wildcar
         bool ignore_case,
         std::unordered_set<EntryType const*>& entries
 ) const {
-    for (auto const& entry : m_entries) {
+    auto const* index = try_get_wildcard_index(wildcard_string, ignore_case);
+    if (nullptr == index) {
+        for (auto const& entry : m_entries) {
+            if (string_utils::wildcard_match_unsafe(
+                        entry.get_value(),
+                        wildcard_string,
+                        false == ignore_case
+                ))
+            {
+                entries.insert(&entry);
+            }
+        }
+        return;
+    }
+
+    std::string lowercase_wildcard_string;
+    if (ignore_case) {
+        lowercase_wildcard_string = wildcard_string;
+        string_utils::to_lower(lowercase_wildcard_string);
+    }
+    auto const candidate_ids
+            = index->get_candidate_ids(ignore_case ? lowercase_wildcard_string : wildcard_string);
+    for (auto const id : candidate_ids.value()) {
+        auto const& entry = m_entries[id];
         if (string_utils::wildcard_match_unsafe(
                     entry.get_value(),
                     wildcard_string,
@@ -279,6 +333,58 @@ void DictionaryReader<DictionaryIdType, EntryType>::get_entries_matching_wildcar
     }
 }
 
+template <typename DictionaryIdType, typename EntryType>
+DictionaryWildcardIndex const*
+DictionaryReader<DictionaryIdType, EntryType>::try_get_wildcard_index(
+        std::string const& wildcard_string,
+        bool ignore_case
+) const {
+    std::string prefix;
+    std::string suffix;
+    DictionaryWildcardIndex::get_literal_prefix_and_suffix(wildcard_string, prefix, suffix);
+    if (prefix.empty() && suffix.empty()) {
+        return nullptr;
+    }
+
+    auto& index = ignore_case ? m_lowercase_wildcard_index : m_wildcard_index;
+    if (nullptr != index) {
+        return index.get();
+    }
+
+    // Building an index costs more than a single scan, so only build one once the dictionary is
+    // searched repeatedly
+    ++m_num_anchored_wildcard_scans;
+    if (m_num_anchored_wildcard_scans <= cNumAnchoredWildcardScansBeforeIndexing) {
+        return nullptr;
+    }
+
+    std::vector<std::string_view> values;
+    values.reserve(m_entries.size());
+    if (ignore_case) {
+        m_lowercase_values.clear();
+        m_lowercase_values.reserve(m_entries.size());
+        for (auto const& entry : m_entries) {
+            auto& value = m_lowercase_values.emplace_back(entry.get_value());
+            string_utils::to_lower(value);
+            values.emplace_back(value);
+        }
+    } else {
+        for (auto const& entry : m_entries) {
+            values.emplace_back(entry.get_value());
+        }
+    }
+    index = std::make_unique<DictionaryWildcardIndex>(std::move(values));
+    return index.get();
+}
+
+template <typename DictionaryIdType, typename EntryType>
+void DictionaryReader<DictionaryIdType, EntryType>::clear_wildcard_indexes() {
+    m_num_anchored_wildcard_scans = 0;
+    m_wildcard_index.reset();
+    m_lowercase_wildcard_index.reset();
+    m_lowercase_values.clear();
+}
+
 template <typename DictionaryIdType, typename EntryType>
 void DictionaryReader<DictionaryIdType, EntryType>::read_segment_ids() {
     segment_id_t segment_id;
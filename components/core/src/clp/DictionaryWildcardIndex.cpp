@@ -0,0 +1,123 @@
+#include "DictionaryWildcardIndex.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace clp {
+namespace {
+/**
+ * @param lhs
+ * @param rhs
+ * @return Whether `lhs` reversed is lexicographically less than `rhs` reversed
+ */
+auto is_reversed_less(std::string_view lhs, std::string_view rhs) -> bool;
+
+auto is_reversed_less(std::string_view lhs, std::string_view rhs) -> bool {
+    return std::lexicographical_compare(lhs.rbegin(), lhs.rend(), rhs.rbegin(), rhs.rend());
+}
+}  // namespace
+
+DictionaryWildcardIndex::DictionaryWildcardIndex(std::vector<std::string_view> values)
+        : m_values{std::move(values)} {
+    m_ids_sorted_by_value.resize(m_values.size());
+    std::iota(m_ids_sorted_by_value.begin(), m_ids_sorted_by_value.end(), 0);
+    m_ids_sorted_by_reversed_value = m_ids_sorted_by_value;
+
+    std::ranges::sort(m_ids_sorted_by_value, [&](uint64_t lhs, uint64_t rhs) {
+        return m_values[lhs] < m_values[rhs];
+    });
+    std::ranges::sort(m_ids_sorted_by_reversed_value, [&](uint64_t lhs, uint64_t rhs) {
+        return is_reversed_less(m_values[lhs], m_values[rhs]);
+    });
+}
+
+auto DictionaryWildcardIndex::get_candidate_ids(std::string_view wildcard_string) const
+        -> std::optional<std::span<uint64_t const>> {
+    std::string prefix;
+    std::string suffix;
+    get_literal_prefix_and_suffix(wildcard_string, prefix, suffix);
+    if (prefix.empty() && suffix.empty()) {
+        return std::nullopt;
+    }
+    if (suffix.empty()) {
+        return get_ids_with_prefix(prefix);
+    }
+    if (prefix.empty()) {
+        return get_ids_with_suffix(suffix);
+    }
+
+    // Both ends are anchored, so use whichever narrows down the candidates the most
+    auto const ids_with_prefix = get_ids_with_prefix(prefix);
+    auto const ids_with_suffix = get_ids_with_suffix(suffix);
+    return ids_with_prefix.size() <= ids_with_suffix.size() ? ids_with_prefix : ids_with_suffix;
+}
+
+void DictionaryWildcardIndex::get_literal_prefix_and_suffix(
+        std::string_view wildcard_string,
+        std::string& prefix,
+        std::string& suffix
+) {
+    prefix.clear();
+    suffix.clear();
+
+    bool is_prefix_complete = false;
+    bool is_escaped = false;
+    for (auto const c : wildcard_string) {
+        if (is_escaped) {
+            is_escaped = false;
+        } else if ('\\' == c) {
+            is_escaped = true;
+            continue;
+        } else if ('*' == c || '?' == c) {
+            is_prefix_complete = true;
+            suffix.clear();
+            continue;
+        }
+
+        if (false == is_prefix_complete) {
+            prefix.push_back(c);
+        }
+        suffix.push_back(c);
+    }
+}
+
+auto DictionaryWildcardIndex::get_ids_with_prefix(std::string_view prefix) const
+        -> std::span<uint64_t const> {
+    auto const begin_it = std::ranges::lower_bound(
+            m_ids_sorted_by_value,
+            prefix,
+            std::less<>{},
+            [&](uint64_t id) { return m_values[id]; }
+    );
+    auto const end_it = std::partition_point(
+            begin_it,
+            m_ids_sorted_by_value.cend(),
+            [&](uint64_t id) { return m_values[id].starts_with(prefix); }
+    );
+    return {begin_it, end_it};
+}
+
+auto DictionaryWildcardIndex::get_ids_with_suffix(std::string_view suffix) const
+        -> std::span<uint64_t const> {
+    auto const begin_it = std::partition_point(
+            m_ids_sorted_by_reversed_value.cbegin(),
+            m_ids_sorted_by_reversed_value.cend(),
+            [&](uint64_t id) { return is_reversed_less(m_values[id], suffix); }
+    );
+    auto const end_it = std::partition_point(
+            begin_it,
+            m_ids_sorted_by_reversed_value.cend(),
+            [&](uint64_t id) { return m_values[id].ends_with(suffix); }
+    );
+    return {begin_it, end_it};
+}
+}  // namespace clp
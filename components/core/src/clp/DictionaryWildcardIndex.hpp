@@ -0,0 +1,78 @@
+#ifndef CLP_DICTIONARYWILDCARDINDEX_HPP
+#define CLP_DICTIONARYWILDCARDINDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace clp {
+/**
+ * An index over a dictionary's values that narrows down the entries which may match a wildcard
+ * string. Entry IDs are kept sorted both by value and by reversed value, so a wildcard string with
+ * a literal prefix (e.g., "user_12*") or a literal suffix (e.g., "*timeout") maps to a contiguous
+ * range of IDs. Wildcard strings with neither can't be narrowed down and must be matched against
+ * every entry.
+ *
+ * The index only stores views of the values, so the values must outlive it.
+ */
+class DictionaryWildcardIndex {
+public:
+    // Constructors
+    /**
+     * @param values The dictionary's values, indexed by entry ID
+     */
+    explicit DictionaryWildcardIndex(std::vector<std::string_view> values);
+
+    // Methods
+    /**
+     * Gets the IDs of the entries that may match the given wildcard string. Callers must still
+     * match each candidate against the wildcard string.
+     * @param wildcard_string A wildcard string in the format accepted by `wildcard_match_unsafe`
+     * @return A span of candidate IDs, or std::nullopt if the wildcard string has neither a literal
+     * prefix nor a literal suffix
+     */
+    [[nodiscard]] auto get_candidate_ids(std::string_view wildcard_string) const
+            -> std::optional<std::span<uint64_t const>>;
+
+    /**
+     * Gets the literal prefix and suffix of a wildcard string, i.e., the unescaped characters
+     * before its first wildcard and after its last wildcard. If the string contains no wildcards,
+     * both are the entire unescaped string.
+     * @param wildcard_string
+     * @param prefix Returns the literal prefix
+     * @param suffix Returns the literal suffix
+     */
+    static void get_literal_prefix_and_suffix(
+            std::string_view wildcard_string,
+            std::string& prefix,
+            std::string& suffix
+    );
+
+private:
+    // Methods
+    /**
+     * @param prefix
+     * @return The range of IDs whose values start with the given prefix
+     */
+    [[nodiscard]] auto get_ids_with_prefix(std::string_view prefix) const
+            -> std::span<uint64_t const>;
+
+    /**
+     * @param suffix
+     * @return The range of IDs whose values end with the given suffix
+     */
+    [[nodiscard]] auto get_ids_with_suffix(std::string_view suffix) const
+            -> std::span<uint64_t const>;
+
+    // Variables
+    std::vector<std::string_view> m_values;
+    std::vector<uint64_t> m_ids_sorted_by_value;
+    std::vector<uint64_t> m_ids_sorted_by_reversed_value;
+};
+}  // namespace clp
+
+#endif  // CLP_DICTIONARYWILDCARDINDEX_HPP
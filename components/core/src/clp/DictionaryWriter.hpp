@@ -1,9 +1,12 @@
 #ifndef CLP_DICTIONARYWRITER_HPP
 #define CLP_DICTIONARYWRITER_HPP
 
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
-#include <unordered_map>
 
+#include "ArenaBackedStringMap.hpp"
 #include "ArrayBackedPosIntSet.hpp"
 #include "Defs.h"
 #include "FileWriter.hpp"
@@ -16,7 +19,9 @@
 
 namespace clp {
 /**
- * Template class for performing operations on dictionaries and writing them to disk
+ * Template class for performing operations on dictionaries and writing them to disk. Entries may be
+ * added by several threads concurrently, while the remaining methods must be called by the thread
+ * that owns the dictionary.
  * @tparam DictionaryIdType
  * @tparam EntryType
  */
@@ -72,6 +77,7 @@ public:
      * @return Size in bytes
      */
     size_t get_on_disk_size() const {
+        std::shared_lock const lock{m_value_to_id_mutex};
         return m_dictionary_file_writer.get_pos() + m_segment_index_file_writer.get_pos();
     }
 
@@ -83,7 +89,8 @@ public:
 
 protected:
     // Types
-    using value_to_id_t = std::unordered_map<std::string, DictionaryIdType>;
+    // Stores each value once, in an arena, rather than in a node of its own
+    using value_to_id_t = ArenaBackedStringMap<DictionaryIdType>;
 
     // Variables
     bool m_is_open;
@@ -103,11 +110,14 @@ protected:
     size_t m_num_segments_in_index;
 
     value_to_id_t m_value_to_id;
+    // Guards m_value_to_id, m_next_id, and the dictionary compressor. Lookups of existing entries
+    // take a shared lock, while adding an entry takes an exclusive lock.
+    mutable std::shared_mutex m_value_to_id_mutex;
     DictionaryIdType m_next_id;
     DictionaryIdType m_max_id;
 
     // Size (in-memory) of the data contained in the dictionary
-    size_t m_data_size;
+    std::atomic_size_t m_data_size;
 };
 
 template <typename DictionaryIdType, typename EntryType>
@@ -164,6 +174,8 @@ void DictionaryWriter<DictionaryIdType, EntryType>::write_header_and_flush_to_di
         throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
     }
 
+    std::unique_lock const lock{m_value_to_id_mutex};
+
     // Update header
     auto dictionary_file_writer_pos = m_dictionary_file_writer.get_pos();
     m_dictionary_file_writer.seek_from_begin(0);
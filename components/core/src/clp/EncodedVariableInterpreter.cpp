@@ -1,12 +1,18 @@
 #include "EncodedVariableInterpreter.hpp"
 
+#include <array>
 #include <cassert>
+#include <charconv>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
 #include <unordered_set>
 
 #include <string_utils/string_utils.hpp>
 
 #include "Defs.h"
+#include "ffi/encoding_methods.hpp"
 #include "ffi/ir_stream/decoding_methods.hpp"
 #include "ir/LogEvent.hpp"
 #include "ir/types.hpp"
@@ -19,6 +25,7 @@ using clp::ir::four_byte_encoded_variable_t;
 using clp::ir::LogEvent;
 using clp::ir::VariablePlaceholder;
 using std::string;
+using std::string_view;
 using std::unordered_set;
 using std::vector;
 
@@ -367,6 +374,125 @@ bool EncodedVariableInterpreter::decode_variables_into_message(
     return true;
 }
 
+bool EncodedVariableInterpreter::convert_to_four_byte_ir_message(
+        LogTypeDictionaryEntry const& logtype_dict_entry,
+        VariableDictionaryReader const& var_dict,
+        vector<encoded_variable_t> const& encoded_vars,
+        string& ir_logtype,
+        vector<four_byte_encoded_variable_t>& ir_encoded_vars,
+        string& ir_dict_vars,
+        vector<size_t>& ir_dict_var_end_offsets
+) {
+    // Ensure the number of variables in the logtype matches the number of encoded variables given
+    auto const& logtype_value = logtype_dict_entry.get_value();
+    size_t const num_vars = logtype_dict_entry.get_num_variables();
+    if (num_vars != encoded_vars.size()) {
+        SPDLOG_ERROR(
+                "EncodedVariableInterpreter: Logtype '{}' contains {} variables, but {} were given "
+                "for conversion.",
+                logtype_value.c_str(),
+                num_vars,
+                encoded_vars.size()
+        );
+        return false;
+    }
+
+    // Archive logtypes escape placeholders the same way as IR logtypes, so the logtype only changes
+    // if a variable has to be converted into a dictionary variable
+    ir_logtype = logtype_value;
+    ir_encoded_vars.clear();
+    ir_dict_vars.clear();
+    ir_dict_var_end_offsets.clear();
+    auto add_ir_dict_var = [&](size_t placeholder_position, string_view value) {
+        ir_logtype[placeholder_position] = enum_to_underlying_type(VariablePlaceholder::Dictionary);
+        ir_dict_vars.append(value);
+        ir_dict_var_end_offsets.push_back(ir_dict_vars.length());
+    };
+
+    VariablePlaceholder var_placeholder;
+    // Large enough for any 64-bit integer, including its sign
+    std::array<char, 20> int_str_buf{};
+    string float_str;
+    bool is_negative{};
+    uint64_t digits{};
+    uint8_t num_digits{};
+    uint8_t decimal_point_pos{};
+    size_t const num_placeholders_in_logtype = logtype_dict_entry.get_num_placeholders();
+    for (size_t placeholder_ix = 0, var_ix = 0; placeholder_ix < num_placeholders_in_logtype;
+         ++placeholder_ix)
+    {
+        size_t const placeholder_position
+                = logtype_dict_entry.get_placeholder_info(placeholder_ix, var_placeholder);
+        switch (var_placeholder) {
+            case VariablePlaceholder::Integer: {
+                auto const encoded_var = encoded_vars[var_ix++];
+                if (INT32_MIN <= encoded_var && encoded_var <= INT32_MAX) {
+                    ir_encoded_vars.push_back(
+                            static_cast<four_byte_encoded_variable_t>(encoded_var)
+                    );
+                } else {
+                    auto const result = std::to_chars(
+                            int_str_buf.data(),
+                            int_str_buf.data() + int_str_buf.size(),
+                            encoded_var
+                    );
+                    add_ir_dict_var(
+                            placeholder_position,
+                            {int_str_buf.data(),
+                             static_cast<size_t>(result.ptr - int_str_buf.data())}
+                    );
+                }
+                break;
+            }
+            case VariablePlaceholder::Float: {
+                auto const encoded_var = encoded_vars[var_ix++];
+                ffi::decode_float_properties(
+                        encoded_var,
+                        is_negative,
+                        digits,
+                        num_digits,
+                        decimal_point_pos
+                );
+                if (num_digits <= ffi::cMaxDigitsInRepresentableFourByteFloatVar
+                    && decimal_point_pos <= num_digits
+                    && digits <= ffi::cFourByteEncodedFloatDigitsBitMask)
+                {
+                    ir_encoded_vars.push_back(
+                            ffi::encode_float_properties<four_byte_encoded_variable_t>(
+                                    is_negative,
+                                    static_cast<uint32_t>(digits),
+                                    num_digits,
+                                    decimal_point_pos
+                            )
+                    );
+                } else {
+                    convert_encoded_float_to_string(encoded_var, float_str);
+                    add_ir_dict_var(placeholder_position, float_str);
+                }
+                break;
+            }
+            case VariablePlaceholder::Dictionary:
+                add_ir_dict_var(
+                        placeholder_position,
+                        var_dict.get_value(decode_var_dict_id(encoded_vars[var_ix++]))
+                );
+                break;
+            case VariablePlaceholder::Escape:
+                break;
+            default:
+                SPDLOG_ERROR(
+                        "EncodedVariableInterpreter: Logtype '{}' contains unexpected variable "
+                        "placeholder 0x{:x}",
+                        logtype_value,
+                        enum_to_underlying_type(var_placeholder)
+                );
+                return false;
+        }
+    }
+
+    return true;
+}
+
 bool EncodedVariableInterpreter::encode_and_search_dictionary(
         string const& var_str,
         VariableDictionaryReader const& var_dict,
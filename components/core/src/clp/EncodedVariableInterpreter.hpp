@@ -1,6 +1,7 @@
 #ifndef CLP_ENCODEDVARIABLEINTERPRETER_HPP
 #define CLP_ENCODEDVARIABLEINTERPRETER_HPP
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -129,6 +130,31 @@ public:
             std::string& decompressed_msg
     );
 
+    /**
+     * Converts the given logtype and encoded variables into a four-byte encoded IR message without
+     * decompressing them into a string. Only dictionary variables are decoded; integer and float
+     * variables that can't be represented using the four-byte encoding are converted into
+     * dictionary variables.
+     * @param logtype_dict_entry
+     * @param var_dict
+     * @param encoded_vars
+     * @param ir_logtype Returns the IR message's logtype
+     * @param ir_encoded_vars Returns the IR message's encoded variables
+     * @param ir_dict_vars Returns the IR message's dictionary variables, stored back-to-back
+     * @param ir_dict_var_end_offsets Returns the end-offset of each dictionary variable in
+     * `ir_dict_vars`
+     * @return true if successful, false otherwise
+     */
+    static bool convert_to_four_byte_ir_message(
+            LogTypeDictionaryEntry const& logtype_dict_entry,
+            VariableDictionaryReader const& var_dict,
+            std::vector<encoded_variable_t> const& encoded_vars,
+            std::string& ir_logtype,
+            std::vector<ir::four_byte_encoded_variable_t>& ir_encoded_vars,
+            std::string& ir_dict_vars,
+            std::vector<size_t>& ir_dict_var_end_offsets
+    );
+
     /**
      * Encodes a string-form variable, and if it is dictionary variable, searches for its ID in the
      * given variable dictionary
@@ -1,5 +1,8 @@
 #include "LogTypeDictionaryWriter.hpp"
 
+#include <mutex>
+#include <shared_mutex>
+
 #include "dictionary_utils.hpp"
 
 using std::string;
@@ -9,31 +12,31 @@ bool LogTypeDictionaryWriter::add_entry(
         LogTypeDictionaryEntry& logtype_entry,
         logtype_dictionary_id_t& logtype_id
 ) {
-    bool is_new_entry = false;
-
     string const& value = logtype_entry.get_value();
-    auto const ix = m_value_to_id.find(value);
-    if (m_value_to_id.end() != ix) {
-        // Entry exists so get its ID
-        logtype_id = ix->second;
-    } else {
-        // Dictionary entry doesn't exist so create it
-
-        // Assign ID
-        logtype_id = m_next_id;
-        ++m_next_id;
-        logtype_entry.set_id(logtype_id);
-
-        // Insert new entry into dictionary
-        m_value_to_id[value] = logtype_id;
+    {
+        std::shared_lock const lock{m_value_to_id_mutex};
+        auto const* existing_id = m_value_to_id.find(value);
+        if (nullptr != existing_id) {
+            logtype_id = *existing_id;
+            return false;
+        }
+    }
 
-        is_new_entry = true;
+    // Another thread may have added the entry before we acquired the exclusive lock
+    std::unique_lock const lock{m_value_to_id_mutex};
+    // Insert the entry with the next ID, unless it already exists
+    auto const [existing_or_new_id, is_new_entry] = m_value_to_id.try_emplace(value, m_next_id);
+    logtype_id = *existing_or_new_id;
+    if (false == is_new_entry) {
+        return false;
+    }
+    ++m_next_id;
+    logtype_entry.set_id(logtype_id);
 
-        // TODO: This doesn't account for the segment index that's constantly updated
-        m_data_size += logtype_entry.get_data_size();
+    // TODO: This doesn't account for the segment index that's constantly updated
+    m_data_size += logtype_entry.get_data_size();
 
-        logtype_entry.write_to_file(m_dictionary_compressor);
-    }
-    return is_new_entry;
+    logtype_entry.write_to_file(m_dictionary_compressor);
+    return true;
 }
 }  // namespace clp
@@ -1,5 +1,9 @@
 #include "MessageParser.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
 #include "Defs.h"
 #include "TimestampPattern.hpp"
 
@@ -15,33 +19,47 @@ bool MessageParser::parse_next_message(
 ) {
     message.clear_except_ts_patt();
 
-    while (true) {
-        // Check if the buffer was exhausted
-        if (buffer_length == buf_pos) {
+    while (buffer_length != buf_pos) {
+        // Find the end of the line
+        auto const* line_begin = buffer + buf_pos;
+        auto const remaining_length = buffer_length - buf_pos;
+        auto const* delim_ptr
+                = static_cast<char const*>(memchr(line_begin, cLineDelimiter, remaining_length));
+        if (nullptr == delim_ptr) {
+            // Save the partial line so it can be completed from the next buffer
+            m_line.append(line_begin, remaining_length);
+            buf_pos = buffer_length;
             break;
         }
 
-        // Read a line up to the delimiter
-        bool found_delim = false;
-        for (; false == found_delim && buf_pos < buffer_length; ++buf_pos) {
-            auto c = buffer[buf_pos];
-
-            m_line += c;
-            if (cLineDelimiter == c) {
-                found_delim = true;
-            }
-        }
-
-        if (false == found_delim && false == drain_source) {
-            // No delimiter was found and the source doesn't need to be drained
-            return false;
+        size_t const line_length = delim_ptr - line_begin + 1;
+        buf_pos += line_length;
+        bool message_completed{false};
+        if (m_line.empty()) {
+            message_completed = parse_line({line_begin, line_length}, message);
+        } else {
+            // Complete the line saved from the previous buffer
+            m_line.append(line_begin, line_length);
+            message_completed = parse_line(m_line, message);
         }
-
-        if (parse_line(message)) {
+        if (message_completed) {
             return true;
         }
     }
 
+    if (false == drain_source) {
+        return false;
+    }
+    // Parse the last line, which has no line ending
+    if (false == m_line.empty() && parse_line(m_line, message)) {
+        return true;
+    }
+    if (false == m_buffered_msg.is_empty()) {
+        message.consume(m_buffered_msg);
+        return true;
+    }
+    // The next file may use different timestamp formats
+    m_recent_ts_patterns.fill(nullptr);
     return false;
 }
 
@@ -62,6 +80,8 @@ bool MessageParser::parse_next_message(
 
             if (m_line.empty()) {
                 if (m_buffered_msg.is_empty()) {
+                    // The next file may use different timestamp formats
+                    m_recent_ts_patterns.fill(nullptr);
                     break;
                 } else {
                     message.consume(m_buffered_msg);
@@ -73,7 +93,7 @@ bool MessageParser::parse_next_message(
             return false;
         }
 
-        if (parse_line(message)) {
+        if (parse_line(m_line, message)) {
             return true;
         }
     }
@@ -92,7 +112,7 @@ bool MessageParser::parse_next_message(
  *   - ...the buffered message is empty, return the line as a message.
  *   - ...the buffered message is not empty, add the line to the message and continue reading.
  */
-bool MessageParser::parse_line(ParsedMessage& message) {
+bool MessageParser::parse_line(std::string_view line, ParsedMessage& message) {
     bool message_completed = false;
 
     // Parse timestamp and content
@@ -103,14 +123,15 @@ bool MessageParser::parse_line(ParsedMessage& message) {
     if (nullptr == timestamp_pattern
         || false
                    == timestamp_pattern->parse_timestamp(
-                           m_line,
+                           line,
                            timestamp,
                            timestamp_begin_pos,
                            timestamp_end_pos
                    ))
     {
-        timestamp_pattern = TimestampPattern::search_known_ts_patterns(
-                m_line,
+        timestamp_pattern = search_ts_patterns(
+                line,
+                timestamp_pattern,
                 timestamp,
                 timestamp_begin_pos,
                 timestamp_end_pos
@@ -124,7 +145,7 @@ bool MessageParser::parse_line(ParsedMessage& message) {
             m_buffered_msg.set(
                     timestamp_pattern,
                     timestamp,
-                    m_line,
+                    line,
                     timestamp_begin_pos,
                     timestamp_end_pos
             );
@@ -136,7 +157,7 @@ bool MessageParser::parse_line(ParsedMessage& message) {
             m_buffered_msg.set(
                     timestamp_pattern,
                     timestamp,
-                    m_line,
+                    line,
                     timestamp_begin_pos,
                     timestamp_end_pos
             );
@@ -149,18 +170,57 @@ bool MessageParser::parse_line(ParsedMessage& message) {
             message.set(
                     timestamp_pattern,
                     timestamp,
-                    m_line,
+                    line,
                     timestamp_begin_pos,
                     timestamp_end_pos
             );
             message_completed = true;
         } else {
             // Append line to message
-            m_buffered_msg.append_line(m_line);
+            m_buffered_msg.append_line(line);
         }
     }
 
     m_line.clear();
     return message_completed;
 }
+
+TimestampPattern const* MessageParser::search_ts_patterns(
+        std::string_view line,
+        TimestampPattern const* pattern_to_skip,
+        epochtime_t& timestamp,
+        size_t& timestamp_begin_pos,
+        size_t& timestamp_end_pos
+) {
+    for (auto it = m_recent_ts_patterns.begin();
+         m_recent_ts_patterns.end() != it && nullptr != *it;
+         ++it)
+    {
+        auto const* pattern = *it;
+        if (pattern != pattern_to_skip
+            && pattern->parse_timestamp(line, timestamp, timestamp_begin_pos, timestamp_end_pos))
+        {
+            // Move the pattern to the front
+            std::rotate(m_recent_ts_patterns.begin(), it, it + 1);
+            return pattern;
+        }
+    }
+
+    auto const* pattern = TimestampPattern::search_known_ts_patterns(
+            line,
+            timestamp,
+            timestamp_begin_pos,
+            timestamp_end_pos
+    );
+    if (nullptr != pattern) {
+        // Evict the least recent pattern
+        std::rotate(
+                m_recent_ts_patterns.begin(),
+                m_recent_ts_patterns.end() - 1,
+                m_recent_ts_patterns.end()
+        );
+        m_recent_ts_patterns.front() = pattern;
+    }
+    return pattern;
+}
 }  // namespace clp
@@ -1,11 +1,16 @@
 #ifndef CLP_MESSAGEPARSER_HPP
 #define CLP_MESSAGEPARSER_HPP
 
+#include <array>
+#include <cstddef>
 #include <string>
+#include <string_view>
 
+#include "Defs.h"
 #include "ErrorCode.hpp"
 #include "ParsedMessage.hpp"
 #include "ReaderInterface.hpp"
+#include "TimestampPattern.hpp"
 #include "TraceableException.hpp"
 
 namespace clp {
@@ -30,7 +35,12 @@ public:
      * Parses the next message from the given buffer. Messages are delimited either by
      * i) a timestamp or
      * ii) a line break if no timestamp is found.
-     * @param drain_source Whether to drain all content from the file or just lines with endings
+     *
+     * Lines are parsed in place. Only a line that continues past the end of the buffer is copied, so
+     * that it can be completed by the next buffer.
+     * @param drain_source Whether to drain all content from the file or just lines with endings.
+     * When draining, the buffer must contain the rest of the source (which may be nothing), so the
+     * last line and message are returned once the buffer is exhausted.
      * @param buffer_length
      * @param buffer
      * @param buf_pos
@@ -60,14 +70,41 @@ private:
     /**
      * Parses the line and adds it either to the buffered message if incomplete, or the given
      * message if complete
+     * @param line The line, which may be a view of m_line
      * @param message
      * @return Whether a complete message has been parsed
      */
-    bool parse_line(ParsedMessage& message);
+    bool parse_line(std::string_view line, ParsedMessage& message);
+
+    /**
+     * Searches for a timestamp pattern which can parse the timestamp from the given line, trying
+     * the patterns that most recently parsed a line before all known patterns
+     * @param line
+     * @param pattern_to_skip A pattern that has already failed to parse the line
+     * @param timestamp Parsed timestamp
+     * @param timestamp_begin_pos
+     * @param timestamp_end_pos
+     * @return pointer to the timestamp pattern if found, nullptr otherwise
+     */
+    TimestampPattern const* search_ts_patterns(
+            std::string_view line,
+            TimestampPattern const* pattern_to_skip,
+            epochtime_t& timestamp,
+            size_t& timestamp_begin_pos,
+            size_t& timestamp_end_pos
+    );
+
+    // Constants
+    static constexpr size_t cNumRecentTsPatterns = 4;
 
     // Variables
+    // The line being read, when it can't be parsed in place
     std::string m_line;
     ParsedMessage m_buffered_msg;
+    // Known timestamp patterns that most recently parsed a line in the current file, from most to
+    // least recent. Files often interleave a few timestamp formats, so this avoids searching every
+    // known pattern whenever the format changes.
+    std::array<TimestampPattern const*, cNumRecentTsPatterns> m_recent_ts_patterns{};
 };
 }  // namespace clp
 
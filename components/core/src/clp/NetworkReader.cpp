@@ -122,7 +122,8 @@ NetworkReader::NetworkReader(
         std::chrono::seconds connection_timeout,
         size_t buffer_pool_size,
         size_t buffer_size,
-        std::optional<std::unordered_map<std::string, std::string>> http_header_kv_pairs
+        std::optional<std::unordered_map<std::string, std::string>> http_header_kv_pairs,
+        std::optional<size_t> end_offset
 )
         : m_src_url{src_url},
           m_offset{offset},
@@ -138,7 +139,8 @@ NetworkReader::NetworkReader(
             *this,
             offset,
             disable_caching,
-            std::move(http_header_kv_pairs)
+            std::move(http_header_kv_pairs),
+            end_offset
     );
     m_downloader_thread->start();
 }
@@ -225,7 +227,8 @@ auto NetworkReader::DownloaderThread::thread_method() -> void {
                 m_disable_caching,
                 m_reader.m_connection_timeout,
                 m_reader.m_overall_timeout,
-                m_http_header_kv_pairs
+                m_http_header_kv_pairs,
+                m_end_offset
         };
         auto const ret_code{curl_handler.perform()};
         // Enqueue the last filled buffer, if any
@@ -98,6 +98,9 @@ public:
      * @param buffer_size The size of each buffer in the buffer pool.
      * @param http_header_kv_pairs Key-value pairs representing HTTP headers to pass to the server
      * in the download request. Doc: https://curl.se/libcurl/c/CURLOPT_HTTPHEADER.html
+     * @param end_offset Index of the byte at which to stop the download (exclusive), or
+     * `std::nullopt` to download until the end of the data. When set, only the byte range
+     * `[offset, end_offset)` is requested from the server.
      */
     explicit NetworkReader(
             std::string_view src_url,
@@ -109,7 +112,8 @@ public:
             size_t buffer_pool_size = cDefaultBufferPoolSize,
             size_t buffer_size = cDefaultBufferSize,
             std::optional<std::unordered_map<std::string, std::string>> http_header_kv_pairs
-            = std::nullopt
+            = std::nullopt,
+            std::optional<size_t> end_offset = std::nullopt
     );
 
     // Destructor
@@ -250,17 +254,20 @@ private:
          * @param disable_caching Whether to disable caching.
          * @param http_header_kv_pairs Key-value pairs representing HTTP headers to pass to the
          * server in the download request. Doc: https://curl.se/libcurl/c/CURLOPT_HTTPHEADER.html
+         * @param end_offset Index of the byte at which to stop the download (exclusive), if any.
          */
         DownloaderThread(
                 NetworkReader& reader,
                 size_t offset,
                 bool disable_caching,
-                std::optional<std::unordered_map<std::string, std::string>> http_header_kv_pairs
+                std::optional<std::unordered_map<std::string, std::string>> http_header_kv_pairs,
+                std::optional<size_t> end_offset
         )
                 : m_reader{reader},
                   m_offset{offset},
                   m_disable_caching{disable_caching},
-                  m_http_header_kv_pairs{std::move(http_header_kv_pairs)} {}
+                  m_http_header_kv_pairs{std::move(http_header_kv_pairs)},
+                  m_end_offset{end_offset} {}
 
     private:
         // Methods implementing `clp::Thread`
@@ -270,6 +277,7 @@ private:
         size_t m_offset{0};
         bool m_disable_caching{false};
         std::optional<std::unordered_map<std::string, std::string>> m_http_header_kv_pairs;
+        std::optional<size_t> m_end_offset;
     };
 
     /**
@@ -1,6 +1,7 @@
 #include "ParsedMessage.hpp"
 
 using std::string;
+using std::string_view;
 
 namespace clp {
 void ParsedMessage::clear() {
@@ -19,7 +20,7 @@ void ParsedMessage::clear_except_ts_patt() {
 void ParsedMessage::set(
         TimestampPattern const* timestamp_pattern,
         epochtime_t const timestamp,
-        string const& line,
+        string_view line,
         size_t timestamp_begin_pos,
         size_t timestamp_end_pos
 ) {
@@ -31,14 +32,14 @@ void ParsedMessage::set(
     if (timestamp_begin_pos == timestamp_end_pos) {
         m_content.assign(line);
     } else {
-        m_content.assign(line, 0, timestamp_begin_pos);
-        m_content.append(line, timestamp_end_pos, string::npos);
+        m_content.assign(line.substr(0, timestamp_begin_pos));
+        m_content.append(line.substr(timestamp_end_pos));
     }
     m_orig_num_bytes = line.length();
     m_is_set = true;
 }
 
-void ParsedMessage::append_line(string const& line) {
+void ParsedMessage::append_line(string_view line) {
     m_content += line;
     m_orig_num_bytes += line.length();
 }
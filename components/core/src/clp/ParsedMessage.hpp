@@ -1,7 +1,9 @@
 #ifndef CLP_PARSEDMESSAGE_HPP
 #define CLP_PARSEDMESSAGE_HPP
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 
 #include "TimestampPattern.hpp"
 
@@ -35,11 +37,11 @@ public:
     void set(
             TimestampPattern const* timestamp_pattern,
             epochtime_t timestamp,
-            std::string const& line,
+            std::string_view line,
             size_t timestamp_begin_pos,
             size_t timestamp_end_pos
     );
-    void append_line(std::string const& line);
+    void append_line(std::string_view line);
 
     /**
      * Move all data from the given message into the current message while clearing the given
@@ -1,7 +1,9 @@
 #include "TimestampPattern.hpp"
 
+#include <array>
 #include <chrono>
 #include <cstring>
+#include <string_view>
 #include <vector>
 
 #include <date/date.h>
@@ -9,11 +11,14 @@
 #include "spdlog_with_specializations.hpp"
 
 using std::string;
+using std::string_view;
 using std::to_string;
 using std::vector;
 
 // Static member default initialization
 std::unique_ptr<clp::TimestampPattern[]> clp::TimestampPattern::m_known_ts_patterns = nullptr;
+std::unique_ptr<clp::TimestampPatternPrefilter[]>
+        clp::TimestampPattern::m_known_ts_pattern_prefilters = nullptr;
 size_t clp::TimestampPattern::m_known_ts_patterns_len = 0;
 
 namespace {
@@ -25,6 +30,8 @@ enum class ParserState {
 }  // namespace
 
 // File-scope constants
+// Fingerprints are only computed for timestamps preceded by fewer than this many spaces
+static constexpr size_t cMaxNumSpacesToFingerprint = 8;
 static constexpr int cNumDaysInWeek = 7;
 static char const* cAbbrevDaysOfWeek[cNumDaysInWeek]
         = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
@@ -46,6 +53,13 @@ static char const* cMonthNames[cNumMonths]
            "December"};
 
 // File-scope functions
+/**
+ * @param line
+ * @param num_spaces
+ * @return The part of the line after the given number of spaces, where a timestamp preceded by
+ * that many spaces would begin
+ */
+static string_view get_line_after_spaces(string_view line, size_t num_spaces);
 /**
  * Converts a value to a padded string with the given length and appends it to the given string
  * @param value
@@ -64,13 +78,25 @@ static void append_padded_value(int value, char padding_character, size_t length
  * @return true if conversion succeeds, false otherwise
  */
 static bool convert_string_to_number(
-        string const& str,
+        string_view str,
         size_t begin_ix,
         size_t end_ix,
         char padding_character,
         int& value
 );
 
+static string_view get_line_after_spaces(string_view line, size_t num_spaces) {
+    size_t line_ix = 0;
+    for (size_t num_spaces_found = 0; num_spaces_found < num_spaces && line_ix < line.length();
+         ++line_ix)
+    {
+        if (' ' == line[line_ix]) {
+            ++num_spaces_found;
+        }
+    }
+    return line.substr(line_ix);
+}
+
 static void append_padded_value(
         int const value,
         char const padding_character,
@@ -83,7 +109,7 @@ static void append_padded_value(
 }
 
 static bool convert_string_to_number(
-        string const& str,
+        string_view str,
         size_t const begin_ix,
         size_t const end_ix,
         char const padding_character,
@@ -194,22 +220,39 @@ void TimestampPattern::init() {
     // Initialize m_known_ts_patterns with vector's contents
     m_known_ts_patterns_len = patterns.size();
     m_known_ts_patterns = std::make_unique<TimestampPattern[]>(m_known_ts_patterns_len);
+    m_known_ts_pattern_prefilters
+            = std::make_unique<TimestampPatternPrefilter[]>(m_known_ts_patterns_len);
     for (size_t i = 0; i < patterns.size(); ++i) {
         m_known_ts_patterns[i] = patterns[i];
+        m_known_ts_pattern_prefilters[i] = TimestampPatternPrefilter{patterns[i].m_format};
     }
 }
 
 TimestampPattern const* TimestampPattern::search_known_ts_patterns(
-        string const& line,
+        string_view line,
         epochtime_t& timestamp,
         size_t& timestamp_begin_pos,
         size_t& timestamp_end_pos
 ) {
+    // Fingerprints of the line after each number of spaces, computed as needed
+    std::array<uint64_t, cMaxNumSpacesToFingerprint> fingerprints{};
+    std::array<bool, cMaxNumSpacesToFingerprint> is_fingerprint_computed{};
     for (size_t i = 0; i < m_known_ts_patterns_len; ++i) {
-        if (m_known_ts_patterns[i]
-                    .parse_timestamp(line, timestamp, timestamp_begin_pos, timestamp_end_pos))
-        {
-            return &m_known_ts_patterns[i];
+        auto const& pattern = m_known_ts_patterns[i];
+        size_t const num_spaces = pattern.m_num_spaces_before_ts;
+        if (num_spaces < cMaxNumSpacesToFingerprint) {
+            if (false == is_fingerprint_computed[num_spaces]) {
+                fingerprints[num_spaces] = TimestampPatternPrefilter::compute_fingerprint(
+                        get_line_after_spaces(line, num_spaces)
+                );
+                is_fingerprint_computed[num_spaces] = true;
+            }
+            if (false == m_known_ts_pattern_prefilters[i].may_match(fingerprints[num_spaces])) {
+                continue;
+            }
+        }
+        if (pattern.parse_timestamp(line, timestamp, timestamp_begin_pos, timestamp_end_pos)) {
+            return &pattern;
         }
     }
 
@@ -236,7 +279,7 @@ void TimestampPattern::clear() {
 }
 
 bool TimestampPattern::parse_timestamp(
-        string const& line,
+        string_view line,
         epochtime_t& timestamp,
         size_t& timestamp_begin_pos,
         size_t& timestamp_end_pos
@@ -4,9 +4,12 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <string>
+#include <string_view>
 
 #include "Defs.h"
 #include "FileWriter.hpp"
+#include "TimestampPatternPrefilter.hpp"
 #include "TraceableException.hpp"
 
 namespace clp {
@@ -74,7 +77,8 @@ public:
 
     /**
      * Searches for a known timestamp pattern which can parse the timestamp from the given line, and
-     * if found, parses the timestamp
+     * if found, parses the timestamp. Patterns which can't match the layout of the line's leading
+     * bytes are skipped without being parsed.
      * @param line
      * @param timestamp Parsed timestamp
      * @param timestamp_begin_pos
@@ -82,7 +86,7 @@ public:
      * @return pointer to the timestamp pattern if found, nullptr otherwise
      */
     static TimestampPattern const* search_known_ts_patterns(
-            std::string const& line,
+            std::string_view line,
             epochtime_t& timestamp,
             size_t& timestamp_begin_pos,
             size_t& timestamp_end_pos
@@ -118,7 +122,7 @@ public:
      * @return true if parsed successfully, false otherwise
      */
     bool parse_timestamp(
-            std::string const& line,
+            std::string_view line,
             epochtime_t& timestamp,
             size_t& timestamp_begin_pos,
             size_t& timestamp_end_pos
@@ -150,6 +154,7 @@ public:
 private:
     // Variables
     static std::unique_ptr<TimestampPattern[]> m_known_ts_patterns;
+    static std::unique_ptr<TimestampPatternPrefilter[]> m_known_ts_pattern_prefilters;
     static size_t m_known_ts_patterns_len;
 
     // The number of spaces before the timestamp in a message
@@ -0,0 +1,204 @@
+#ifndef CLP_TIMESTAMPPATTERNPREFILTER_HPP
+#define CLP_TIMESTAMPPATTERNPREFILTER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace clp {
+/**
+ * Class to quickly rule out timestamp patterns which can't parse a timestamp at the beginning of a
+ * string. The prefilter compares a fingerprint of the string's leading bytes against the layout of
+ * digits, letters, and separators that the pattern's format expects (e.g., "%Y-%m-%d" expects four
+ * digits, a dash, two digits, a dash, and two digits).
+ *
+ * A fingerprint holds a 4-bit character class for each of the first `cFingerprintLength` bytes of a
+ * string, so checking a pattern is a single mask-and-compare. The layout only covers the format's
+ * fixed-length prefix: it ends at the first directive whose length varies or that it doesn't
+ * recognize. So the prefilter never rules out a pattern that could parse the string, which means it
+ * can be shared by the copies of TimestampPattern in clp, clp-s, and glt.
+ */
+class TimestampPatternPrefilter {
+public:
+    // Constants
+    static constexpr size_t cFingerprintLength{16};
+
+    // Constructors
+    /**
+     * Constructs a prefilter that doesn't rule out any string
+     */
+    TimestampPatternPrefilter() = default;
+
+    /**
+     * Constructs a prefilter for the given timestamp format
+     * @param format
+     */
+    explicit TimestampPatternPrefilter(std::string_view format);
+
+    // Methods
+    /**
+     * @param str
+     * @return The fingerprint of the given string's leading bytes
+     */
+    [[nodiscard]] static auto compute_fingerprint(std::string_view str) -> uint64_t {
+        uint64_t fingerprint{0};
+        auto const length{std::min(str.length(), cFingerprintLength)};
+        for (size_t i = 0; i < length; ++i) {
+            fingerprint |= static_cast<uint64_t>(get_char_class(str[i])) << (i * cBitsPerClass);
+        }
+        return fingerprint;
+    }
+
+    /**
+     * @param fingerprint
+     * @return Whether the pattern may be able to parse a timestamp from a string with the given
+     * fingerprint
+     */
+    [[nodiscard]] auto may_match(uint64_t fingerprint) const -> bool {
+        return (fingerprint & m_mask) == m_fingerprint;
+    }
+
+private:
+    // Types
+    enum CharClass : uint8_t {
+        End = 0,
+        Digit,
+        Letter,
+        Space,
+        Dash,
+        Slash,
+        Colon,
+        Period,
+        Comma,
+        LeftBracket,
+        RightBracket,
+        LessThan,
+        Other
+    };
+
+    // Constants
+    static constexpr size_t cBitsPerClass{4};
+    static constexpr uint64_t cClassMask{(1ULL << cBitsPerClass) - 1};
+
+    // Methods
+    [[nodiscard]] static constexpr auto get_char_class(char c) -> CharClass {
+        if ('0' <= c && c <= '9') {
+            return Digit;
+        }
+        if (('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z')) {
+            return Letter;
+        }
+        switch (c) {
+            case ' ':
+                return Space;
+            case '-':
+                return Dash;
+            case '/':
+                return Slash;
+            case ':':
+                return Colon;
+            case '.':
+                return Period;
+            case ',':
+                return Comma;
+            case '[':
+                return LeftBracket;
+            case ']':
+                return RightBracket;
+            case '<':
+                return LessThan;
+            default:
+                return Other;
+        }
+    }
+
+    /**
+     * Appends the given number of bytes of the given class to the expected layout
+     * @param char_class
+     * @param num_bytes
+     * @param pos Position of the first byte, which is advanced past the bytes
+     */
+    void expect(CharClass char_class, size_t num_bytes, size_t& pos);
+
+    // Variables
+    uint64_t m_mask{0};
+    uint64_t m_fingerprint{0};
+};
+
+inline TimestampPatternPrefilter::TimestampPatternPrefilter(std::string_view format) {
+    size_t pos{0};
+    for (size_t format_ix = 0; format_ix < format.length() && pos < cFingerprintLength;
+         ++format_ix)
+    {
+        auto const c{format[format_ix]};
+        if ('%' != c) {
+            expect(get_char_class(c), 1, pos);
+            continue;
+        }
+
+        ++format_ix;
+        if (format_ix >= format.length()) {
+            return;
+        }
+        switch (format[format_ix]) {
+            case '%':
+                expect(get_char_class('%'), 1, pos);
+                break;
+            case 'y':
+            case 'm':
+            case 'd':
+            case 'H':
+            case 'I':
+            case 'M':
+            case 'S':
+                expect(Digit, 2, pos);
+                break;
+            case 'Y':
+                expect(Digit, 4, pos);
+                break;
+            case '3':
+                expect(Digit, 3, pos);
+                break;
+            case 'b':
+            case 'a':
+                expect(Letter, 3, pos);
+                break;
+            case 'p':
+                expect(Letter, 2, pos);
+                break;
+            case 'e':
+            case 'l':
+                // The first byte may be a digit or padding, but the value can't be zero
+                pos += 1;
+                expect(Digit, 1, pos);
+                break;
+            case 'k':
+                // Both bytes may be padding since the value may be zero
+                pos += 2;
+                break;
+            case 'B':
+                // Month names vary in length
+                expect(Letter, 1, pos);
+                return;
+            case '#':
+                // Relative timestamps vary in length
+                expect(Digit, 1, pos);
+                return;
+            default:
+                // The directive's length varies, or it isn't supported by every copy of
+                // TimestampPattern
+                return;
+        }
+    }
+}
+
+inline void TimestampPatternPrefilter::expect(CharClass char_class, size_t num_bytes, size_t& pos) {
+    for (size_t i = 0; i < num_bytes && pos < cFingerprintLength; ++i, ++pos) {
+        m_mask |= cClassMask << (pos * cBitsPerClass);
+        m_fingerprint |= static_cast<uint64_t>(char_class) << (pos * cBitsPerClass);
+    }
+}
+}  // namespace clp
+
+#endif  // CLP_TIMESTAMPPATTERNPREFILTER_HPP
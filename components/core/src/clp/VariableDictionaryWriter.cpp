@@ -1,38 +1,48 @@
 #include "VariableDictionaryWriter.hpp"
 
+#include <mutex>
+#include <shared_mutex>
+
 #include "dictionary_utils.hpp"
 #include "spdlog_with_specializations.hpp"
 
 namespace clp {
 bool VariableDictionaryWriter::add_entry(std::string const& value, variable_dictionary_id_t& id) {
-    bool new_entry = false;
-
-    auto const ix = m_value_to_id.find(value);
-    if (m_value_to_id.end() != ix) {
-        id = ix->second;
-    } else {
-        // Entry doesn't exist so create it
-
-        if (m_next_id > m_max_id) {
-            SPDLOG_ERROR("VariableDictionaryWriter ran out of IDs.");
-            throw OperationFailed(ErrorCode_OutOfBounds, __FILENAME__, __LINE__);
+    {
+        std::shared_lock const lock{m_value_to_id_mutex};
+        auto const* existing_id = m_value_to_id.find(value);
+        if (nullptr != existing_id) {
+            id = *existing_id;
+            return false;
         }
+    }
 
-        // Assign ID
-        id = m_next_id;
-        ++m_next_id;
+    // Another thread may have added the entry before we acquired the exclusive lock
+    std::unique_lock const lock{m_value_to_id_mutex};
+    if (m_next_id > m_max_id) {
+        auto const* existing_id = m_value_to_id.find(value);
+        if (nullptr != existing_id) {
+            id = *existing_id;
+            return false;
+        }
+        SPDLOG_ERROR("VariableDictionaryWriter ran out of IDs.");
+        throw OperationFailed(ErrorCode_OutOfBounds, __FILENAME__, __LINE__);
+    }
 
-        // Insert the ID obtained from the database into the dictionary
-        auto entry = VariableDictionaryEntry(value, id);
-        m_value_to_id[value] = id;
+    // Insert the entry with the next ID, unless it already exists
+    auto const [existing_or_new_id, is_new_entry] = m_value_to_id.try_emplace(value, m_next_id);
+    id = *existing_or_new_id;
+    if (false == is_new_entry) {
+        return false;
+    }
+    ++m_next_id;
 
-        new_entry = true;
+    auto entry = VariableDictionaryEntry(value, id);
 
-        // TODO: This doesn't account for the segment index that's constantly updated
-        m_data_size += entry.get_data_size();
+    // TODO: This doesn't account for the segment index that's constantly updated
+    m_data_size += entry.get_data_size();
 
-        entry.write_to_file(m_dictionary_compressor);
-    }
-    return new_entry;
+    entry.write_to_file(m_dictionary_compressor);
+    return true;
 }
 }  // namespace clp
@@ -124,30 +124,12 @@ bool FileCompressor::compress_file(
     m_file_reader.open(file_to_compress.get_path());
 
     // Check that file is UTF-8 encoded
-    if (auto error_code = m_file_reader.try_refill_buffer_if_empty();
-        ErrorCode_Success != error_code && ErrorCode_EndOfFile != error_code)
-    {
-        if (ErrorCode_errno == error_code) {
-            SPDLOG_ERROR(
-                    "Failed to read {} into buffer, errno={}",
-                    file_to_compress.get_path(),
-                    errno
-            );
-        } else {
-            SPDLOG_ERROR(
-                    "Failed to read {} into buffer, error={}",
-                    file_to_compress.get_path(),
-                    error_code
-            );
-        }
+    bool is_utf8_encoded_file{false};
+    if (false == check_utf8_encoding(m_file_reader, is_utf8_encoded_file)) {
         return false;
     }
-    char const* utf8_validation_buf{nullptr};
-    size_t peek_size{0};
-    m_file_reader.peek_buffered_data(utf8_validation_buf, peek_size);
     bool succeeded = true;
-    auto const utf8_validation_buf_len = std::min(peek_size, cUtfMaxValidationLen);
-    if (is_utf8_encoded({utf8_validation_buf, utf8_validation_buf_len})) {
+    if (is_utf8_encoded_file) {
         if (use_heuristic) {
             parse_and_encode_with_heuristic(
                     target_data_size_of_dicts,
@@ -5,6 +5,7 @@
 #include <cstddef>
 #include <filesystem>
 #include <string>
+#include <vector>
 
 #include "../ErrorCode.hpp"
 #include "../FileWriter.hpp"
@@ -63,6 +64,10 @@ private:
     streaming_archive::reader::File m_encoded_file;
     streaming_archive::reader::Message m_encoded_message;
     std::string m_decompressed_message;
+    std::string m_ir_logtype;
+    std::vector<ir::four_byte_encoded_variable_t> m_ir_encoded_vars;
+    std::string m_ir_dict_vars;
+    std::vector<size_t> m_ir_dict_var_end_offsets;
 };
 
 // Templated methods
@@ -114,11 +119,17 @@ auto FileDecompressor::decompress_to_ir(
     }
 
     while (archive_reader.get_next_message(m_encoded_file, m_encoded_message)) {
+        // Transcode the message directly rather than decompressing it and re-encoding it as IR
         if (false
-            == archive_reader
-                       .decompress_message_without_ts(m_encoded_message, m_decompressed_message))
+            == archive_reader.convert_message_to_four_byte_ir(
+                    m_encoded_message,
+                    m_ir_logtype,
+                    m_ir_encoded_vars,
+                    m_ir_dict_vars,
+                    m_ir_dict_var_end_offsets
+            ))
         {
-            SPDLOG_ERROR("Failed to decompress message");
+            SPDLOG_ERROR("Failed to convert message into IR");
             return false;
         }
 
@@ -146,14 +157,17 @@ auto FileDecompressor::decompress_to_ir(
         }
 
         if (false
-            == ir_serializer.serialize_log_event(
+            == ir_serializer.serialize_encoded_log_event(
                     m_encoded_message.get_ts_in_milli(),
-                    m_decompressed_message
+                    m_ir_logtype,
+                    m_ir_encoded_vars,
+                    m_ir_dict_vars,
+                    m_ir_dict_var_end_offsets
             ))
         {
             SPDLOG_ERROR(
-                    "Failed to serialize log event: {} with ts {}",
-                    m_decompressed_message.c_str(),
+                    "Failed to serialize log event with logtype id {} and ts {}",
+                    m_encoded_message.get_logtype_id(),
                     m_encoded_message.get_ts_in_milli()
             );
             return false;
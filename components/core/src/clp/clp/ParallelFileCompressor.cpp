@@ -0,0 +1,248 @@
+#include "ParallelFileCompressor.hpp"
+
+#include <exception>
+#include <memory>
+#include <utility>
+
+#include "../ErrorCode.hpp"
+#include "../spdlog_with_specializations.hpp"
+#include "../streaming_archive/writer/utils.hpp"
+#include "../TraceableException.hpp"
+#include "utils.hpp"
+
+using clp::streaming_archive::writer::Archive;
+using clp::streaming_archive::writer::split_archive;
+using std::make_unique;
+using std::unique_ptr;
+using std::vector;
+
+namespace clp::clp {
+bool ParallelFileCompressor::compress_files(
+        vector<FileToCompress> const& files_to_compress,
+        size_t target_data_size_of_dicts,
+        Archive::UserConfig& archive_user_config,
+        Archive& archive_writer,
+        vector<FileToCompress>& non_text_files,
+        std::function<void()> const& file_done_callback
+) {
+    m_is_stopping = false;
+    vector<unique_ptr<WorkerThread>> workers;
+    bool all_files_compressed_successfully = true;
+    try {
+        for (size_t i = 0; i < m_num_threads; ++i) {
+            workers.emplace_back(make_unique<WorkerThread>(*this, archive_writer));
+            workers.back()->start();
+        }
+
+        auto next_file_it = files_to_compress.cbegin();
+        size_t num_files_in_progress = 0;
+        std::deque<unique_ptr<Archive::ConcurrentFile>> encoded_files;
+        std::deque<std::pair<FileToCompress const*, FileStatus>> finished_files;
+        while (files_to_compress.cend() != next_file_it || num_files_in_progress > 0) {
+            // Files being encoded reference the archive's dictionaries, so we can only split the
+            // archive once they've all been appended
+            bool can_dispatch_files{true};
+            if (archive_writer.get_data_size_of_dictionaries() >= target_data_size_of_dicts) {
+                if (0 == num_files_in_progress) {
+                    split_archive(archive_user_config, archive_writer);
+                } else {
+                    can_dispatch_files = false;
+                }
+            }
+
+            {
+                std::unique_lock lock{m_mutex};
+                if (can_dispatch_files) {
+                    // Limit the number of files in progress so that the dictionaries don't grow
+                    // far beyond their target size before the archive is split
+                    for (; files_to_compress.cend() != next_file_it
+                           && num_files_in_progress < m_num_threads;
+                         ++next_file_it)
+                    {
+                        m_pending_files.emplace_back(&(*next_file_it));
+                        ++num_files_in_progress;
+                        m_worker_cv.notify_one();
+                    }
+                }
+                m_owner_cv.wait(lock, [&] {
+                    return false == m_encoded_files.empty() || false == m_finished_files.empty();
+                });
+                encoded_files.swap(m_encoded_files);
+                finished_files.swap(m_finished_files);
+            }
+
+            // A worker hands over all of a file's splits before reporting that it's finished, so
+            // each finished file's splits are appended before the file is reported
+            for (auto& encoded_file : encoded_files) {
+                archive_writer.append_file_to_segment(std::move(encoded_file));
+            }
+            encoded_files.clear();
+            for (auto const& [file_to_compress, status] : finished_files) {
+                --num_files_in_progress;
+                if (FileStatus::NotText == status) {
+                    non_text_files.emplace_back(*file_to_compress);
+                    continue;
+                }
+                if (FileStatus::Failed == status) {
+                    all_files_compressed_successfully = false;
+                }
+                file_done_callback();
+            }
+            finished_files.clear();
+        }
+    } catch (...) {
+        stop_workers(workers);
+        throw;
+    }
+    stop_workers(workers);
+
+    return all_files_compressed_successfully;
+}
+
+void ParallelFileCompressor::enqueue_encoded_file(unique_ptr<Archive::ConcurrentFile> file) {
+    {
+        std::lock_guard const lock{m_mutex};
+        m_encoded_files.emplace_back(std::move(file));
+    }
+    m_owner_cv.notify_one();
+}
+
+void ParallelFileCompressor::stop_workers(vector<unique_ptr<WorkerThread>>& workers) {
+    {
+        std::lock_guard const lock{m_mutex};
+        m_is_stopping = true;
+        m_pending_files.clear();
+    }
+    m_worker_cv.notify_all();
+    for (auto& worker : workers) {
+        worker->join();
+    }
+    workers.clear();
+
+    // Discard anything the workers produced after the calling thread stopped consuming it
+    m_encoded_files.clear();
+    m_finished_files.clear();
+}
+
+auto ParallelFileCompressor::WorkerThread::thread_method() -> void {
+    while (true) {
+        FileToCompress const* file_to_compress{nullptr};
+        {
+            std::unique_lock lock{m_compressor.m_mutex};
+            m_compressor.m_worker_cv.wait(lock, [&] {
+                return m_compressor.m_is_stopping || false == m_compressor.m_pending_files.empty();
+            });
+            if (m_compressor.m_pending_files.empty()) {
+                return;
+            }
+            file_to_compress = m_compressor.m_pending_files.front();
+            m_compressor.m_pending_files.pop_front();
+        }
+
+        auto status{FileStatus::Failed};
+        try {
+            status = compress_file(*file_to_compress);
+        } catch (TraceableException& e) {
+            auto error_code = e.get_error_code();
+            if (ErrorCode_errno == error_code) {
+                SPDLOG_ERROR(
+                        "Failed to compress {} - {}:{} {}, errno={}",
+                        file_to_compress->get_path(),
+                        e.get_filename(),
+                        e.get_line_number(),
+                        e.what(),
+                        errno
+                );
+            } else {
+                SPDLOG_ERROR(
+                        "Failed to compress {} - {}:{} {}, error_code={}",
+                        file_to_compress->get_path(),
+                        e.get_filename(),
+                        e.get_line_number(),
+                        e.what(),
+                        error_code
+                );
+            }
+        } catch (std::exception& e) {
+            SPDLOG_ERROR(
+                    "Failed to compress {} - Unexpected exception - {}",
+                    file_to_compress->get_path(),
+                    e.what()
+            );
+        }
+        m_file_reader.close();
+
+        {
+            std::lock_guard const lock{m_compressor.m_mutex};
+            m_compressor.m_finished_files.emplace_back(file_to_compress, status);
+        }
+        m_compressor.m_owner_cv.notify_one();
+    }
+}
+
+auto ParallelFileCompressor::WorkerThread::compress_file(FileToCompress const& file_to_compress)
+        -> FileStatus {
+    m_file_reader.open(file_to_compress.get_path());
+
+    // Check that file is UTF-8 encoded
+    bool is_utf8_encoded_file{false};
+    if (false == check_utf8_encoding(m_file_reader, is_utf8_encoded_file)) {
+        return FileStatus::Failed;
+    }
+    if (false == is_utf8_encoded_file) {
+        return FileStatus::NotText;
+    }
+
+    auto const& path_for_compression = file_to_compress.get_path_for_compression();
+    auto const group_id = file_to_compress.get_group_id();
+    auto const orig_file_id = m_uuid_generator();
+    auto file = make_unique<Archive::ConcurrentFile>(
+            m_uuid_generator(),
+            orig_file_id,
+            path_for_compression,
+            group_id,
+            0,
+            0
+    );
+
+    m_parsed_message.clear();
+    while (m_message_parser.parse_next_message(true, m_file_reader, m_parsed_message)) {
+        if (file->get_file().get_encoded_size_in_bytes()
+            >= m_compressor.m_target_encoded_file_size)
+        {
+            auto const& encoded_file = file->get_file();
+            auto const has_ts_pattern = encoded_file.has_ts_pattern();
+            auto const end_message_ix = encoded_file.get_end_message_ix();
+            auto const split_ix = encoded_file.get_split_ix();
+            file->set_is_split(true);
+            m_compressor.enqueue_encoded_file(std::move(file));
+
+            file = make_unique<Archive::ConcurrentFile>(
+                    m_uuid_generator(),
+                    orig_file_id,
+                    path_for_compression,
+                    group_id,
+                    split_ix + 1,
+                    end_message_ix
+            );
+            if (has_ts_pattern) {
+                // Initialize the file's timestamp pattern to the previous split's pattern
+                file->change_ts_pattern(m_parsed_message.get_ts_patt());
+            }
+        }
+
+        if (m_parsed_message.has_ts_patt_changed()) {
+            file->change_ts_pattern(m_parsed_message.get_ts_patt());
+        }
+        m_archive_writer.write_msg(
+                *file,
+                m_parsed_message.get_ts(),
+                m_parsed_message.get_content(),
+                m_parsed_message.get_orig_num_bytes()
+        );
+    }
+    m_compressor.enqueue_encoded_file(std::move(file));
+
+    return FileStatus::Compressed;
+}
+}  // namespace clp::clp
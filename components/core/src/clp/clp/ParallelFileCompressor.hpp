@@ -0,0 +1,144 @@
+#ifndef CLP_CLP_PARALLELFILECOMPRESSOR_HPP
+#define CLP_CLP_PARALLELFILECOMPRESSOR_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <boost/uuid/random_generator.hpp>
+
+#include "../BufferedFileReader.hpp"
+#include "../MessageParser.hpp"
+#include "../ParsedMessage.hpp"
+#include "../streaming_archive/writer/Archive.hpp"
+#include "../Thread.hpp"
+#include "FileToCompress.hpp"
+
+namespace clp::clp {
+/**
+ * Class to parse and compress text files into a streaming archive using several threads. Each
+ * worker thread parses and encodes whole files using the archive's shared dictionaries, while the
+ * calling thread appends the encoded files to the archive's segments.
+ */
+class ParallelFileCompressor {
+public:
+    // Constructors
+    /**
+     * @param num_threads Number of worker threads
+     * @param target_encoded_file_size Target size (B) for an encoded file before it's split
+     */
+    ParallelFileCompressor(size_t num_threads, size_t target_encoded_file_size)
+            : m_num_threads{num_threads},
+              m_target_encoded_file_size{target_encoded_file_size} {}
+
+    // Methods
+    /**
+     * Compresses the given files into the archive using the heuristic parser. Since the encoded
+     * files reference the archive's dictionaries, the archive is only split between files, once
+     * every file being encoded has been appended to it. So the dictionaries can grow beyond
+     * `target_data_size_of_dicts` while a large file is being encoded.
+     *
+     * Files that aren't UTF-8 encoded text (e.g., archives of log files or IR streams) aren't
+     * compressed, but are returned so they can be compressed by a FileCompressor.
+     * @param files_to_compress
+     * @param target_data_size_of_dicts
+     * @param archive_user_config
+     * @param archive_writer
+     * @param non_text_files Returns the files that weren't compressed since they aren't text
+     * @param file_done_callback Called on the calling thread after each file is processed
+     * @return true if all text files were compressed successfully, false otherwise
+     * @throw Same as streaming_archive::writer::Archive::append_file_to_segment
+     * @throw Same as streaming_archive::writer::split_archive
+     */
+    bool compress_files(
+            std::vector<FileToCompress> const& files_to_compress,
+            size_t target_data_size_of_dicts,
+            streaming_archive::writer::Archive::UserConfig& archive_user_config,
+            streaming_archive::writer::Archive& archive_writer,
+            std::vector<FileToCompress>& non_text_files,
+            std::function<void()> const& file_done_callback
+    );
+
+private:
+    // Types
+    enum class FileStatus : uint8_t {
+        Compressed,
+        Failed,
+        NotText
+    };
+
+    /**
+     * Thread that parses and encodes the files handed to it by the ParallelFileCompressor
+     */
+    class WorkerThread : public Thread {
+    public:
+        // Constructors
+        WorkerThread(
+                ParallelFileCompressor& compressor,
+                streaming_archive::writer::Archive& archive_writer
+        )
+                : m_compressor{compressor},
+                  m_archive_writer{archive_writer} {}
+
+    private:
+        // Methods implementing `clp::Thread`
+        auto thread_method() -> void final;
+
+        // Methods
+        /**
+         * Parses and encodes the given file, handing each encoded file (or split of it) to the
+         * compressor as it's completed
+         * @param file_to_compress
+         * @return The status of the file
+         */
+        auto compress_file(FileToCompress const& file_to_compress) -> FileStatus;
+
+        // Variables
+        ParallelFileCompressor& m_compressor;
+        streaming_archive::writer::Archive& m_archive_writer;
+        boost::uuids::random_generator m_uuid_generator;
+        BufferedFileReader m_file_reader;
+        MessageParser m_message_parser;
+        ParsedMessage m_parsed_message;
+    };
+
+    // Methods
+    /**
+     * Queues an encoded file so the calling thread can append it to the archive
+     * @param file
+     */
+    void enqueue_encoded_file(
+            std::unique_ptr<streaming_archive::writer::Archive::ConcurrentFile> file
+    );
+
+    /**
+     * Signals the worker threads to exit once they've finished their current file, and joins them
+     * @param workers
+     */
+    void stop_workers(std::vector<std::unique_ptr<WorkerThread>>& workers);
+
+    // Variables
+    size_t m_num_threads;
+    size_t m_target_encoded_file_size;
+
+    // Guards the queues below and m_is_stopping
+    std::mutex m_mutex;
+    // Notifies workers of pending files or that they should stop
+    std::condition_variable m_worker_cv;
+    // Notifies the calling thread of encoded and finished files
+    std::condition_variable m_owner_cv;
+    std::deque<FileToCompress const*> m_pending_files;
+    std::deque<std::unique_ptr<streaming_archive::writer::Archive::ConcurrentFile>>
+            m_encoded_files;
+    std::deque<std::pair<FileToCompress const*, FileStatus>> m_finished_files;
+    bool m_is_stopping{false};
+};
+}  // namespace clp::clp
+
+#endif  // CLP_CLP_PARALLELFILECOMPRESSOR_HPP
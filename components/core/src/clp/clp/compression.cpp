@@ -14,6 +14,7 @@
 #include "../streaming_archive/writer/utils.hpp"
 #include "../Utils.hpp"
 #include "FileCompressor.hpp"
+#include "ParallelFileCompressor.hpp"
 #include "utils.hpp"
 
 using clp::streaming_archive::writer::split_archive;
@@ -130,11 +131,40 @@ bool compress(
     if (command_line_args.show_progress()) {
         num_files_to_compress = files_to_compress.size() + grouped_files_to_compress.size();
     }
+    auto print_progress = [&]() {
+        if (command_line_args.show_progress()) {
+            ++num_files_compressed;
+            cerr << "Compressed " << num_files_compressed << '/' << num_files_to_compress
+                 << " files" << '\r';
+        }
+    };
     if (command_line_args.sort_input_files()) {
         sort(files_to_compress.begin(),
              files_to_compress.end(),
              file_gt_last_write_time_comparator);
     }
+    if (use_heuristic && command_line_args.get_num_threads() > 1) {
+        // Text files are compressed in parallel, while any other files (e.g., archives of log
+        // files or IR streams) are left to be compressed one at a time below
+        ParallelFileCompressor parallel_file_compressor(
+                command_line_args.get_num_threads(),
+                target_encoded_file_size
+        );
+        vector<FileToCompress> non_text_files;
+        if (false
+            == parallel_file_compressor.compress_files(
+                    files_to_compress,
+                    target_data_size_of_dictionaries,
+                    archive_user_config,
+                    archive_writer,
+                    non_text_files,
+                    print_progress
+            ))
+        {
+            all_files_compressed_successfully = false;
+        }
+        files_to_compress = std::move(non_text_files);
+    }
     for (auto it = files_to_compress.cbegin(); it != files_to_compress.cend(); ++it) {
         if (archive_writer.get_data_size_of_dictionaries() >= target_data_size_of_dictionaries) {
             split_archive(archive_user_config, archive_writer);
@@ -151,11 +181,7 @@ bool compress(
         {
             all_files_compressed_successfully = false;
         }
-        if (command_line_args.show_progress()) {
-            ++num_files_compressed;
-            cerr << "Compressed " << num_files_compressed << '/' << num_files_to_compress
-                 << " files" << '\r';
-        }
+        print_progress();
     }
 
     // Sort files by group ID to avoid spreading groups over multiple segments
@@ -179,11 +205,7 @@ bool compress(
         {
             all_files_compressed_successfully = false;
         }
-        if (command_line_args.show_progress()) {
-            ++num_files_compressed;
-            cerr << "Compressed " << num_files_compressed << '/' << num_files_to_compress
-                 << " files" << '\r';
-        }
+        print_progress();
     }
 
     archive_writer.close();
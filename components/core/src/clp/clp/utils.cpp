@@ -1,5 +1,6 @@
 #include "utils.hpp"
 
+#include <algorithm>
 #include <filesystem>
 #include <memory>
 
@@ -11,12 +12,40 @@
 #include "../spdlog_with_specializations.hpp"
 #include "../streaming_archive/Constants.hpp"
 #include "../TraceableException.hpp"
+#include "../utf8_utils.hpp"
 #include "../Utils.hpp"
 
 using std::string;
 using std::vector;
 
 namespace clp::clp {
+bool check_utf8_encoding(BufferedFileReader& file_reader, bool& is_utf8_encoded_file) {
+    if (auto error_code = file_reader.try_refill_buffer_if_empty();
+        ErrorCode_Success != error_code && ErrorCode_EndOfFile != error_code)
+    {
+        if (ErrorCode_errno == error_code) {
+            SPDLOG_ERROR(
+                    "Failed to read {} into buffer, errno={}",
+                    file_reader.get_path(),
+                    errno
+            );
+        } else {
+            SPDLOG_ERROR(
+                    "Failed to read {} into buffer, error={}",
+                    file_reader.get_path(),
+                    error_code
+            );
+        }
+        return false;
+    }
+    char const* utf8_validation_buf{nullptr};
+    size_t peek_size{0};
+    file_reader.peek_buffered_data(utf8_validation_buf, peek_size);
+    auto const utf8_validation_buf_len = std::min(peek_size, cUtfMaxValidationLen);
+    is_utf8_encoded_file = is_utf8_encoded({utf8_validation_buf, utf8_validation_buf_len});
+    return true;
+}
+
 bool find_all_files_and_empty_directories(
         boost::filesystem::path& path_prefix_to_remove,
         string const& path,
@@ -1,12 +1,14 @@
 #ifndef CLP_CLP_UTILS_HPP
 #define CLP_CLP_UTILS_HPP
 
+#include <cstddef>
 #include <filesystem>
 #include <memory>
 #include <string>
 
 #include <boost/filesystem/path.hpp>
 
+#include "../BufferedFileReader.hpp"
 #include "../ErrorCode.hpp"
 #include "../GlobalMetadataDB.hpp"
 #include "../GlobalMetadataDBConfig.hpp"
@@ -25,7 +27,20 @@ public:
     [[nodiscard]] char const* what() const noexcept override { return "CLP operation failed"; }
 };
 
+// Constants
+// Number of bytes at the start of a file that are validated to decide whether it's UTF-8 encoded
+constexpr size_t cUtfMaxValidationLen = 4096;
+
 // Methods
+/**
+ * Fills the buffer of the given reader, which was just opened, and checks whether the start of its
+ * file is UTF-8 encoded. Failures to read the file are logged.
+ * @param file_reader
+ * @param is_utf8_encoded_file Returns whether the file is UTF-8 encoded
+ * @return true on success, false if the file couldn't be read
+ */
+bool check_utf8_encoding(BufferedFileReader& file_reader, bool& is_utf8_encoded_file);
+
 /**
  * Recursively finds all files and empty directories at the given path
  * @param path_prefix_to_remove
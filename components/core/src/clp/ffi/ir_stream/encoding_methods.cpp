@@ -1,10 +1,14 @@
 #include "encoding_methods.hpp"
 
+#include <cstddef>
+#include <type_traits>
+
 #include <nlohmann/json.hpp>
 
 #include "../../ir/parsing.hpp"
 #include "../../ir/types.hpp"
 #include "../../time_types.hpp"
+#include "../../type_utils.hpp"
 #include "protocol_constants.hpp"
 #include "utils.hpp"
 
@@ -25,6 +29,27 @@ namespace clp::ffi::ir_stream {
  */
 static bool serialize_logtype(string_view logtype, vector<int8_t>& ir_buf);
 
+/**
+ * Serializes a message that has already been encoded into a logtype and variables into the IR
+ * stream
+ * @tparam encoded_variable_t Type of the encoded variable
+ * @param logtype
+ * @param encoded_vars
+ * @param all_dictionary_vars
+ * @param dictionary_var_end_offsets
+ * @param ir_buf
+ * @return true on success, false if the number of variables doesn't match the logtype's
+ * placeholders or if any component is too long to be serialized
+ */
+template <typename encoded_variable_t>
+static bool serialize_encoded_message_generically(
+        string_view logtype,
+        vector<encoded_variable_t> const& encoded_vars,
+        string_view all_dictionary_vars,
+        vector<size_t> const& dictionary_var_end_offsets,
+        vector<int8_t>& ir_buf
+);
+
 /**
  * Adds the basic metadata fields to the given JSON object
  * @param timestamp_pattern
@@ -92,6 +117,71 @@ static bool serialize_logtype(string_view logtype, vector<int8_t>& ir_buf) {
     return true;
 }
 
+template <typename encoded_variable_t>
+static bool serialize_encoded_message_generically(
+        string_view logtype,
+        vector<encoded_variable_t> const& encoded_vars,
+        string_view all_dictionary_vars,
+        vector<size_t> const& dictionary_var_end_offsets,
+        vector<int8_t>& ir_buf
+) {
+    constexpr auto cEncodedVarTag
+            = std::is_same_v<encoded_variable_t, eight_byte_encoded_variable_t>
+                      ? cProtocol::Payload::VarEightByteEncoding
+                      : cProtocol::Payload::VarFourByteEncoding;
+
+    // Variables are serialized in the order their placeholders appear in the logtype
+    DictionaryVariableHandler dictionary_variable_handler{ir_buf};
+    size_t encoded_var_ix{0};
+    size_t dictionary_var_ix{0};
+    size_t dictionary_var_begin_pos{0};
+    bool is_escaped{false};
+    for (auto const c : logtype) {
+        if (is_escaped) {
+            is_escaped = false;
+            continue;
+        }
+        if (enum_to_underlying_type(ir::VariablePlaceholder::Escape) == c) {
+            is_escaped = true;
+        } else if (enum_to_underlying_type(ir::VariablePlaceholder::Integer) == c
+                   || enum_to_underlying_type(ir::VariablePlaceholder::Float) == c)
+        {
+            if (encoded_var_ix >= encoded_vars.size()) {
+                return false;
+            }
+            ir_buf.push_back(cEncodedVarTag);
+            serialize_int(encoded_vars[encoded_var_ix++], ir_buf);
+        } else if (enum_to_underlying_type(ir::VariablePlaceholder::Dictionary) == c) {
+            if (dictionary_var_ix >= dictionary_var_end_offsets.size()) {
+                return false;
+            }
+            auto const dictionary_var_end_pos = dictionary_var_end_offsets[dictionary_var_ix++];
+            if (dictionary_var_end_pos < dictionary_var_begin_pos
+                || dictionary_var_end_pos > all_dictionary_vars.length())
+            {
+                return false;
+            }
+            if (false
+                == dictionary_variable_handler(
+                        all_dictionary_vars,
+                        dictionary_var_begin_pos,
+                        dictionary_var_end_pos
+                ))
+            {
+                return false;
+            }
+            dictionary_var_begin_pos = dictionary_var_end_pos;
+        }
+    }
+    if (encoded_var_ix != encoded_vars.size()
+        || dictionary_var_ix != dictionary_var_end_offsets.size())
+    {
+        return false;
+    }
+
+    return serialize_logtype(logtype, ir_buf);
+}
+
 static void add_base_metadata_fields(
         string_view timestamp_pattern,
         string_view timestamp_pattern_syntax,
@@ -169,6 +259,22 @@ serialize_message(std::string_view message, std::string& logtype, std::vector<in
 
     return serialize_logtype(logtype, ir_buf);
 }
+
+bool serialize_encoded_message(
+        string_view logtype,
+        vector<eight_byte_encoded_variable_t> const& encoded_vars,
+        string_view all_dictionary_vars,
+        vector<size_t> const& dictionary_var_end_offsets,
+        vector<int8_t>& ir_buf
+) {
+    return serialize_encoded_message_generically(
+            logtype,
+            encoded_vars,
+            all_dictionary_vars,
+            dictionary_var_end_offsets,
+            ir_buf
+    );
+}
 }  // namespace eight_byte_encoding
 
 namespace four_byte_encoding {
@@ -239,6 +345,22 @@ bool serialize_message(string_view message, string& logtype, vector<int8_t>& ir_
     return true;
 }
 
+bool serialize_encoded_message(
+        string_view logtype,
+        vector<four_byte_encoded_variable_t> const& encoded_vars,
+        string_view all_dictionary_vars,
+        vector<size_t> const& dictionary_var_end_offsets,
+        vector<int8_t>& ir_buf
+) {
+    return serialize_encoded_message_generically(
+            logtype,
+            encoded_vars,
+            all_dictionary_vars,
+            dictionary_var_end_offsets,
+            ir_buf
+    );
+}
+
 bool serialize_timestamp(epoch_time_ms_t timestamp_delta, std::vector<int8_t>& ir_buf) {
     if (INT8_MIN <= timestamp_delta && timestamp_delta <= INT8_MAX) {
         ir_buf.push_back(cProtocol::Payload::TimestampDeltaByte);
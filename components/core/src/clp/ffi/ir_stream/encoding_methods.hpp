@@ -1,6 +1,7 @@
 #ifndef CLP_FFI_IR_STREAM_ENCODING_METHODS_HPP
 #define CLP_FFI_IR_STREAM_ENCODING_METHODS_HPP
 
+#include <cstddef>
 #include <string_view>
 #include <vector>
 
@@ -48,6 +49,26 @@ bool serialize_log_event(
  * @return Whether the message was serialized successfully.
  */
 bool serialize_message(std::string_view message, std::string& logtype, std::vector<int8_t>& ir_buf);
+
+/**
+ * Serializes a message that has already been encoded into a logtype and variables into the
+ * eight-byte encoding IR stream, without re-parsing the message.
+ * @param logtype
+ * @param encoded_vars
+ * @param all_dictionary_vars The message's dictionary variables, stored back-to-back in a single
+ * byte-array
+ * @param dictionary_var_end_offsets The end-offset of each dictionary variable in
+ * `all_dictionary_vars`
+ * @param ir_buf
+ * @return Whether the message was serialized successfully.
+ */
+bool serialize_encoded_message(
+        std::string_view logtype,
+        std::vector<ir::eight_byte_encoded_variable_t> const& encoded_vars,
+        std::string_view all_dictionary_vars,
+        std::vector<size_t> const& dictionary_var_end_offsets,
+        std::vector<int8_t>& ir_buf
+);
 }  // namespace eight_byte_encoding
 
 namespace four_byte_encoding {
@@ -93,6 +114,26 @@ bool serialize_log_event(
  */
 bool serialize_message(std::string_view message, std::string& logtype, std::vector<int8_t>& ir_buf);
 
+/**
+ * Serializes a message that has already been encoded into a logtype and variables into the
+ * four-byte encoding IR stream, without re-parsing the message.
+ * @param logtype
+ * @param encoded_vars
+ * @param all_dictionary_vars The message's dictionary variables, stored back-to-back in a single
+ * byte-array
+ * @param dictionary_var_end_offsets The end-offset of each dictionary variable in
+ * `all_dictionary_vars`
+ * @param ir_buf
+ * @return Whether the message was serialized successfully.
+ */
+bool serialize_encoded_message(
+        std::string_view logtype,
+        std::vector<ir::four_byte_encoded_variable_t> const& encoded_vars,
+        std::string_view all_dictionary_vars,
+        std::vector<size_t> const& dictionary_var_end_offsets,
+        std::vector<int8_t>& ir_buf
+);
+
 /**
  * Serializes the given timestamp delta into the four-byte encoding IR stream
  * @param timestamp_delta
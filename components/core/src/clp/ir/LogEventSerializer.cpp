@@ -1,7 +1,9 @@
 #include "LogEventSerializer.hpp"
 
+#include <cstddef>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <spdlog/spdlog.h>
 
@@ -9,11 +11,13 @@
 #include "../ErrorCode.hpp"
 #include "../ffi/ir_stream/encoding_methods.hpp"
 #include "../ffi/ir_stream/protocol_constants.hpp"
+#include "../ffi/ir_stream/utils.hpp"
 #include "../ir/types.hpp"
 #include "../type_utils.hpp"
 
 using std::string;
 using std::string_view;
+using std::vector;
 
 namespace clp::ir {
 template <typename encoded_variable_t>
@@ -131,6 +135,59 @@ auto LogEventSerializer<encoded_variable_t>::serialize_log_event(
     return true;
 }
 
+template <typename encoded_variable_t>
+auto LogEventSerializer<encoded_variable_t>::serialize_encoded_log_event(
+        epoch_time_ms_t timestamp,
+        string_view logtype,
+        vector<encoded_variable_t> const& encoded_vars,
+        string_view all_dictionary_vars,
+        vector<size_t> const& dictionary_var_end_offsets
+) -> bool {
+    if (false == m_is_open) {
+        throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
+    }
+
+    auto const buf_size_before_serialization = m_ir_buf.size();
+    if constexpr (std::is_same_v<encoded_variable_t, eight_byte_encoded_variable_t>) {
+        if (false
+            == clp::ffi::ir_stream::eight_byte_encoding::serialize_encoded_message(
+                    logtype,
+                    encoded_vars,
+                    all_dictionary_vars,
+                    dictionary_var_end_offsets,
+                    m_ir_buf
+            ))
+        {
+            m_ir_buf.resize(buf_size_before_serialization);
+            return false;
+        }
+        m_ir_buf.push_back(clp::ffi::ir_stream::cProtocol::Payload::TimestampVal);
+        clp::ffi::ir_stream::serialize_int(timestamp, m_ir_buf);
+    } else {
+        if (false
+            == clp::ffi::ir_stream::four_byte_encoding::serialize_encoded_message(
+                    logtype,
+                    encoded_vars,
+                    all_dictionary_vars,
+                    dictionary_var_end_offsets,
+                    m_ir_buf
+            )
+            || false
+                       == clp::ffi::ir_stream::four_byte_encoding::serialize_timestamp(
+                               timestamp - m_prev_event_timestamp,
+                               m_ir_buf
+                       ))
+        {
+            m_ir_buf.resize(buf_size_before_serialization);
+            return false;
+        }
+        m_prev_event_timestamp = timestamp;
+    }
+    m_serialized_size += m_ir_buf.size() - buf_size_before_serialization;
+    ++m_num_log_events;
+    return true;
+}
+
 template <typename encoded_variable_t>
 auto LogEventSerializer<encoded_variable_t>::close_writer() -> void {
     m_zstd_compressor.close();
@@ -157,6 +214,20 @@ template auto LogEventSerializer<four_byte_encoded_variable_t>::serialize_log_ev
         epoch_time_ms_t timestamp,
         string_view message
 ) -> bool;
+template auto LogEventSerializer<eight_byte_encoded_variable_t>::serialize_encoded_log_event(
+        epoch_time_ms_t timestamp,
+        string_view logtype,
+        vector<eight_byte_encoded_variable_t> const& encoded_vars,
+        string_view all_dictionary_vars,
+        vector<size_t> const& dictionary_var_end_offsets
+) -> bool;
+template auto LogEventSerializer<four_byte_encoded_variable_t>::serialize_encoded_log_event(
+        epoch_time_ms_t timestamp,
+        string_view logtype,
+        vector<four_byte_encoded_variable_t> const& encoded_vars,
+        string_view all_dictionary_vars,
+        vector<size_t> const& dictionary_var_end_offsets
+) -> bool;
 template auto LogEventSerializer<eight_byte_encoded_variable_t>::close_writer() -> void;
 template auto LogEventSerializer<four_byte_encoded_variable_t>::close_writer() -> void;
 }  // namespace clp::ir
@@ -90,6 +90,25 @@ public:
     [[nodiscard]] auto serialize_log_event(epoch_time_ms_t timestamp, std::string_view message)
             -> bool;
 
+    /**
+     * Serializes the given log event, whose message has already been encoded into a logtype and
+     * variables, without re-parsing the message.
+     * @param timestamp
+     * @param logtype
+     * @param encoded_vars
+     * @param all_dictionary_vars The message's dictionary variables, stored back-to-back
+     * @param dictionary_var_end_offsets The end-offset of each dictionary variable in
+     * `all_dictionary_vars`
+     * @return Whether the log event was successfully serialized.
+     */
+    [[nodiscard]] auto serialize_encoded_log_event(
+            epoch_time_ms_t timestamp,
+            std::string_view logtype,
+            std::vector<encoded_variable_t> const& encoded_vars,
+            std::string_view all_dictionary_vars,
+            std::vector<size_t> const& dictionary_var_end_offsets
+    ) -> bool;
+
 private:
     // Constants
     // NOTE: IR files currently store the log's timestamp pattern and timezone ID. However:
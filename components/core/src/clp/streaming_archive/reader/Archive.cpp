@@ -220,6 +220,37 @@ Archive::decompress_message_without_ts(Message const& compressed_msg, string& de
     return true;
 }
 
+bool Archive::convert_message_to_four_byte_ir(
+        Message const& compressed_msg,
+        string& ir_logtype,
+        vector<ir::four_byte_encoded_variable_t>& ir_encoded_vars,
+        string& ir_dict_vars,
+        vector<size_t>& ir_dict_var_end_offsets
+) {
+    auto const logtype_id = compressed_msg.get_logtype_id();
+    auto const& logtype_entry = m_logtype_dictionary.get_entry(logtype_id);
+    if (false
+        == EncodedVariableInterpreter::convert_to_four_byte_ir_message(
+                logtype_entry,
+                m_var_dictionary,
+                compressed_msg.get_vars(),
+                ir_logtype,
+                ir_encoded_vars,
+                ir_dict_vars,
+                ir_dict_var_end_offsets
+        ))
+    {
+        SPDLOG_ERROR(
+                "streaming_archive::reader::Archive: Failed to convert variables from logtype id "
+                "{} into IR",
+                logtype_id
+        );
+        return false;
+    }
+
+    return true;
+}
+
 void Archive::decompress_empty_directories(string const& output_dir) {
     boost::filesystem::path output_dir_path = boost::filesystem::path(output_dir);
 
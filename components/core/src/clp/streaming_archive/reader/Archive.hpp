@@ -1,14 +1,17 @@
 #ifndef CLP_STREAMING_ARCHIVE_READER_ARCHIVE_HPP
 #define CLP_STREAMING_ARCHIVE_READER_ARCHIVE_HPP
 
+#include <cstddef>
 #include <filesystem>
 #include <iterator>
 #include <list>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "../../ErrorCode.hpp"
+#include "../../ir/types.hpp"
 #include "../../LogTypeDictionaryReader.hpp"
 #include "../../Query.hpp"
 #include "../../SQLiteDB.hpp"
@@ -109,6 +112,24 @@ public:
     bool
     decompress_message_without_ts(Message const& compressed_msg, std::string& decompressed_msg);
 
+    /**
+     * Converts the given message into a four-byte encoded IR message (without its timestamp),
+     * without decompressing the message into a string.
+     * @param compressed_msg
+     * @param ir_logtype
+     * @param ir_encoded_vars
+     * @param ir_dict_vars The IR message's dictionary variables, stored back-to-back
+     * @param ir_dict_var_end_offsets The end-offset of each dictionary variable in `ir_dict_vars`
+     * @return Whether the message was successfully converted
+     */
+    bool convert_message_to_four_byte_ir(
+            Message const& compressed_msg,
+            std::string& ir_logtype,
+            std::vector<ir::four_byte_encoded_variable_t>& ir_encoded_vars,
+            std::string& ir_dict_vars,
+            std::vector<size_t>& ir_dict_var_end_offsets
+    );
+
     void decompress_empty_directories(std::string const& output_dir);
 
     std::unique_ptr<MetadataDB::FileIterator> get_file_iterator_by_split_id(
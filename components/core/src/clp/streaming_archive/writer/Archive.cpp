@@ -31,6 +31,18 @@ using std::unordered_set;
 using std::vector;
 
 namespace clp::streaming_archive::writer {
+Archive::ConcurrentFile::ConcurrentFile(
+        boost::uuids::uuid const& id,
+        boost::uuids::uuid const& orig_file_id,
+        string const& path,
+        group_id_t const group_id,
+        size_t split_ix,
+        size_t begin_message_ix
+)
+        : m_file{make_unique<File>(id, orig_file_id, path, group_id, split_ix, begin_message_ix)} {
+    m_file->open();
+}
+
 Archive::~Archive() {
     if (m_path.empty() == false || m_file != nullptr
         || m_files_with_timestamps_in_segment.empty() == false
@@ -315,6 +327,36 @@ Archive::write_msg(epochtime_t timestamp, string const& message, size_t num_unco
     update_segment_indices(logtype_id, var_ids);
 }
 
+void Archive::write_msg(
+        ConcurrentFile& file,
+        epochtime_t timestamp,
+        string const& message,
+        size_t num_uncompressed_bytes
+) {
+    file.m_encoded_vars.clear();
+    file.m_encoded_var_ids.clear();
+    EncodedVariableInterpreter::encode_and_add_to_dictionary(
+            message,
+            file.m_logtype_dict_entry,
+            m_var_dict,
+            file.m_encoded_vars,
+            file.m_encoded_var_ids
+    );
+    logtype_dictionary_id_t logtype_id;
+    m_logtype_dict.add_entry(file.m_logtype_dict_entry, logtype_id);
+
+    file.m_file->write_encoded_msg(
+            timestamp,
+            logtype_id,
+            file.m_encoded_vars,
+            file.m_encoded_var_ids,
+            num_uncompressed_bytes
+    );
+
+    file.m_logtype_ids.insert(logtype_id);
+    file.m_var_ids.insert(file.m_encoded_var_ids.cbegin(), file.m_encoded_var_ids.cend());
+}
+
 void Archive::write_msg_using_schema(LogEventView const& log_view) {
     epochtime_t timestamp = 0;
     TimestampPattern* timestamp_pattern = nullptr;
@@ -556,6 +598,26 @@ void Archive::append_file_to_segment() {
     m_file = nullptr;
 }
 
+void Archive::append_file_to_segment(std::unique_ptr<ConcurrentFile> file) {
+    if (m_file != nullptr) {
+        throw OperationFailed(ErrorCode_NotReady, __FILENAME__, __LINE__);
+    }
+
+    file->m_file->close();
+    // The file's IDs are assigned to the timestamp or timestamp-less segment below, the same as
+    // the IDs of a file written by this thread
+    m_logtype_ids_for_file_with_unassigned_segment.insert(
+            file->m_logtype_ids.cbegin(),
+            file->m_logtype_ids.cend()
+    );
+    m_var_ids_for_file_with_unassigned_segment.insert(
+            file->m_var_ids.cbegin(),
+            file->m_var_ids.cend()
+    );
+    m_file = file->m_file.release();
+    append_file_to_segment();
+}
+
 void Archive::persist_file_metadata(vector<File*> const& files) {
     if (files.empty()) {
         return;
@@ -62,6 +62,56 @@ public:
         }
     };
 
+    /**
+     * An encoded file that's written by a thread other than the one that owns the archive. Any
+     * number of concurrent files may be written at once, each by a single thread, and each file
+     * tracks the dictionary IDs it references until it's appended to a segment by the owning
+     * thread.
+     */
+    class ConcurrentFile {
+    public:
+        // Constructors
+        /**
+         * Creates and opens a file with the given path
+         * @param id
+         * @param orig_file_id
+         * @param path
+         * @param group_id
+         * @param split_ix
+         * @param begin_message_ix
+         */
+        ConcurrentFile(
+                boost::uuids::uuid const& id,
+                boost::uuids::uuid const& orig_file_id,
+                std::string const& path,
+                group_id_t group_id,
+                size_t split_ix,
+                size_t begin_message_ix
+        );
+
+        // Methods
+        File const& get_file() const { return *m_file; }
+
+        void set_is_split(bool is_split) { m_file->set_is_split(is_split); }
+
+        void change_ts_pattern(TimestampPattern const* pattern) {
+            m_file->change_ts_pattern(pattern);
+        }
+
+    private:
+        friend class Archive;
+
+        // Variables
+        std::unique_ptr<File> m_file;
+        std::unordered_set<logtype_dictionary_id_t> m_logtype_ids;
+        std::unordered_set<variable_dictionary_id_t> m_var_ids;
+
+        // Preallocated buffers for encoding messages
+        LogTypeDictionaryEntry m_logtype_dict_entry;
+        std::vector<encoded_variable_t> m_encoded_vars;
+        std::vector<variable_dictionary_id_t> m_encoded_var_ids;
+    };
+
     TimestampPattern* m_old_ts_pattern;
     size_t m_target_data_size_of_dicts;
     UserConfig m_archive_user_config;
@@ -145,6 +195,22 @@ public:
     void
     write_msg(epochtime_t timestamp, std::string const& message, size_t num_uncompressed_bytes);
 
+    /**
+     * Encodes and writes a message to the given concurrent file. Unlike the other methods, this
+     * may be called by several threads at once, so long as each writes to a different file.
+     * @param file
+     * @param timestamp
+     * @param message
+     * @param num_uncompressed_bytes
+     * @throw FileWriter::OperationFailed if any write fails
+     */
+    void write_msg(
+            ConcurrentFile& file,
+            epochtime_t timestamp,
+            std::string const& message,
+            size_t num_uncompressed_bytes
+    );
+
     /**
      * Encodes and writes a message to the given file using schema file
      * @param log_event_view
@@ -177,6 +243,15 @@ public:
      */
     void append_file_to_segment();
 
+    /**
+     * Closes the given concurrent file and adds it to the segment
+     * @param file
+     * @throw streaming_archive::writer::Archive::OperationFailed if another file is open in the
+     * archive
+     * @throw Same as streaming_archive::writer::Archive::append_file_to_segment
+     */
+    void append_file_to_segment(std::unique_ptr<ConcurrentFile> file);
+
     /**
      * Adds empty directories to the archive
      * @param empty_directory_paths
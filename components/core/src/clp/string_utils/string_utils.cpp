@@ -1,7 +1,10 @@
 #include "string_utils/string_utils.hpp"
 
 #include <algorithm>
+#include <bit>
 #include <charconv>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
 
 using std::string;
@@ -9,16 +12,56 @@ using std::string_view;
 
 namespace {
 /**
- * Helper for ``wildcard_match_unsafe_case_sensitive`` to advance the pointer in
- * tame to the next character which matches wild. This method should be inlined
- * for performance.
+ * Folds an ASCII character to lowercase, matching std::tolower in the "C" locale.
+ * @param c
+ * @return The folded character
+ */
+inline char fold_case(char c);
+
+/**
+ * Checks whether a character in tame matches a (non-wildcard) character in wild.
+ * @tparam case_sensitive
+ * @param t
+ * @param w
+ * @return Whether the characters match
+ */
+template <bool case_sensitive>
+inline bool chars_match(char t, char w);
+
+/**
+ * Finds the first occurrence of either of two bytes in a range. Eight bytes are compared at a time
+ * using SWAR (SIMD within a register) so that case-insensitive searches don't fall back to
+ * comparing one byte at a time.
+ * @param begin
+ * @param end
+ * @param c1
+ * @param c2
+ * @return A pointer to the first occurrence, or `end` if neither byte occurs
+ */
+inline char const* find_either_char(char const* begin, char const* end, char c1, char c2);
+
+/**
+ * Finds the first character in tame that matches a (non-wildcard) character in wild.
+ * @tparam case_sensitive
+ * @param begin
+ * @param end
+ * @param w
+ * @return A pointer to the first match, or `end` if there's none
+ */
+template <bool case_sensitive>
+inline char const* find_matching_char(char const* begin, char const* end, char w);
+
+/**
+ * Helper for ``wildcard_match_unsafe_impl`` to advance the pointer in tame to the next character
+ * which matches wild. This method should be inlined for performance.
+ * @tparam case_sensitive
  * @param tame_current
  * @param tame_bookmark
  * @param tame_end
  * @param wild_current
- * @param wild_bookmark
  * @return true on success, false if wild cannot match tame
  */
+template <bool case_sensitive>
 inline bool advance_tame_to_next_match(
         char const*& tame_current,
         char const*& tame_bookmark,
@@ -26,6 +69,84 @@ inline bool advance_tame_to_next_match(
         char const*& wild_current
 );
 
+/**
+ * Implements ``wildcard_match_unsafe_case_sensitive`` and its case-insensitive variant. Case is
+ * folded as characters are compared, so neither string needs to be copied.
+ * @tparam case_sensitive
+ * @param tame
+ * @param wild
+ * @return Whether the two strings match
+ */
+template <bool case_sensitive>
+bool wildcard_match_unsafe_impl(string_view tame, string_view wild);
+
+inline char fold_case(char c) {
+    return ('A' <= c && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+template <bool case_sensitive>
+inline bool chars_match(char t, char w) {
+    if constexpr (case_sensitive) {
+        return t == w;
+    } else {
+        return fold_case(t) == fold_case(w);
+    }
+}
+
+inline char const* find_either_char(char const* begin, char const* end, char c1, char c2) {
+    if constexpr (std::endian::little == std::endian::native) {
+        constexpr uint64_t cLowBits{0x0101'0101'0101'0101ULL};
+        constexpr uint64_t cHighBits{0x8080'8080'8080'8080ULL};
+        auto const pattern1 = cLowBits * static_cast<unsigned char>(c1);
+        auto const pattern2 = cLowBits * static_cast<unsigned char>(c2);
+        // Sets the high bit of each zero byte. Borrows can also set the high bits of bytes above a
+        // zero byte, but never below the first one, so the lowest set bit is always exact.
+        auto const zero_bytes = [](uint64_t word) -> uint64_t {
+            return (word - cLowBits) & ~word & cHighBits;
+        };
+
+        auto current = begin;
+        for (; end - current >= static_cast<std::ptrdiff_t>(sizeof(uint64_t));
+             current += sizeof(uint64_t))
+        {
+            uint64_t word{};
+            std::memcpy(&word, current, sizeof(word));
+            auto const matches = zero_bytes(word ^ pattern1) | zero_bytes(word ^ pattern2);
+            if (0 != matches) {
+                return current + std::countr_zero(matches) / 8;
+            }
+        }
+        begin = current;
+    }
+
+    for (auto current = begin; end != current; ++current) {
+        if (c1 == *current || c2 == *current) {
+            return current;
+        }
+    }
+    return end;
+}
+
+template <bool case_sensitive>
+inline char const* find_matching_char(char const* begin, char const* end, char w) {
+    if constexpr (false == case_sensitive) {
+        auto const lowercase_w = fold_case(w);
+        if ('a' <= lowercase_w && lowercase_w <= 'z') {
+            return find_either_char(
+                    begin,
+                    end,
+                    lowercase_w,
+                    static_cast<char>(lowercase_w - 'a' + 'A')
+            );
+        }
+    }
+
+    // memchr is vectorized by the C library
+    auto const* match = std::memchr(begin, w, end - begin);
+    return nullptr == match ? end : static_cast<char const*>(match);
+}
+
+template <bool case_sensitive>
 inline bool advance_tame_to_next_match(
         char const*& tame_current,
         char const*& tame_bookmark,
@@ -46,17 +167,11 @@ inline bool advance_tame_to_next_match(
         }
 
         // Advance tame_current until it matches wild_current
-        while (true) {
-            if (tame_end == tame_current) {
-                // Wild group is longer than last group in tame, so can't match
-                // e.g. "*abc" doesn't match "zab"
-                return false;
-            }
-            auto t = *tame_current;
-            if (t == w) {
-                break;
-            }
-            ++tame_current;
+        tame_current = find_matching_char<case_sensitive>(tame_current, tame_end, w);
+        if (tame_end == tame_current) {
+            // Wild group is longer than last group in tame, so can't match
+            // e.g. "*abc" doesn't match "zab"
+            return false;
         }
     }
 
@@ -64,121 +179,6 @@ inline bool advance_tame_to_next_match(
 
     return true;
 }
-}  // namespace
-
-namespace clp::string_utils {
-size_t find_first_of(
-        string const& haystack,
-        char const* needles,
-        size_t search_start_pos,
-        size_t& needle_ix
-) {
-    size_t haystack_length = haystack.length();
-    size_t needles_length = strlen(needles);
-    for (size_t i = search_start_pos; i < haystack_length; ++i) {
-        for (needle_ix = 0; needle_ix < needles_length; ++needle_ix) {
-            if (haystack[i] == needles[needle_ix]) {
-                return i;
-            }
-        }
-    }
-
-    return string::npos;
-}
-
-string replace_characters(
-        char const* characters_to_replace,
-        char const* replacement_characters,
-        string const& value,
-        bool escape
-) {
-    string new_value;
-    size_t search_start_pos = 0;
-    while (true) {
-        size_t replace_char_ix;
-        size_t char_to_replace_pos
-                = find_first_of(value, characters_to_replace, search_start_pos, replace_char_ix);
-        if (string::npos == char_to_replace_pos) {
-            new_value.append(value, search_start_pos, string::npos);
-            break;
-        } else {
-            new_value.append(value, search_start_pos, char_to_replace_pos - search_start_pos);
-            if (escape) {
-                new_value += "\\";
-            }
-            new_value += replacement_characters[replace_char_ix];
-            search_start_pos = char_to_replace_pos + 1;
-        }
-    }
-    return new_value;
-}
-
-void to_lower(string& str) {
-    std::transform(str.cbegin(), str.cend(), str.begin(), [](unsigned char c) {
-        return std::tolower(c);
-    });
-}
-
-bool is_wildcard(char c) {
-    static constexpr char cWildcards[] = "?*";
-    for (size_t i = 0; i < strlen(cWildcards); ++i) {
-        if (cWildcards[i] == c) {
-            return true;
-        }
-    }
-    return false;
-}
-
-string clean_up_wildcard_search_string(string_view str) {
-    string cleaned_str;
-
-    bool is_escaped = false;
-    auto str_end = str.cend();
-    for (auto current = str.cbegin(); current != str_end;) {
-        auto c = *current;
-        if (is_escaped) {
-            is_escaped = false;
-
-            if (is_wildcard(c) || '\\' == c) {
-                // Keep escaping if c is a wildcard character or an escape
-                // character
-                cleaned_str += '\\';
-            }
-            cleaned_str += c;
-            ++current;
-        } else if ('*' == c) {
-            cleaned_str += c;
-
-            // Skip over all '*' to find the next non-'*'
-            do {
-                ++current;
-            } while (current != str_end && '*' == *current);
-        } else {
-            if ('\\' == c) {
-                is_escaped = true;
-            } else {
-                cleaned_str += c;
-            }
-            ++current;
-        }
-    }
-
-    return cleaned_str;
-}
-
-bool wildcard_match_unsafe(string_view tame, string_view wild, bool case_sensitive_match) {
-    if (case_sensitive_match) {
-        return wildcard_match_unsafe_case_sensitive(tame, wild);
-    } else {
-        // We convert to lowercase (rather than uppercase) anticipating that
-        // callers use lowercase more frequently, so little will need to change.
-        string lowercase_tame(tame);
-        to_lower(lowercase_tame);
-        string lowercase_wild(wild);
-        to_lower(lowercase_wild);
-        return wildcard_match_unsafe_case_sensitive(lowercase_tame, lowercase_wild);
-    }
-}
 
 /**
  * The algorithm basically works as follows:
@@ -193,7 +193,8 @@ bool wildcard_match_unsafe(string_view tame, string_view wild, bool case_sensiti
  * 3. checks if the two match. If not, the search repeats with the next group in
  *    tame.
  */
-bool wildcard_match_unsafe_case_sensitive(string_view tame, string_view wild) {
+template <bool case_sensitive>
+bool wildcard_match_unsafe_impl(string_view tame, string_view wild) {
     auto const tame_length = tame.length();
     auto const wild_length = wild.length();
     char const* tame_current = tame.data();
@@ -214,7 +215,6 @@ bool wildcard_match_unsafe_case_sensitive(string_view tame, string_view wild) {
 
     char w;
     char t;
-    bool is_escaped = false;
     while (true) {
         w = *wild_current;
         if ('*' == w) {
@@ -227,12 +227,18 @@ bool wildcard_match_unsafe_case_sensitive(string_view tame, string_view wild) {
             // Set wild and tame bookmarks
             wild_bookmark = wild_current;
             if (false
-                == advance_tame_to_next_match(tame_current, tame_bookmark, tame_end, wild_current))
+                == advance_tame_to_next_match<case_sensitive>(
+                        tame_current,
+                        tame_bookmark,
+                        tame_end,
+                        wild_current
+                ))
             {
                 return false;
             }
         } else {
             // Handle escaped characters
+            bool is_escaped = false;
             if ('\\' == w) {
                 is_escaped = true;
                 ++wild_current;
@@ -243,7 +249,7 @@ bool wildcard_match_unsafe_case_sensitive(string_view tame, string_view wild) {
 
             // Handle a mismatch
             t = *tame_current;
-            if (!((false == is_escaped && '?' == w) || t == w)) {
+            if (!((false == is_escaped && '?' == w) || chars_match<case_sensitive>(t, w))) {
                 if (nullptr == wild_bookmark) {
                     // No bookmark to return to
                     return false;
@@ -252,7 +258,7 @@ bool wildcard_match_unsafe_case_sensitive(string_view tame, string_view wild) {
                 wild_current = wild_bookmark;
                 tame_current = tame_bookmark + 1;
                 if (false
-                    == advance_tame_to_next_match(
+                    == advance_tame_to_next_match<case_sensitive>(
                             tame_current,
                             tame_bookmark,
                             tame_end,
@@ -280,7 +286,7 @@ bool wildcard_match_unsafe_case_sensitive(string_view tame, string_view wild) {
                     wild_current = wild_bookmark;
                     tame_current = tame_bookmark + 1;
                     if (false
-                        == advance_tame_to_next_match(
+                        == advance_tame_to_next_match<case_sensitive>(
                                 tame_current,
                                 tame_bookmark,
                                 tame_end,
@@ -294,4 +300,116 @@ bool wildcard_match_unsafe_case_sensitive(string_view tame, string_view wild) {
         }
     }
 }
+}  // namespace
+
+namespace clp::string_utils {
+size_t find_first_of(
+        string const& haystack,
+        char const* needles,
+        size_t search_start_pos,
+        size_t& needle_ix
+) {
+    size_t haystack_length = haystack.length();
+    size_t needles_length = strlen(needles);
+    for (size_t i = search_start_pos; i < haystack_length; ++i) {
+        for (needle_ix = 0; needle_ix < needles_length; ++needle_ix) {
+            if (haystack[i] == needles[needle_ix]) {
+                return i;
+            }
+        }
+    }
+
+    return string::npos;
+}
+
+string replace_characters(
+        char const* characters_to_replace,
+        char const* replacement_characters,
+        string const& value,
+        bool escape
+) {
+    string new_value;
+    size_t search_start_pos = 0;
+    while (true) {
+        size_t replace_char_ix;
+        size_t char_to_replace_pos
+                = find_first_of(value, characters_to_replace, search_start_pos, replace_char_ix);
+        if (string::npos == char_to_replace_pos) {
+            new_value.append(value, search_start_pos, string::npos);
+            break;
+        } else {
+            new_value.append(value, search_start_pos, char_to_replace_pos - search_start_pos);
+            if (escape) {
+                new_value += "\\";
+            }
+            new_value += replacement_characters[replace_char_ix];
+            search_start_pos = char_to_replace_pos + 1;
+        }
+    }
+    return new_value;
+}
+
+void to_lower(string& str) {
+    std::transform(str.cbegin(), str.cend(), str.begin(), [](unsigned char c) {
+        return std::tolower(c);
+    });
+}
+
+bool is_wildcard(char c) {
+    static constexpr char cWildcards[] = "?*";
+    for (size_t i = 0; i < strlen(cWildcards); ++i) {
+        if (cWildcards[i] == c) {
+            return true;
+        }
+    }
+    return false;
+}
+
+string clean_up_wildcard_search_string(string_view str) {
+    string cleaned_str;
+
+    bool is_escaped = false;
+    auto str_end = str.cend();
+    for (auto current = str.cbegin(); current != str_end;) {
+        auto c = *current;
+        if (is_escaped) {
+            is_escaped = false;
+
+            if (is_wildcard(c) || '\\' == c) {
+                // Keep escaping if c is a wildcard character or an escape
+                // character
+                cleaned_str += '\\';
+            }
+            cleaned_str += c;
+            ++current;
+        } else if ('*' == c) {
+            cleaned_str += c;
+
+            // Skip over all '*' to find the next non-'*'
+            do {
+                ++current;
+            } while (current != str_end && '*' == *current);
+        } else {
+            if ('\\' == c) {
+                is_escaped = true;
+            } else {
+                cleaned_str += c;
+            }
+            ++current;
+        }
+    }
+
+    return cleaned_str;
+}
+
+bool wildcard_match_unsafe(string_view tame, string_view wild, bool case_sensitive_match) {
+    if (case_sensitive_match) {
+        return wildcard_match_unsafe_impl<true>(tame, wild);
+    }
+    return wildcard_match_unsafe_impl<false>(tame, wild);
+}
+
+bool wildcard_match_unsafe_case_sensitive(string_view tame, string_view wild) {
+    return wildcard_match_unsafe_impl<true>(tame, wild);
+}
 }  // namespace clp::string_utils
@@ -0,0 +1,103 @@
+#include "ArchiveMetadataCache.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "DictionaryReader.hpp"
+
+namespace clp_s {
+namespace {
+/**
+ * @tparam DictionaryReaderType
+ * @param dict
+ * @return An estimate of the number of bytes used by the dictionary's entries
+ */
+template <typename DictionaryReaderType>
+auto get_dictionary_size_in_bytes(DictionaryReaderType const& dict) -> size_t;
+
+template <typename DictionaryReaderType>
+auto get_dictionary_size_in_bytes(DictionaryReaderType const& dict) -> size_t {
+    auto const& entries = dict.get_entries();
+    size_t size_in_bytes{entries.size() * sizeof(entries.front())};
+    for (auto const& entry : entries) {
+        size_in_bytes += entry.get_value().capacity();
+    }
+    return size_in_bytes;
+}
+}  // namespace
+
+auto ArchiveMetadata::get_size_in_bytes() const -> size_t {
+    size_t size_in_bytes{sizeof(ArchiveMetadata)};
+    for (auto const& node : schema_tree->get_nodes()) {
+        size_in_bytes += sizeof(node) + node.get_key_name().size()
+                         + node.get_children_ids().size() * sizeof(int32_t);
+    }
+    for (auto const& [schema_id, schema] : *schema_map) {
+        size_in_bytes += sizeof(schema_id) + sizeof(schema) + schema.size() * sizeof(int32_t);
+    }
+    size_in_bytes += get_dictionary_size_in_bytes(*var_dict);
+    size_in_bytes += get_dictionary_size_in_bytes(*log_dict);
+    size_in_bytes += get_dictionary_size_in_bytes(*array_dict);
+    size_in_bytes += stream_metadata.size() * sizeof(PackedStreamReader::PackedStreamMetadata);
+    size_in_bytes += schema_ids.size() * sizeof(int32_t);
+    size_in_bytes += id_to_schema_metadata.size()
+                     * (sizeof(int32_t) + sizeof(SchemaReader::SchemaMetadata));
+    if (nullptr != id_to_table_statistics) {
+        for (auto const& [schema_id, statistics] : *id_to_table_statistics) {
+            size_in_bytes += sizeof(schema_id) + statistics.get_size_in_bytes();
+        }
+    }
+    return size_in_bytes;
+}
+
+auto ArchiveMetadataCache::get(std::string_view archive_id)
+        -> std::shared_ptr<ArchiveMetadata const> {
+    auto const it = m_archive_id_to_entry.find(archive_id);
+    if (m_archive_id_to_entry.end() == it) {
+        ++m_num_misses;
+        return nullptr;
+    }
+    ++m_num_hits;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return it->second->metadata;
+}
+
+void ArchiveMetadataCache::put(
+        std::string_view archive_id,
+        std::shared_ptr<ArchiveMetadata const> metadata
+) {
+    if (auto const it = m_archive_id_to_entry.find(archive_id); m_archive_id_to_entry.end() != it)
+    {
+        m_memory_in_use -= it->second->size_in_bytes;
+        m_entries.erase(it->second);
+        m_archive_id_to_entry.erase(it);
+    }
+
+    auto const size_in_bytes = metadata->get_size_in_bytes();
+    if (size_in_bytes > m_memory_budget) {
+        return;
+    }
+    while (m_memory_in_use + size_in_bytes > m_memory_budget) {
+        evict_least_recently_used();
+    }
+
+    m_entries.emplace_front(Entry{
+            .archive_id = std::string{archive_id},
+            .metadata = std::move(metadata),
+            .size_in_bytes = size_in_bytes
+    });
+    m_archive_id_to_entry.emplace(m_entries.front().archive_id, m_entries.begin());
+    m_memory_in_use += size_in_bytes;
+}
+
+void ArchiveMetadataCache::evict_least_recently_used() {
+    auto const& entry = m_entries.back();
+    m_memory_in_use -= entry.size_in_bytes;
+    m_archive_id_to_entry.erase(entry.archive_id);
+    m_entries.pop_back();
+}
+}  // namespace clp_s
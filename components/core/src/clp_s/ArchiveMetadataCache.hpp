@@ -0,0 +1,116 @@
+#ifndef CLP_S_ARCHIVEMETADATACACHE_HPP
+#define CLP_S_ARCHIVEMETADATACACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "DictionaryReader.hpp"
+#include "PackedStreamReader.hpp"
+#include "ReaderUtils.hpp"
+#include "SchemaReader.hpp"
+#include "SchemaTree.hpp"
+#include "TableStatistics.hpp"
+
+namespace clp_s {
+/**
+ * The decoded metadata and dictionaries of an archive, i.e., everything an ArchiveReader reads
+ * before it reads the archive's packed streams.
+ *
+ * The dictionaries are fully decoded and remain open, so they can be shared by any number of
+ * ArchiveReaders (one at a time) without being re-read.
+ */
+struct ArchiveMetadata {
+    std::shared_ptr<SchemaTree> schema_tree;
+    std::shared_ptr<ReaderUtils::SchemaMap> schema_map;
+    std::shared_ptr<VariableDictionaryReader> var_dict;
+    std::shared_ptr<LogTypeDictionaryReader> log_dict;
+    std::shared_ptr<LogTypeDictionaryReader> array_dict;
+    std::vector<PackedStreamReader::PackedStreamMetadata> stream_metadata;
+    std::vector<int32_t> schema_ids;
+    std::map<int32_t, SchemaReader::SchemaMetadata> id_to_schema_metadata;
+    // nullptr if the archive has no table statistics
+    std::shared_ptr<std::map<int32_t, TableStatistics> const> id_to_table_statistics;
+
+    /**
+     * @return An estimate of the number of bytes used by the metadata in memory. Indexes that the
+     * dictionaries build on demand aren't counted.
+     */
+    [[nodiscard]] auto get_size_in_bytes() const -> size_t;
+};
+
+/**
+ * A least-recently-used cache of decoded archive metadata, keyed by archive ID and bounded by a
+ * memory budget. It allows a long-running process that searches the same archives repeatedly to
+ * skip reading and decoding their metadata and dictionaries after the first search.
+ *
+ * This class isn't thread-safe.
+ */
+class ArchiveMetadataCache {
+public:
+    // Constructors
+    /**
+     * @param memory_budget The maximum number of bytes of metadata to keep cached
+     */
+    explicit ArchiveMetadataCache(size_t memory_budget) : m_memory_budget{memory_budget} {}
+
+    // Methods
+    /**
+     * Gets the cached metadata of an archive and marks it as the most recently used.
+     * @param archive_id
+     * @return The metadata, or nullptr if the archive's metadata isn't cached
+     */
+    [[nodiscard]] auto get(std::string_view archive_id) -> std::shared_ptr<ArchiveMetadata const>;
+
+    /**
+     * Caches the metadata of an archive as the most recently used, evicting the least recently
+     * used metadata until the cache fits in its memory budget. Metadata that's larger than the
+     * budget on its own isn't cached.
+     * @param archive_id
+     * @param metadata
+     */
+    void put(std::string_view archive_id, std::shared_ptr<ArchiveMetadata const> metadata);
+
+    [[nodiscard]] auto get_memory_in_use() const -> size_t { return m_memory_in_use; }
+
+    [[nodiscard]] auto get_num_cached_archives() const -> size_t { return m_entries.size(); }
+
+    [[nodiscard]] auto get_num_hits() const -> size_t { return m_num_hits; }
+
+    [[nodiscard]] auto get_num_misses() const -> size_t { return m_num_misses; }
+
+private:
+    // Types
+    struct Entry {
+        std::string archive_id;
+        std::shared_ptr<ArchiveMetadata const> metadata;
+        size_t size_in_bytes{};
+    };
+
+    // Methods
+    /**
+     * Evicts the least recently used entry.
+     */
+    void evict_least_recently_used();
+
+    // Variables
+    size_t m_memory_budget;
+    size_t m_memory_in_use{0};
+    size_t m_num_hits{0};
+    size_t m_num_misses{0};
+
+    // Ordered from the most to the least recently used
+    std::list<Entry> m_entries;
+    absl::flat_hash_map<std::string, std::list<Entry>::iterator> m_archive_id_to_entry;
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_ARCHIVEMETADATACACHE_HPP
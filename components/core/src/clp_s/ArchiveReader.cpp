@@ -1,12 +1,24 @@
 #include "ArchiveReader.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
 #include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
 
 #include "archive_constants.hpp"
+#include "ArchiveMetadataCache.hpp"
 #include "ArchiveReaderAdaptor.hpp"
 #include "InputConfig.hpp"
 #include "ReaderUtils.hpp"
+#include "TableStatistics.hpp"
 
 using std::string_view;
 
@@ -27,6 +39,13 @@ void ArchiveReader::open(Path const& archive_path, NetworkAuthOption const& netw
         throw OperationFailed(rc, __FILENAME__, __LINE__);
     }
 
+    if (nullptr != m_metadata_cache) {
+        if (auto const metadata = m_metadata_cache->get(m_archive_id); nullptr != metadata) {
+            load_cached_metadata(*metadata);
+            return;
+        }
+    }
+
     m_schema_tree = ReaderUtils::read_schema_tree(*m_archive_reader_adaptor);
     m_schema_map = ReaderUtils::read_schemas(*m_archive_reader_adaptor);
 
@@ -35,9 +54,53 @@ void ArchiveReader::open(Path const& archive_path, NetworkAuthOption const& netw
     m_var_dict = ReaderUtils::get_variable_dictionary_reader(*m_archive_reader_adaptor);
     m_log_dict = ReaderUtils::get_log_type_dictionary_reader(*m_archive_reader_adaptor);
     m_array_dict = ReaderUtils::get_array_dictionary_reader(*m_archive_reader_adaptor);
+
+    if (nullptr != m_metadata_cache) {
+        read_and_cache_metadata();
+    }
+}
+
+void ArchiveReader::read_and_cache_metadata() {
+    read_dictionaries_and_metadata();
+    m_is_metadata_preloaded = true;
+
+    // The cached dictionaries outlive this reader's adaptor, and they've been read in full
+    m_var_dict->release_adaptor();
+    m_log_dict->release_adaptor();
+    m_array_dict->release_adaptor();
+
+    auto metadata = std::make_shared<ArchiveMetadata>();
+    metadata->schema_tree = m_schema_tree;
+    metadata->schema_map = m_schema_map;
+    metadata->var_dict = m_var_dict;
+    metadata->log_dict = m_log_dict;
+    metadata->array_dict = m_array_dict;
+    metadata->stream_metadata = m_stream_reader.get_metadata();
+    metadata->schema_ids = m_schema_ids;
+    metadata->id_to_schema_metadata = m_id_to_schema_metadata;
+    metadata->id_to_table_statistics = m_id_to_table_statistics;
+    m_metadata_cache->put(m_archive_id, std::move(metadata));
+}
+
+void ArchiveReader::load_cached_metadata(ArchiveMetadata const& metadata) {
+    m_schema_tree = metadata.schema_tree;
+    m_schema_map = metadata.schema_map;
+    m_log_event_idx_column_id = m_schema_tree->get_metadata_field_id(constants::cLogEventIdxName);
+    m_var_dict = metadata.var_dict;
+    m_log_dict = metadata.log_dict;
+    m_array_dict = metadata.array_dict;
+    m_stream_reader.load_metadata(metadata.stream_metadata);
+    m_schema_ids = metadata.schema_ids;
+    m_id_to_schema_metadata = metadata.id_to_schema_metadata;
+    m_id_to_table_statistics = metadata.id_to_table_statistics;
+    m_is_metadata_preloaded = true;
 }
 
 void ArchiveReader::read_metadata() {
+    if (m_is_metadata_preloaded) {
+        return;
+    }
+
     constexpr size_t cDecompressorFileReadBufferCapacity = 64 * 1024;  // 64 KB
     auto table_metadata_reader = m_archive_reader_adaptor->checkout_reader_for_section(
             constants::cArchiveTableMetadataFile
@@ -124,12 +187,17 @@ void ArchiveReader::read_metadata() {
             = m_stream_reader.get_uncompressed_stream_size(prev_metadata.stream_id)
               - prev_metadata.stream_offset;
     m_id_to_schema_metadata[prev_schema_id] = prev_metadata;
+
+    read_table_statistics();
     m_table_metadata_decompressor.close();
 
     m_archive_reader_adaptor->checkin_reader_for_section(constants::cArchiveTableMetadataFile);
 }
 
 void ArchiveReader::read_dictionaries_and_metadata() {
+    if (m_is_metadata_preloaded) {
+        return;
+    }
     read_metadata();
     m_var_dict->read_entries();
     m_log_dict->read_entries();
@@ -181,6 +249,109 @@ std::vector<std::shared_ptr<SchemaReader>> ArchiveReader::read_all_tables() {
     return readers;
 }
 
+std::optional<TableStatistics::IntegerRange>
+ArchiveReader::get_log_event_idx_range(int32_t schema_id) const {
+    auto const* table_statistics = get_table_statistics(schema_id);
+    if (m_log_event_idx_column_id < 0 || nullptr == table_statistics) {
+        return std::nullopt;
+    }
+    auto const* column_statistics
+            = table_statistics->get_column_statistics(m_log_event_idx_column_id);
+    if (nullptr == column_statistics) {
+        return std::nullopt;
+    }
+    auto const* range = std::get_if<TableStatistics::IntegerRange>(column_statistics);
+    if (nullptr == range) {
+        return std::nullopt;
+    }
+    return *range;
+}
+
+std::optional<TableStatistics::IntegerRange> ArchiveReader::get_timestamp_range(int32_t schema_id) {
+    auto const timestamp_dict = get_timestamp_dictionary();
+    auto const& timestamp_column_ids = timestamp_dict->get_authoritative_timestamp_column_ids();
+    auto const* table_statistics = get_table_statistics(schema_id);
+
+    // Only ordered columns are marked as the timestamp when a table is read
+    auto const& schema = m_schema_map->at(schema_id);
+    std::optional<TableStatistics::IntegerRange> timestamp_range;
+    for (size_t i = 0; i < schema.get_num_ordered(); ++i) {
+        int32_t const column_id = schema[i];
+        if (Schema::schema_entry_is_unordered_object(column_id)) {
+            i += Schema::get_unordered_object_length(column_id);
+            continue;
+        }
+        if (0 == timestamp_column_ids.count(column_id)) {
+            continue;
+        }
+
+        std::optional<TableStatistics::IntegerRange> column_range;
+        auto const* column_statistics
+                = nullptr == table_statistics
+                          ? nullptr
+                          : table_statistics->get_column_statistics(column_id);
+        if (nullptr == column_statistics) {
+            // Fall back to the range of every value in the column across the archive
+            for (auto it = timestamp_dict->tokenized_column_to_range_begin();
+                 timestamp_dict->tokenized_column_to_range_end() != it;
+                 ++it)
+            {
+                auto const* entry = it->second;
+                if (entry->get_column_ids().count(column_id) > 0) {
+                    column_range = {entry->get_begin_timestamp(), entry->get_end_timestamp()};
+                    break;
+                }
+            }
+        } else if (auto const* range
+                   = std::get_if<TableStatistics::IntegerRange>(column_statistics))
+        {
+            column_range = *range;
+        } else if (auto const* range = std::get_if<TableStatistics::FloatRange>(column_statistics))
+        {
+            // Float timestamps are truncated when they're read
+            column_range = {
+                    static_cast<epochtime_t>(std::floor(range->min)),
+                    static_cast<epochtime_t>(std::ceil(range->max))
+            };
+        }
+        if (false == column_range.has_value()) {
+            return std::nullopt;
+        }
+
+        if (timestamp_range.has_value()) {
+            timestamp_range->min = std::min(timestamp_range->min, column_range->min);
+            timestamp_range->max = std::max(timestamp_range->max, column_range->max);
+        } else {
+            timestamp_range = column_range;
+        }
+    }
+
+    if (false == timestamp_range.has_value()) {
+        return TableStatistics::IntegerRange{0, 0};
+    }
+    return timestamp_range;
+}
+
+std::shared_ptr<char[]>
+ArchiveReader::decompress_stream(size_t stream_id, std::vector<char> const& compressed_buf) const {
+    std::shared_ptr<char[]> stream_buffer;
+    size_t stream_buffer_size{0ULL};
+    m_stream_reader.decompress_stream(stream_id, compressed_buf, stream_buffer, stream_buffer_size);
+    return stream_buffer;
+}
+
+void ArchiveReader::load_schema_table(
+        SchemaReader& reader,
+        int32_t schema_id,
+        std::shared_ptr<char[]> const& stream_buffer,
+        bool should_extract_timestamp,
+        bool should_marshal_records
+) {
+    auto const& schema_metadata = get_schema_metadata(schema_id);
+    initialize_schema_reader(reader, schema_id, should_extract_timestamp, should_marshal_records);
+    reader.load(stream_buffer, schema_metadata.stream_offset, schema_metadata.uncompressed_size);
+}
+
 BaseColumnReader* ArchiveReader::append_reader_column(SchemaReader& reader, int32_t column_id) {
     BaseColumnReader* column_reader = nullptr;
     auto const& node = m_schema_tree->get_node(column_id);
@@ -279,13 +450,15 @@ void ArchiveReader::initialize_schema_reader(
         bool should_extract_timestamp,
         bool should_marshal_records
 ) {
-    auto& schema = (*m_schema_map)[schema_id];
+    // NOTE: We use `at` rather than `operator[]` so that readers for different tables can be
+    // initialized concurrently.
+    auto& schema = m_schema_map->at(schema_id);
     reader.reset(
             m_schema_tree,
             m_projection,
             schema_id,
             schema.get_ordered_schema_view(),
-            m_id_to_schema_metadata[schema_id].num_messages,
+            m_id_to_schema_metadata.at(schema_id).num_messages,
             should_marshal_records
     );
     auto timestamp_column_ids
@@ -347,25 +520,95 @@ void ArchiveReader::store(FileWriter& writer) {
     }
 }
 
+std::vector<std::pair<int64_t, std::string>>
+ArchiveReader::read_log_event_range(int64_t begin_log_event_idx, int64_t end_log_event_idx) {
+    if (false == has_log_order()) {
+        throw OperationFailed(ErrorCodeUnsupported, __FILENAME__, __LINE__);
+    }
+
+    std::vector<std::pair<int64_t, std::string>> records;
+    std::string message;
+    for (auto schema_id : m_schema_ids) {
+        if (auto const range = get_log_event_idx_range(schema_id);
+            range.has_value()
+            && (range->max < begin_log_event_idx || range->min >= end_log_event_idx))
+        {
+            continue;
+        }
+
+        auto& schema_reader = read_schema_table(schema_id, false, true);
+        schema_reader.skip_to_log_event_idx(begin_log_event_idx);
+        while (false == schema_reader.done()) {
+            auto const log_event_idx = schema_reader.get_next_log_event_idx();
+            if (log_event_idx >= end_log_event_idx) {
+                break;
+            }
+            schema_reader.get_next_message(message);
+            records.emplace_back(log_event_idx, message);
+        }
+    }
+
+    std::sort(records.begin(), records.end(), [](auto const& lhs, auto const& rhs) {
+        return lhs.first < rhs.first;
+    });
+    return records;
+}
+
+void ArchiveReader::read_table_statistics() {
+    // Archives written before table statistics were introduced end after the schema tables
+    uint64_t num_tables{};
+    if (auto const error = m_table_metadata_decompressor.try_read_numeric_value(num_tables);
+        ErrorCodeEndOfFile == error)
+    {
+        return;
+    } else if (ErrorCodeSuccess != error) {
+        throw OperationFailed(error, __FILENAME__, __LINE__);
+    }
+
+    auto id_to_table_statistics = std::make_shared<std::map<int32_t, TableStatistics>>();
+    for (uint64_t i = 0; i < num_tables; ++i) {
+        int32_t schema_id{};
+        if (auto const error = m_table_metadata_decompressor.try_read_numeric_value(schema_id);
+            ErrorCodeSuccess != error)
+        {
+            throw OperationFailed(error, __FILENAME__, __LINE__);
+        }
+
+        TableStatistics statistics;
+        if (auto const error = statistics.try_read(m_table_metadata_decompressor);
+            ErrorCodeSuccess != error)
+        {
+            throw OperationFailed(error, __FILENAME__, __LINE__);
+        }
+        id_to_table_statistics->insert_or_assign(schema_id, std::move(statistics));
+    }
+    m_id_to_table_statistics = std::move(id_to_table_statistics);
+}
+
 void ArchiveReader::close() {
     if (false == m_is_open) {
         throw OperationFailed(ErrorCodeNotInit, __FILENAME__, __LINE__);
     }
     m_is_open = false;
 
-    m_var_dict->close();
-    m_log_dict->close();
-    m_array_dict->close();
+    // Preloaded dictionaries may be shared through the metadata cache, so they're left open
+    if (false == m_is_metadata_preloaded) {
+        m_var_dict->close();
+        m_log_dict->close();
+        m_array_dict->close();
+    }
 
     m_stream_reader.close();
     m_archive_reader_adaptor.reset();
 
     m_id_to_schema_metadata.clear();
+    m_id_to_table_statistics.reset();
     m_schema_ids.clear();
     m_cur_stream_id = 0;
     m_stream_buffer.reset();
     m_stream_buffer_size = 0ULL;
     m_log_event_idx_column_id = -1;
+    m_is_metadata_preloaded = false;
 }
 
 std::shared_ptr<char[]> ArchiveReader::read_stream(size_t stream_id, bool reuse_buffer) {
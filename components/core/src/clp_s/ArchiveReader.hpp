@@ -2,11 +2,16 @@
 #define CLP_S_ARCHIVEREADER_HPP
 
 #include <map>
+#include <memory>
+#include <optional>
 #include <set>
 #include <span>
+#include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
+#include "ArchiveMetadataCache.hpp"
 #include "ArchiveReaderAdaptor.hpp"
 #include "DictionaryReader.hpp"
 #include "InputConfig.hpp"
@@ -14,6 +19,7 @@
 #include "ReaderUtils.hpp"
 #include "SchemaReader.hpp"
 #include "search/Projection.hpp"
+#include "TableStatistics.hpp"
 #include "TimestampDictionaryReader.hpp"
 #include "Utils.hpp"
 
@@ -31,12 +37,23 @@ public:
     ArchiveReader() : m_is_open(false) {}
 
     /**
-     * Opens an archive for reading.
+     * Opens an archive for reading. If a metadata cache is set, the archive's metadata and
+     * dictionaries are taken from the cache when it has them, and are otherwise read in full and
+     * added to the cache. Either way, they don't need to be read again after opening the archive.
      * @param archive_path
      * @param network_auth
      */
     void open(Path const& archive_path, NetworkAuthOption const& network_auth);
 
+    /**
+     * Sets the cache used to share decoded metadata and dictionaries between the archives opened
+     * by this reader and other readers using the same cache.
+     * @param metadata_cache
+     */
+    void set_metadata_cache(std::shared_ptr<ArchiveMetadataCache> metadata_cache) {
+        m_metadata_cache = std::move(metadata_cache);
+    }
+
     /**
      * Reads the dictionaries and metadata.
      */
@@ -47,13 +64,25 @@ public:
      */
     void open_packed_streams();
 
+    /**
+     * Plans which packed streams are going to be read, so that only those streams are downloaded
+     * if the archive is remote. Must be invoked after opening the packed streams and before reading
+     * any.
+     * @param stream_ids The IDs of the streams to read
+     */
+    void plan_stream_reads(std::vector<size_t> const& stream_ids) {
+        m_stream_reader.plan_stream_reads(stream_ids);
+    }
+
     /**
      * Reads the variable dictionary from the archive.
      * @param lazy
      * @return the variable dictionary reader
      */
     std::shared_ptr<VariableDictionaryReader> read_variable_dictionary(bool lazy = false) {
-        m_var_dict->read_entries(lazy);
+        if (false == m_is_metadata_preloaded) {
+            m_var_dict->read_entries(lazy);
+        }
         return m_var_dict;
     }
 
@@ -63,7 +92,9 @@ public:
      * @return the log type dictionary reader
      */
     std::shared_ptr<LogTypeDictionaryReader> read_log_type_dictionary(bool lazy = false) {
-        m_log_dict->read_entries(lazy);
+        if (false == m_is_metadata_preloaded) {
+            m_log_dict->read_entries(lazy);
+        }
         return m_log_dict;
     }
 
@@ -73,7 +104,9 @@ public:
      * @return the array dictionary reader
      */
     std::shared_ptr<LogTypeDictionaryReader> read_array_dictionary(bool lazy = false) {
-        m_array_dict->read_entries(lazy);
+        if (false == m_is_metadata_preloaded) {
+            m_array_dict->read_entries(lazy);
+        }
         return m_array_dict;
     }
 
@@ -95,6 +128,90 @@ public:
             bool should_marshal_records
     );
 
+    /**
+     * @param schema_id
+     * @return the metadata describing where the table with the given ID is stored
+     */
+    SchemaReader::SchemaMetadata const& get_schema_metadata(int32_t schema_id) const {
+        return m_id_to_schema_metadata.at(schema_id);
+    }
+
+    /**
+     * @param schema_id
+     * @return the statistics recorded for the table with the given ID, or nullptr if the archive
+     * has none
+     */
+    TableStatistics const* get_table_statistics(int32_t schema_id) const {
+        if (nullptr == m_id_to_table_statistics) {
+            return nullptr;
+        }
+        auto const it = m_id_to_table_statistics->find(schema_id);
+        return m_id_to_table_statistics->end() == it ? nullptr : &it->second;
+    }
+
+    /**
+     * @param schema_id
+     * @return the range of log event indices in the table with the given ID, or std::nullopt if the
+     * archive doesn't record it
+     */
+    std::optional<TableStatistics::IntegerRange> get_log_event_idx_range(int32_t schema_id) const;
+
+    /**
+     * Gets a range containing the timestamps that searches report for the records in the table with
+     * the given ID. Records in tables without a timestamp column are reported with timestamp 0.
+     * Columns without table statistics fall back to their range in the timestamp dictionary.
+     * @param schema_id
+     * @return the range, or std::nullopt if it's unknown
+     */
+    std::optional<TableStatistics::IntegerRange> get_timestamp_range(int32_t schema_id);
+
+    /**
+     * @param stream_id
+     * @return the size of the packed stream with the given ID once decompressed
+     */
+    size_t get_uncompressed_stream_size(size_t stream_id) const {
+        return m_stream_reader.get_uncompressed_stream_size(stream_id);
+    }
+
+    /**
+     * Reads the compressed bytes of a packed stream without decompressing them. Streams must be
+     * requested in ascending order. The stream can then be decompressed with `decompress_stream`
+     * on any thread.
+     * @param stream_id
+     * @param compressed_buf Returns the compressed stream
+     */
+    void read_compressed_stream(size_t stream_id, std::vector<char>& compressed_buf) {
+        m_stream_reader.read_compressed_stream(stream_id, compressed_buf);
+    }
+
+    /**
+     * Decompresses a packed stream previously read with `read_compressed_stream` into a newly
+     * allocated buffer. This method is thread-safe.
+     * @param stream_id
+     * @param compressed_buf
+     * @return a buffer containing the decompressed stream
+     */
+    std::shared_ptr<char[]>
+    decompress_stream(size_t stream_id, std::vector<char> const& compressed_buf) const;
+
+    /**
+     * Initializes a schema reader for a table and loads the table from an already decompressed
+     * packed stream. This method doesn't modify the ArchiveReader, so it can be called concurrently
+     * from multiple threads as long as each thread uses its own SchemaReader.
+     * @param reader
+     * @param schema_id
+     * @param stream_buffer the decompressed packed stream containing the table
+     * @param should_extract_timestamp
+     * @param should_marshal_records
+     */
+    void load_schema_table(
+            SchemaReader& reader,
+            int32_t schema_id,
+            std::shared_ptr<char[]> const& stream_buffer,
+            bool should_extract_timestamp,
+            bool should_marshal_records
+    );
+
     /**
      * Loads all of the tables in the archive and returns SchemaReaders for them.
      * @return the schema readers for every table in the archive
@@ -127,6 +244,23 @@ public:
      */
     void store(FileWriter& writer);
 
+    /**
+     * Reads the records whose log event indices are in [begin_log_event_idx, end_log_event_idx),
+     * in log order. Only the tables whose recorded log event index range overlaps the requested
+     * range are decompressed, and the requested rows of each table are found with a binary search,
+     * so only the requested records are marshalled. Tables of archives without table statistics
+     * are searched in full.
+     *
+     * Like the other methods that read tables, this method reads packed streams in order, so it
+     * can only be called once after opening the packed streams.
+     * @param begin_log_event_idx
+     * @param end_log_event_idx
+     * @return the records along with their log event indices
+     * @throw ArchiveReader::OperationFailed if the archive has no log order
+     */
+    std::vector<std::pair<int64_t, std::string>>
+    read_log_event_range(int64_t begin_log_event_idx, int64_t end_log_event_idx);
+
     /**
      * Closes the archive.
      */
@@ -148,6 +282,24 @@ public:
     bool has_log_order() { return m_log_event_idx_column_id >= 0; }
 
 private:
+    /**
+     * Reads the metadata and all dictionaries of the open archive in full and adds them to the
+     * metadata cache.
+     */
+    void read_and_cache_metadata();
+
+    /**
+     * Loads the metadata and dictionaries of the open archive from the metadata cache.
+     * @param metadata
+     */
+    void load_cached_metadata(ArchiveMetadata const& metadata);
+
+    /**
+     * Reads the per-table statistics that follow the schema table metadata, if the archive has
+     * them.
+     */
+    void read_table_statistics();
+
     /**
      * Initializes a schema reader passed by reference to become a reader for a given schema.
      * @param reader
@@ -208,6 +360,7 @@ private:
     std::shared_ptr<ReaderUtils::SchemaMap> m_schema_map;
     std::vector<int32_t> m_schema_ids;
     std::map<int32_t, SchemaReader::SchemaMetadata> m_id_to_schema_metadata;
+    std::shared_ptr<std::map<int32_t, TableStatistics> const> m_id_to_table_statistics;
     std::shared_ptr<search::Projection> m_projection{
             std::make_shared<search::Projection>(search::ProjectionMode::ReturnAllColumns)
     };
@@ -219,6 +372,10 @@ private:
     size_t m_stream_buffer_size{0ULL};
     size_t m_cur_stream_id{0ULL};
     int32_t m_log_event_idx_column_id{-1};
+
+    std::shared_ptr<ArchiveMetadataCache> m_metadata_cache;
+    // Whether the metadata and dictionaries were read in full when the archive was opened
+    bool m_is_metadata_preloaded{false};
 };
 }  // namespace clp_s
 
@@ -1,5 +1,6 @@
 #include "ArchiveReaderAdaptor.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <filesystem>
 #include <memory>
@@ -16,6 +17,7 @@
 #include "../clp/BoundedReader.hpp"
 #include "../clp/FileReader.hpp"
 #include "archive_constants.hpp"
+#include "ByteRangeReader.hpp"
 #include "InputConfig.hpp"
 #include "RangeIndexWriter.hpp"
 #include "ReaderUtils.hpp"
@@ -161,24 +163,81 @@ ArchiveReaderAdaptor::try_read_unknown_metadata_packet(ZstdDecompressor& decompr
 
 ErrorCode ArchiveReaderAdaptor::load_archive_metadata() {
     constexpr size_t cDecompressorFileReadBufferCapacity = 64 * 1024;
-    m_reader = try_create_reader_at_header();
-    if (nullptr == m_reader) {
-        return ErrorCodeFileNotFound;
-    }
+    if (InputSource::Network == m_archive_path.source) {
+        if (auto const rc = try_open_remote_archive(); ErrorCodeSuccess != rc) {
+            return rc;
+        }
+    } else {
+        m_reader = try_create_reader_at_header();
+        if (nullptr == m_reader) {
+            return ErrorCodeFileNotFound;
+        }
 
-    if (auto const rc = try_read_header(*m_reader); ErrorCodeSuccess != rc) {
-        return rc;
+        if (auto const rc = try_read_header(*m_reader); ErrorCodeSuccess != rc) {
+            return rc;
+        }
+        m_files_section_offset = sizeof(m_archive_header) + m_archive_header.metadata_section_size;
     }
 
-    m_files_section_offset = sizeof(m_archive_header) + m_archive_header.metadata_section_size;
     clp::BoundedReader bounded_reader{m_reader.get(), m_files_section_offset};
     ZstdDecompressor decompressor;
     decompressor.open(bounded_reader, cDecompressorFileReadBufferCapacity);
     auto const rc = try_read_archive_metadata(decompressor);
     decompressor.close();
+    if (ErrorCodeSuccess == rc && nullptr != m_range_reader) {
+        plan_remote_metadata_section_reads();
+    }
     return rc;
 }
 
+ErrorCode ArchiveReaderAdaptor::try_open_remote_archive() {
+    auto header_reader = ReaderUtils::try_create_network_range_reader(
+            m_archive_path,
+            m_network_auth,
+            ByteRange{0, sizeof(m_archive_header)}
+    );
+    if (nullptr == header_reader) {
+        return ErrorCodeFileNotFound;
+    }
+    if (auto const rc = try_read_header(*header_reader); ErrorCodeSuccess != rc) {
+        return rc;
+    }
+    header_reader.reset();
+    m_files_section_offset = sizeof(m_archive_header) + m_archive_header.metadata_section_size;
+
+    auto create_range_reader
+            = [archive_path = m_archive_path, network_auth = m_network_auth](ByteRange range) {
+                  return ReaderUtils::try_create_network_range_reader(
+                          archive_path,
+                          network_auth,
+                          range
+                  );
+              };
+    m_range_reader = std::make_shared<ByteRangeReader>(
+            std::move(create_range_reader),
+            m_archive_header.compressed_size,
+            cMaxCoalescedRangeGap
+    );
+    m_range_reader->plan_reads({ByteRange{sizeof(m_archive_header), m_files_section_offset}});
+    if (auto const rc = m_range_reader->try_seek_from_begin(sizeof(m_archive_header));
+        clp::ErrorCode::ErrorCode_Success != rc)
+    {
+        return ErrorCodeCorrupt;
+    }
+    m_reader = m_range_reader;
+    return ErrorCodeSuccess;
+}
+
+void ArchiveReaderAdaptor::plan_remote_metadata_section_reads() {
+    std::vector<ByteRange> ranges;
+    for (auto const& file_info : m_archive_file_info.files) {
+        if (constants::cArchiveTablesFile != file_info.n) {
+            ranges.emplace_back(get_sfa_section_range(file_info.n));
+        }
+    }
+    m_range_reader->plan_reads(std::move(ranges));
+}
+
 ErrorCode ArchiveReaderAdaptor::try_read_header(clp::ReaderInterface& reader) {
     auto const clp_rc = reader.try_read_exact_length(
             reinterpret_cast<char*>(&m_archive_header),
@@ -283,27 +342,13 @@ std::unique_ptr<clp::ReaderInterface> ArchiveReaderAdaptor::checkout_reader_for_
 std::unique_ptr<clp::ReaderInterface> ArchiveReaderAdaptor::checkout_reader_for_sfa_section(
         std::string_view section
 ) {
-    auto it = std::find_if(
-            m_archive_file_info.files.begin(),
-            m_archive_file_info.files.end(),
-            [&](ArchiveFileInfo& info) { return info.n == section; }
-    );
-    if (m_archive_file_info.files.end() == it) {
-        throw OperationFailed(ErrorCodeBadParam, __FILENAME__, __LINE__);
-    }
+    auto const [file_offset, next_file_offset] = get_sfa_section_range(section);
 
     size_t curr_pos{};
     if (auto rc = m_reader->try_get_pos(curr_pos); clp::ErrorCode::ErrorCode_Success != rc) {
         throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
     }
 
-    size_t file_offset = m_files_section_offset + it->o;
-    ++it;
-    size_t next_file_offset{m_archive_header.compressed_size};
-    if (m_archive_file_info.files.end() != it) {
-        next_file_offset = m_files_section_offset + it->o;
-    }
-
     if (curr_pos > file_offset) {
         throw OperationFailed(ErrorCodeCorrupt, __FILENAME__, __LINE__);
     }
@@ -319,6 +364,25 @@ std::unique_ptr<clp::ReaderInterface> ArchiveReaderAdaptor::checkout_reader_for_
     return std::make_unique<clp::BoundedReader>(m_reader.get(), next_file_offset);
 }
 
+ByteRange ArchiveReaderAdaptor::get_sfa_section_range(std::string_view section) const {
+    auto it = std::find_if(
+            m_archive_file_info.files.begin(),
+            m_archive_file_info.files.end(),
+            [&](ArchiveFileInfo const& info) { return info.n == section; }
+    );
+    if (m_archive_file_info.files.end() == it) {
+        throw OperationFailed(ErrorCodeBadParam, __FILENAME__, __LINE__);
+    }
+
+    size_t file_offset = m_files_section_offset + it->o;
+    ++it;
+    size_t next_file_offset{m_archive_header.compressed_size};
+    if (m_archive_file_info.files.end() != it) {
+        next_file_offset = m_files_section_offset + it->o;
+    }
+    return ByteRange{file_offset, next_file_offset};
+}
+
 void ArchiveReaderAdaptor::checkin_reader_for_section(std::string_view section) {
     if (false == m_current_reader_holder.has_value()) {
         throw OperationFailed(ErrorCodeNotInit, __FILENAME__, __LINE__);
@@ -330,4 +394,28 @@ void ArchiveReaderAdaptor::checkin_reader_for_section(std::string_view section)
 
     m_current_reader_holder.reset();
 }
+
+void ArchiveReaderAdaptor::plan_section_reads(
+        std::string_view section,
+        std::vector<ByteRange> ranges
+) {
+    if (false == m_current_reader_holder.has_value()
+        || m_current_reader_holder.value() != section)
+    {
+        throw OperationFailed(ErrorCodeBadParam, __FILENAME__, __LINE__);
+    }
+
+    if (nullptr == m_range_reader) {
+        return;
+    }
+    auto const section_range = get_sfa_section_range(section);
+    for (auto& range : ranges) {
+        range.begin_offset += section_range.begin_offset;
+        range.end_offset = std::min(
+                range.end_offset + section_range.begin_offset,
+                section_range.end_offset
+        );
+    }
+    m_range_reader->plan_reads(std::move(ranges));
+}
 }  // namespace clp_s
@@ -18,6 +18,7 @@
 
 #include "../clp/BoundedReader.hpp"
 #include "../clp/ReaderInterface.hpp"
+#include "ByteRangeReader.hpp"
 #include "InputConfig.hpp"
 #include "SingleFileArchiveDefs.hpp"
 #include "TimestampDictionaryReader.hpp"
@@ -43,6 +44,10 @@ struct RangeIndexEntry {
 /**
  * ArchiveReaderAdaptor is an adaptor class which helps with reading single and multi-file archives
  * which exist on either S3 or a locally mounted file system.
+ *
+ * Single file archives on S3 are read with range requests, so that only the header, the metadata,
+ * the sections that are checked out, and the ranges of sections planned with `plan_section_reads`
+ * are downloaded.
  */
 class ArchiveReaderAdaptor {
 public:
@@ -53,6 +58,9 @@ public:
                 : TraceableException(error_code, filename, line_number) {}
     };
 
+    // Ranges of a remote archive that are at most this far apart are downloaded with one request
+    static constexpr size_t cMaxCoalescedRangeGap{1024 * 1024};  // 1 MiB
+
     explicit ArchiveReaderAdaptor(Path const& archive_path, NetworkAuthOption const& network_auth);
 
     /**
@@ -81,6 +89,16 @@ public:
      */
     void checkin_reader_for_section(std::string_view section);
 
+    /**
+     * Plans which byte ranges of the section that's currently checked out are going to be read, so
+     * that only those ranges are downloaded if the archive is remote. Ranges that are close
+     * together are downloaded with a single request. Has no effect on local archives.
+     * @param section
+     * @param ranges The ranges to read, relative to the beginning of the section
+     * @throw OperationFailed if the given section isn't the section currently checked out.
+     */
+    void plan_section_reads(std::string_view section, std::vector<ByteRange> ranges);
+
     std::shared_ptr<TimestampDictionaryReader> get_timestamp_dictionary() {
         return m_timestamp_dictionary;
     }
@@ -140,6 +158,27 @@ private:
      */
     std::shared_ptr<clp::ReaderInterface> try_create_reader_at_header();
 
+    /**
+     * Tries to read the header of a remote archive and to create a reader that downloads the rest
+     * of the archive in byte ranges, planning to read the metadata section.
+     * @return ErrorCodeSuccess on success.
+     * @return relevant ErrorCode on failure.
+     */
+    ErrorCode try_open_remote_archive();
+
+    /**
+     * Plans to read every section of a remote archive except the tables, which are read in the
+     * byte ranges planned by their reader.
+     */
+    void plan_remote_metadata_section_reads();
+
+    /**
+     * @param section
+     * @return The byte range of the given section within the single file archive.
+     * @throw OperationFailed if the requested section does not exist in ArchiveFileInfo.
+     */
+    ByteRange get_sfa_section_range(std::string_view section) const;
+
     /**
      * Checks out a reader for a given section of the single file archive.
      * @param section
@@ -175,6 +214,8 @@ private:
     std::optional<std::string> m_current_reader_holder;
     std::shared_ptr<TimestampDictionaryReader> m_timestamp_dictionary;
     std::shared_ptr<clp::ReaderInterface> m_reader;
+    // Only set for remote archives, in which case it's also the reader above
+    std::shared_ptr<ByteRangeReader> m_range_reader;
     std::vector<RangeIndexEntry> m_range_index;
 };
 }  // namespace clp_s
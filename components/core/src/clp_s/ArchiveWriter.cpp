@@ -1,8 +1,12 @@
 #include "ArchiveWriter.hpp"
 
 #include <algorithm>
+#include <cstddef>
 #include <filesystem>
 #include <sstream>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include <nlohmann/json.hpp>
 
@@ -10,6 +14,7 @@
 #include "archive_constants.hpp"
 #include "Defs.hpp"
 #include "SchemaTree.hpp"
+#include "TableStatistics.hpp"
 
 namespace clp_s {
 void ArchiveWriter::open(ArchiveWriterOption const& option) {
@@ -18,6 +23,7 @@ void ArchiveWriter::open(ArchiveWriterOption const& option) {
     m_print_archive_stats = option.print_archive_stats;
     m_single_file_archive = option.single_file_archive;
     m_min_table_size = option.min_table_size;
+    m_num_threads = option.num_threads;
     m_archives_dir = option.archives_dir;
     m_authoritative_timestamp = option.authoritative_timestamp;
     m_authoritative_timestamp_namespace = option.authoritative_timestamp_namespace;
@@ -63,12 +69,36 @@ void ArchiveWriter::close() {
             throw OperationFailed(rc, __FILENAME__, __LINE__);
         }
     }
-    auto var_dict_compressed_size = m_var_dict->close();
-    auto log_dict_compressed_size = m_log_dict->close();
-    auto array_dict_compressed_size = m_array_dict->close();
-    auto schema_tree_compressed_size = m_schema_tree.store(m_archive_path, m_compression_level);
-    auto schema_map_compressed_size = m_schema_map.store(m_archive_path, m_compression_level);
-    auto [table_metadata_compressed_size, table_compressed_size] = store_tables();
+    size_t var_dict_compressed_size{};
+    size_t log_dict_compressed_size{};
+    size_t array_dict_compressed_size{};
+    size_t schema_tree_compressed_size{};
+    size_t schema_map_compressed_size{};
+    size_t table_metadata_compressed_size{};
+    size_t table_compressed_size{};
+    if (m_num_threads > 1) {
+        // Each of these files is written independently, so compress them alongside the tables
+        ThreadPool thread_pool{m_num_threads};
+        thread_pool.submit([&](size_t) { var_dict_compressed_size = m_var_dict->close(); });
+        thread_pool.submit([&](size_t) { log_dict_compressed_size = m_log_dict->close(); });
+        thread_pool.submit([&](size_t) { array_dict_compressed_size = m_array_dict->close(); });
+        thread_pool.submit([&](size_t) {
+            schema_tree_compressed_size = m_schema_tree.store(m_archive_path, m_compression_level);
+        });
+        thread_pool.submit([&](size_t) {
+            schema_map_compressed_size = m_schema_map.store(m_archive_path, m_compression_level);
+        });
+        std::tie(table_metadata_compressed_size, table_compressed_size)
+                = store_tables(&thread_pool);
+        thread_pool.wait();
+    } else {
+        var_dict_compressed_size = m_var_dict->close();
+        log_dict_compressed_size = m_log_dict->close();
+        array_dict_compressed_size = m_array_dict->close();
+        schema_tree_compressed_size = m_schema_tree.store(m_archive_path, m_compression_level);
+        schema_map_compressed_size = m_schema_map.store(m_archive_path, m_compression_level);
+        std::tie(table_metadata_compressed_size, table_compressed_size) = store_tables(nullptr);
+    }
 
     std::vector<ArchiveFileInfo> files{
             {constants::cArchiveSchemaTreeFile, schema_tree_compressed_size},
@@ -307,7 +337,9 @@ void ArchiveWriter::initialize_schema_writer(SchemaWriter* writer, Schema const&
                 writer->append_column(new BooleanColumnWriter(id));
                 break;
             case NodeType::UnstructuredArray:
-                writer->append_column(new ClpStringColumnWriter(id, m_var_dict, m_array_dict));
+                writer->append_column(
+                        new ClpStringColumnWriter(id, m_var_dict, m_array_dict, true)
+                );
                 break;
             case NodeType::DateString:
                 writer->append_column(new DateStringColumnWriter(id));
@@ -322,7 +354,7 @@ void ArchiveWriter::initialize_schema_writer(SchemaWriter* writer, Schema const&
     }
 }
 
-std::pair<size_t, size_t> ArchiveWriter::store_tables() {
+std::pair<size_t, size_t> ArchiveWriter::store_tables(ThreadPool* thread_pool) {
     m_tables_file_writer.open(
             m_archive_path + constants::cArchiveTablesFile,
             FileWriter::OpenMode::CreateForWriting
@@ -364,14 +396,27 @@ std::pair<size_t, size_t> ArchiveWriter::store_tables() {
      *     - Schema ID: <32-bit integer>
      *     - Number of messages: <64-bit integer>
      *
+     * Section 3: Schema Table Statistics
+     * - Contains statistics about the values in each schema table's columns (see TableStatistics).
+     *   Readers that predate this section stop reading after Section 2, and archives that predate
+     *   it end after Section 2.
+     * - Structure:
+     *   - Number of schema tables: <64-bit integer>
+     *   - For each schema table:
+     *     - Schema ID: <32-bit integer>
+     *     - Table statistics: <TableStatistics>
+     *
      * We buffer the first half of the metadata in the "stream_metadata" vector, and the second half
-     * of the metadata in the "schema_metadata" vector as we compress the tables. The metadata is
-     * flushed once all of the schema tables have been compressed.
+     * of the metadata in the "schema_metadata" vector as we compress the tables. The statistics for
+     * each table are collected into the "table_statistics" vector, in the same order as
+     * "schema_metadata". The metadata is flushed once all of the schema tables have been
+     * compressed.
      */
     using schema_map_it = decltype(m_id_to_schema_writer)::iterator;
     std::vector<schema_map_it> schemas;
     std::vector<StreamMetadata> stream_metadata;
     std::vector<SchemaMetadata> schema_metadata;
+    std::vector<TableStatistics> table_statistics(m_id_to_schema_writer.size());
 
     schema_metadata.reserve(m_id_to_schema_writer.size());
     schemas.reserve(m_id_to_schema_writer.size());
@@ -384,34 +429,34 @@ std::pair<size_t, size_t> ArchiveWriter::store_tables() {
     };
     std::sort(schemas.begin(), schemas.end(), comp);
 
-    uint64_t current_stream_offset = 0;
-    uint64_t current_stream_id = 0;
-    uint64_t current_table_file_offset = 0;
-    m_tables_compressor.open(m_tables_file_writer, m_compression_level);
+    std::vector<PackedStream> packed_streams;
+    PackedStream current_stream;
     for (auto it : schemas) {
-        it->second->store(m_tables_compressor);
         schema_metadata.emplace_back(
-                current_stream_id,
-                current_stream_offset,
+                packed_streams.size(),
+                current_stream.uncompressed_size,
                 it->first,
                 it->second->get_num_messages()
         );
-        current_stream_offset += it->second->get_total_uncompressed_size();
-        delete it->second;
-
-        if (current_stream_offset > m_min_table_size || schemas.size() == schema_metadata.size()) {
-            stream_metadata.emplace_back(current_table_file_offset, current_stream_offset);
-            m_tables_compressor.close();
-            current_stream_offset = 0;
-            ++current_stream_id;
-            current_table_file_offset = m_tables_file_writer.get_pos();
-
-            if (schemas.size() != schema_metadata.size()) {
-                m_tables_compressor.open(m_tables_file_writer, m_compression_level);
-            }
+        current_stream.uncompressed_size += it->second->get_total_uncompressed_size();
+        current_stream.tables.emplace_back(std::exchange(it->second, nullptr));
+        current_stream.table_statistics.push_back(&table_statistics[schema_metadata.size() - 1]);
+
+        if (current_stream.uncompressed_size > m_min_table_size
+            || schemas.size() == schema_metadata.size())
+        {
+            packed_streams.emplace_back(std::move(current_stream));
+            current_stream = PackedStream{};
         }
     }
 
+    stream_metadata.reserve(packed_streams.size());
+    if (nullptr != thread_pool) {
+        store_packed_streams_in_parallel(*thread_pool, packed_streams, stream_metadata);
+    } else {
+        store_packed_streams(packed_streams, stream_metadata);
+    }
+
     m_table_metadata_compressor.write_numeric_value(stream_metadata.size());
     for (auto& stream : stream_metadata) {
         m_table_metadata_compressor.write_numeric_value(stream.file_offset);
@@ -430,6 +475,12 @@ std::pair<size_t, size_t> ArchiveWriter::store_tables() {
         m_table_metadata_compressor.write_numeric_value(schema.schema_id);
         m_table_metadata_compressor.write_numeric_value(schema.num_messages);
     }
+
+    m_table_metadata_compressor.write_numeric_value(static_cast<uint64_t>(schema_metadata.size()));
+    for (size_t i = 0; i < schema_metadata.size(); ++i) {
+        m_table_metadata_compressor.write_numeric_value(schema_metadata[i].schema_id);
+        table_statistics[i].write(m_table_metadata_compressor);
+    }
     m_table_metadata_compressor.close();
 
     auto table_metadata_compressed_size = m_table_metadata_file_writer.get_pos();
@@ -441,6 +492,68 @@ std::pair<size_t, size_t> ArchiveWriter::store_tables() {
     return {table_metadata_compressed_size, table_compressed_size};
 }
 
+void ArchiveWriter::store_packed_streams(
+        std::vector<PackedStream>& packed_streams,
+        std::vector<StreamMetadata>& stream_metadata
+) {
+    for (auto& packed_stream : packed_streams) {
+        stream_metadata.emplace_back(
+                m_tables_file_writer.get_pos(),
+                packed_stream.uncompressed_size
+        );
+        m_tables_compressor.open(m_tables_file_writer, m_compression_level);
+        for (size_t i = 0; i < packed_stream.tables.size(); ++i) {
+            auto& table = packed_stream.tables[i];
+            table->add_statistics(*packed_stream.table_statistics[i]);
+            table->store(m_tables_compressor);
+            table.reset();
+        }
+        m_tables_compressor.close();
+    }
+}
+
+void ArchiveWriter::store_packed_streams_in_parallel(
+        ThreadPool& thread_pool,
+        std::vector<PackedStream>& packed_streams,
+        std::vector<StreamMetadata>& stream_metadata
+) {
+    size_t const max_num_buffered_streams = 2 * thread_pool.get_num_threads();
+    TaskGroup task_group{thread_pool};
+    std::vector<std::vector<char>> compressed_streams(max_num_buffered_streams);
+    for (size_t batch_begin = 0; batch_begin < packed_streams.size();
+         batch_begin += max_num_buffered_streams)
+    {
+        auto const batch_end
+                = std::min(batch_begin + max_num_buffered_streams, packed_streams.size());
+        for (size_t i = batch_begin; i < batch_end; ++i) {
+            task_group.submit([&, i](size_t) {
+                auto& compressed_stream = compressed_streams[i - batch_begin];
+                ZstdCompressor compressor;
+                compressor.open(compressed_stream, m_compression_level);
+                auto& packed_stream = packed_streams[i];
+                for (size_t j = 0; j < packed_stream.tables.size(); ++j) {
+                    auto& table = packed_stream.tables[j];
+                    table->add_statistics(*packed_stream.table_statistics[j]);
+                    table->store(compressor);
+                    table.reset();
+                }
+                compressor.close();
+            });
+        }
+        task_group.wait();
+
+        for (size_t i = batch_begin; i < batch_end; ++i) {
+            auto& compressed_stream = compressed_streams[i - batch_begin];
+            stream_metadata.emplace_back(
+                    m_tables_file_writer.get_pos(),
+                    packed_streams[i].uncompressed_size
+            );
+            m_tables_file_writer.write(compressed_stream.data(), compressed_stream.size());
+            compressed_stream.clear();
+        }
+    }
+}
+
 auto ArchiveWriter::print_archive_stats() const -> void {
     namespace Archive = clp::streaming_archive::cMetadataDB::Archive;
     nlohmann::json json_msg
@@ -1,10 +1,12 @@
 #ifndef CLP_S_ARCHIVEWRITER_HPP
 #define CLP_S_ARCHIVEWRITER_HPP
 
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_io.hpp>
@@ -17,6 +19,8 @@
 #include "SchemaTree.hpp"
 #include "SchemaWriter.hpp"
 #include "SingleFileArchiveDefs.hpp"
+#include "TableStatistics.hpp"
+#include "ThreadPool.hpp"
 #include "TimestampDictionaryWriter.hpp"
 
 namespace clp_s {
@@ -27,6 +31,7 @@ struct ArchiveWriterOption {
     bool print_archive_stats;
     bool single_file_archive;
     size_t min_table_size;
+    size_t num_threads{1};
     std::vector<std::string> authoritative_timestamp;
     std::string authoritative_timestamp_namespace;
 };
@@ -202,6 +207,19 @@ public:
     }
 
 private:
+    // Types
+    /**
+     * A group of tables that are compressed together into a single packed stream, along with where
+     * to record each table's statistics. The packed stream owns its tables, so any that haven't been
+     * stored yet are released if compression fails.
+     */
+    struct PackedStream {
+        std::vector<std::unique_ptr<SchemaWriter>> tables;
+        std::vector<TableStatistics*> table_statistics;
+        uint64_t uncompressed_size{};
+    };
+
+    // Methods
     /**
      * Initializes the schema writer
      * @param writer
@@ -211,11 +229,39 @@ private:
 
     /**
      * Compresses and stores the tables.
+     * @param thread_pool The pool used to compress packed streams concurrently, or nullptr to
+     * compress them on the calling thread
      * @return A pair containing:
      *         - The size of the compressed table metadata in bytes.
      *         - The size of the compressed tables in bytes.
      */
-    [[nodiscard]] std::pair<size_t, size_t> store_tables();
+    [[nodiscard]] std::pair<size_t, size_t> store_tables(ThreadPool* thread_pool);
+
+    /**
+     * Compresses packed streams on the calling thread and writes them to the tables file. Each table
+     * is released once it has been stored.
+     * @param packed_streams
+     * @param stream_metadata Returns the metadata for each packed stream
+     */
+    void store_packed_streams(
+            std::vector<PackedStream>& packed_streams,
+            std::vector<StreamMetadata>& stream_metadata
+    );
+
+    /**
+     * Compresses packed streams concurrently and writes them to the tables file in order. At most
+     * twice as many streams as there are threads in the pool are held in memory at once. Only the
+     * packed streams' tasks are waited on, so other tasks in the pool (e.g., compressing the
+     * dictionaries) keep running alongside them. Each table is released once it has been stored.
+     * @param thread_pool
+     * @param packed_streams
+     * @param stream_metadata Returns the metadata for each packed stream
+     */
+    void store_packed_streams_in_parallel(
+            ThreadPool& thread_pool,
+            std::vector<PackedStream>& packed_streams,
+            std::vector<StreamMetadata>& stream_metadata
+    );
 
     /**
      * Writes the archive to a single file
@@ -271,6 +317,7 @@ private:
     bool m_print_archive_stats{};
     bool m_single_file_archive{};
     size_t m_min_table_size{};
+    size_t m_num_threads{1};
 
     std::vector<std::string> m_authoritative_timestamp;
     std::string m_authoritative_timestamp_namespace;
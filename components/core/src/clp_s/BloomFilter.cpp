@@ -0,0 +1,105 @@
+#include "BloomFilter.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "ErrorCode.hpp"
+#include "ZstdCompressor.hpp"
+#include "ZstdDecompressor.hpp"
+
+namespace clp_s {
+namespace {
+/**
+ * Mixes the bits of a value so that similar values (e.g., consecutive dictionary IDs) map to
+ * unrelated hashes. This is the finalizer from SplitMix64.
+ * @param value
+ * @return The mixed value
+ */
+auto mix(uint64_t value) -> uint64_t;
+
+auto mix(uint64_t value) -> uint64_t {
+    value ^= value >> 30;
+    value *= 0xbf58'476d'1ce4'e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d0'49bb'1331'11ebULL;
+    value ^= value >> 31;
+    return value;
+}
+}  // namespace
+
+BloomFilter::BloomFilter(size_t num_expected_values)
+        : m_words(get_num_words(num_expected_values), 0) {}
+
+void BloomFilter::add(uint64_t value) {
+    if (m_words.empty()) {
+        // The filter was sized for no values, so grow it to hold at least one
+        m_words.resize(1, 0);
+    }
+
+    // Derive each hash function's bit from two base hashes (Kirsch & Mitzenmacher)
+    uint64_t const num_bits = m_words.size() * cNumBitsPerWord;
+    uint64_t const hash1 = mix(value);
+    uint64_t const hash2 = mix(hash1) | 1;
+    for (uint8_t i = 0; i < m_num_hash_functions; ++i) {
+        auto const bit = (hash1 + i * hash2) % num_bits;
+        m_words[bit / cNumBitsPerWord] |= uint64_t{1} << (bit % cNumBitsPerWord);
+    }
+}
+
+auto BloomFilter::possibly_contains(uint64_t value) const -> bool {
+    if (m_words.empty()) {
+        return false;
+    }
+
+    uint64_t const num_bits = m_words.size() * cNumBitsPerWord;
+    uint64_t const hash1 = mix(value);
+    uint64_t const hash2 = mix(hash1) | 1;
+    for (uint8_t i = 0; i < m_num_hash_functions; ++i) {
+        auto const bit = (hash1 + i * hash2) % num_bits;
+        if (0 == (m_words[bit / cNumBitsPerWord] & (uint64_t{1} << (bit % cNumBitsPerWord)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void BloomFilter::write(ZstdCompressor& compressor) const {
+    compressor.write_numeric_value(m_num_hash_functions);
+    compressor.write_numeric_value(static_cast<uint64_t>(m_words.size()));
+    compressor.write(
+            reinterpret_cast<char const*>(m_words.data()),
+            m_words.size() * sizeof(uint64_t)
+    );
+}
+
+auto BloomFilter::try_read(ZstdDecompressor& decompressor) -> ErrorCode {
+    if (auto const rc = decompressor.try_read_numeric_value(m_num_hash_functions);
+        ErrorCodeSuccess != rc)
+    {
+        return rc;
+    }
+    uint64_t num_words{};
+    if (auto const rc = decompressor.try_read_numeric_value(num_words); ErrorCodeSuccess != rc) {
+        return rc;
+    }
+    if (num_words > cMaxNumWords) {
+        return ErrorCodeCorrupt;
+    }
+
+    m_words.resize(num_words);
+    if (m_words.empty()) {
+        return ErrorCodeSuccess;
+    }
+    return decompressor.try_read_exact_length(
+            reinterpret_cast<char*>(m_words.data()),
+            m_words.size() * sizeof(uint64_t)
+    );
+}
+
+auto BloomFilter::get_num_words(size_t num_expected_values) -> size_t {
+    auto const num_bits = num_expected_values * cNumBitsPerValue;
+    auto const num_words = (num_bits + cNumBitsPerWord - 1) / cNumBitsPerWord;
+    return std::min(num_words, cMaxNumWords);
+}
+}  // namespace clp_s
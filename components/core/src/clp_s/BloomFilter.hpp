@@ -0,0 +1,93 @@
+#ifndef CLP_S_BLOOMFILTER_HPP
+#define CLP_S_BLOOMFILTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ErrorCode.hpp"
+#include "ZstdCompressor.hpp"
+#include "ZstdDecompressor.hpp"
+
+namespace clp_s {
+/**
+ * A bloom filter over 64-bit values. Checking for a value that was added always succeeds, while
+ * checking for a value that wasn't added fails with high probability. The filter is sized for the
+ * number of values it's expected to hold, up to a fixed maximum size.
+ */
+class BloomFilter {
+public:
+    // Constructors
+    BloomFilter() = default;
+
+    /**
+     * @param num_expected_values The number of distinct values that will be added to the filter
+     */
+    explicit BloomFilter(size_t num_expected_values);
+
+    // Methods
+    /**
+     * Adds a value to the filter.
+     * @param value
+     */
+    void add(uint64_t value);
+
+    /**
+     * @param value
+     * @return Whether the value may have been added to the filter. False positives are possible,
+     * but false negatives aren't.
+     */
+    [[nodiscard]] auto possibly_contains(uint64_t value) const -> bool;
+
+    /**
+     * Writes the filter to a compressor.
+     * @param compressor
+     */
+    void write(ZstdCompressor& compressor) const;
+
+    /**
+     * Reads a filter previously written with `write`.
+     * @param decompressor
+     * @return ErrorCodeSuccess on success
+     * @return ErrorCodeCorrupt if the serialized filter is invalid
+     * @return Same as ZstdDecompressor::try_read_numeric_value on failure
+     */
+    [[nodiscard]] auto try_read(ZstdDecompressor& decompressor) -> ErrorCode;
+
+    /**
+     * @return The number of bytes used by the filter's bits
+     */
+    [[nodiscard]] auto get_size_in_bytes() const -> size_t {
+        return m_words.size() * sizeof(uint64_t);
+    }
+
+    /**
+     * @param num_expected_values
+     * @return The number of bytes a filter sized for the given number of values would use
+     */
+    [[nodiscard]] static auto get_size_in_bytes(size_t num_expected_values) -> size_t {
+        return get_num_words(num_expected_values) * sizeof(uint64_t);
+    }
+
+private:
+    // Constants
+    // Ten bits per value with seven hash functions gives a false positive rate of about 1%
+    static constexpr size_t cNumBitsPerValue{10};
+    static constexpr uint8_t cNumHashFunctions{7};
+    static constexpr size_t cMaxNumWords{128 * 1024};
+    static constexpr size_t cNumBitsPerWord{64};
+
+    // Methods
+    /**
+     * @param num_expected_values
+     * @return The number of words in a filter sized for the given number of values
+     */
+    [[nodiscard]] static auto get_num_words(size_t num_expected_values) -> size_t;
+
+    // Variables
+    uint8_t m_num_hash_functions{cNumHashFunctions};
+    std::vector<uint64_t> m_words;
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_BLOOMFILTER_HPP
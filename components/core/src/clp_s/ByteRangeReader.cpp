@@ -0,0 +1,120 @@
+#include "ByteRangeReader.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "../clp/ErrorCode.hpp"
+
+namespace clp_s {
+auto ByteRangeReader::try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+        -> clp::ErrorCode {
+    num_bytes_read = 0;
+    if (0 == num_bytes_to_read) {
+        return clp::ErrorCode_Success;
+    }
+    if (m_pos >= m_size) {
+        return clp::ErrorCode_EndOfFile;
+    }
+
+    while (num_bytes_read < num_bytes_to_read && m_pos < m_size) {
+        if (nullptr == m_range_reader || m_pos >= m_range_end_offset) {
+            if (false == fetch_range_at_pos()) {
+                return num_bytes_read > 0 ? clp::ErrorCode_Success : clp::ErrorCode_Failure;
+            }
+        }
+
+        auto const num_bytes_to_read_from_range
+                = std::min(num_bytes_to_read - num_bytes_read, m_range_end_offset - m_pos);
+        size_t num_bytes_read_from_range{};
+        auto const error = m_range_reader->try_read(
+                buf + num_bytes_read,
+                num_bytes_to_read_from_range,
+                num_bytes_read_from_range
+        );
+        if (clp::ErrorCode_EndOfFile == error) {
+            // The range ended before its end offset, so the next read will fetch it again
+            m_range_reader.reset();
+            return num_bytes_read > 0 ? clp::ErrorCode_Success : clp::ErrorCode_Truncated;
+        }
+        if (clp::ErrorCode_Success != error) {
+            return error;
+        }
+        num_bytes_read += num_bytes_read_from_range;
+        m_pos += num_bytes_read_from_range;
+    }
+    return clp::ErrorCode_Success;
+}
+
+auto ByteRangeReader::try_seek_from_begin(size_t pos) -> clp::ErrorCode {
+    if (pos > m_size) {
+        return clp::ErrorCode_OutOfBounds;
+    }
+    if (pos == m_pos) {
+        return clp::ErrorCode_Success;
+    }
+
+    // Skip short distances within the range being fetched, and otherwise start a new range at the
+    // next read
+    if (nullptr != m_range_reader && pos > m_pos && pos < m_range_end_offset
+        && pos - m_pos <= m_max_coalesced_gap)
+    {
+        if (auto const error = m_range_reader->try_seek_from_begin(pos);
+            clp::ErrorCode_Success != error)
+        {
+            return error;
+        }
+    } else {
+        m_range_reader.reset();
+    }
+    m_pos = pos;
+    return clp::ErrorCode_Success;
+}
+
+void ByteRangeReader::plan_reads(std::vector<ByteRange> ranges) {
+    std::erase_if(ranges, [&](ByteRange const& range) {
+        return range.begin_offset >= range.end_offset || range.begin_offset >= m_size;
+    });
+    std::sort(ranges.begin(), ranges.end(), [](ByteRange const& lhs, ByteRange const& rhs) {
+        return lhs.begin_offset < rhs.begin_offset;
+    });
+
+    m_planned_ranges.clear();
+    for (auto const& range : ranges) {
+        auto const end_offset = std::min(range.end_offset, m_size);
+        if (false == m_planned_ranges.empty()
+            && range.begin_offset <= m_planned_ranges.back().end_offset + m_max_coalesced_gap)
+        {
+            auto& last_range = m_planned_ranges.back();
+            last_range.end_offset = std::max(last_range.end_offset, end_offset);
+        } else {
+            m_planned_ranges.emplace_back(ByteRange{range.begin_offset, end_offset});
+        }
+    }
+}
+
+auto ByteRangeReader::fetch_range_at_pos() -> bool {
+    ByteRange range{m_pos, m_size};
+    auto const it = std::upper_bound(
+            m_planned_ranges.cbegin(),
+            m_planned_ranges.cend(),
+            m_pos,
+            [](size_t pos, ByteRange const& planned_range) {
+                return pos < planned_range.end_offset;
+            }
+    );
+    if (m_planned_ranges.cend() != it && it->begin_offset <= m_pos) {
+        range.end_offset = it->end_offset;
+    }
+
+    m_range_reader = m_create_range_reader(range);
+    if (nullptr == m_range_reader) {
+        return false;
+    }
+    m_range_end_offset = range.end_offset;
+    ++m_num_ranges_fetched;
+    m_num_bytes_fetched += range.end_offset - range.begin_offset;
+    return true;
+}
+}  // namespace clp_s
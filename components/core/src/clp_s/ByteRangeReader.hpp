@@ -0,0 +1,142 @@
+#ifndef CLP_S_BYTERANGEREADER_HPP
+#define CLP_S_BYTERANGEREADER_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "../clp/ErrorCode.hpp"
+#include "../clp/ReaderInterface.hpp"
+
+namespace clp_s {
+/**
+ * The byte range [begin_offset, end_offset).
+ */
+struct ByteRange {
+    size_t begin_offset;
+    size_t end_offset;
+};
+
+/**
+ * A reader for an object in remote storage that fetches the object one byte range at a time (e.g.,
+ * with HTTP range requests), instead of streaming the object from its beginning to its end.
+ *
+ * Callers plan which ranges they're going to read with `plan_reads`. Reading from a planned range
+ * fetches the planned range, and reading from anywhere else fetches everything up to the end of the
+ * object. Planned ranges separated by at most a given gap are coalesced into a single range, since
+ * fetching the gap is cheaper than issuing another request. For the same reason, seeking forward by
+ * at most that gap within the range being fetched skips over the bytes in between rather than
+ * issuing another request.
+ *
+ * Positions are relative to the beginning of the object, and a range is only fetched once it's
+ * read, so seeking (in either direction) is always supported.
+ */
+class ByteRangeReader : public clp::ReaderInterface {
+public:
+    // Types
+    /**
+     * Creates a reader for the given range of the object, positioned at the beginning of the range
+     * and ending at its end. Returns nullptr on failure.
+     */
+    using RangeReaderFactory = std::function<std::shared_ptr<clp::ReaderInterface>(ByteRange)>;
+
+    // Constructors
+    /**
+     * @param create_range_reader
+     * @param size The size of the object in bytes
+     * @param max_coalesced_gap The maximum number of bytes between two ranges that are coalesced
+     */
+    ByteRangeReader(RangeReaderFactory create_range_reader, size_t size, size_t max_coalesced_gap)
+            : m_create_range_reader{std::move(create_range_reader)},
+              m_size{size},
+              m_max_coalesced_gap{max_coalesced_gap} {}
+
+    // Methods implementing the ReaderInterface
+    /**
+     * Tries to read up to a given number of bytes, fetching the next range of the object if
+     * necessary.
+     * @param buf
+     * @param num_bytes_to_read
+     * @param num_bytes_read Returns the number of bytes read.
+     * @return ErrorCode_EndOfFile if the end of the object has been reached.
+     * @return ErrorCode_Failure if a reader for the next range couldn't be created.
+     * @return ErrorCode_Truncated if the range being fetched ended early.
+     * @return Same as the range reader's `try_read` on any other failure.
+     * @return ErrorCode_Success on success.
+     */
+    [[nodiscard]] auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+            -> clp::ErrorCode override;
+
+    /**
+     * Tries to seek to the given position, relative to the beginning of the object.
+     * @param pos
+     * @return ErrorCode_OutOfBounds if the given position is past the end of the object.
+     * @return Same as the range reader's `try_seek_from_begin` if skipping bytes within the range
+     * being fetched fails.
+     * @return ErrorCode_Success on success.
+     */
+    [[nodiscard]] auto try_seek_from_begin(size_t pos) -> clp::ErrorCode override;
+
+    /**
+     * @param pos Returns the position of the read head, relative to the beginning of the object.
+     * @return ErrorCode_Success
+     */
+    [[nodiscard]] auto try_get_pos(size_t& pos) -> clp::ErrorCode override {
+        pos = m_pos;
+        return clp::ErrorCode_Success;
+    }
+
+    // Methods
+    /**
+     * Plans the ranges that are going to be read, replacing any ranges planned before. The range
+     * currently being fetched (if any) isn't affected.
+     * @param ranges
+     */
+    void plan_reads(std::vector<ByteRange> ranges);
+
+    /**
+     * @return The ranges that have been planned, after coalescing.
+     */
+    [[nodiscard]] auto get_planned_ranges() const -> std::vector<ByteRange> const& {
+        return m_planned_ranges;
+    }
+
+    /**
+     * @return The number of ranges that have been fetched, i.e., the number of requests issued.
+     */
+    [[nodiscard]] auto get_num_ranges_fetched() const -> size_t { return m_num_ranges_fetched; }
+
+    /**
+     * @return The total number of bytes in the ranges that have been fetched.
+     */
+    [[nodiscard]] auto get_num_bytes_fetched() const -> size_t { return m_num_bytes_fetched; }
+
+private:
+    // Methods
+    /**
+     * Starts fetching a range of the object at the current position: the planned range containing
+     * the position or, if there isn't one, the rest of the object.
+     * @return Whether a reader for the range was created.
+     */
+    [[nodiscard]] auto fetch_range_at_pos() -> bool;
+
+    // Variables
+    RangeReaderFactory m_create_range_reader;
+    size_t m_size;
+    size_t m_max_coalesced_gap;
+    size_t m_pos{0};
+
+    // Sorted and non-overlapping
+    std::vector<ByteRange> m_planned_ranges;
+
+    std::shared_ptr<clp::ReaderInterface> m_range_reader;
+    size_t m_range_end_offset{0};
+
+    size_t m_num_ranges_fetched{0};
+    size_t m_num_bytes_fetched{0};
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_BYTERANGEREADER_HPP
@@ -87,6 +87,11 @@ public:
 
     void extract_string_value_into_buffer(uint64_t cur_message, std::string& buffer) override;
 
+    /**
+     * @return the values of every message in the column
+     */
+    UnalignedMemSpan<int64_t> get_values() { return m_values; }
+
 private:
     UnalignedMemSpan<int64_t> m_values;
 };
@@ -110,6 +115,11 @@ public:
 
     void extract_string_value_into_buffer(uint64_t cur_message, std::string& buffer) override;
 
+    /**
+     * @return the values of every message in the column
+     */
+    UnalignedMemSpan<double> get_values() { return m_values; }
+
 private:
     UnalignedMemSpan<double> m_values;
 };
@@ -133,6 +143,11 @@ public:
 
     void extract_string_value_into_buffer(uint64_t cur_message, std::string& buffer) override;
 
+    /**
+     * @return the values of every message in the column
+     */
+    UnalignedMemSpan<uint8_t> get_values() { return m_values; }
+
 private:
     UnalignedMemSpan<uint8_t> m_values;
 };
@@ -258,6 +273,11 @@ public:
      */
     epochtime_t get_encoded_time(uint64_t cur_message);
 
+    /**
+     * @return the encoded time in epoch time of every message in the column
+     */
+    UnalignedMemSpan<int64_t> get_encoded_times() { return m_timestamps; }
+
 private:
     std::shared_ptr<TimestampDictionaryReader> m_timestamp_dict;
 
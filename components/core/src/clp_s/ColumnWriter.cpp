@@ -1,5 +1,9 @@
 #include "ColumnWriter.hpp"
 
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 namespace clp_s {
 size_t Int64ColumnWriter::add_value(ParsedMessage::variable_t& value) {
     m_values.push_back(std::get<int64_t>(value));
@@ -11,6 +15,10 @@ void Int64ColumnWriter::store(ZstdCompressor& compressor) {
     compressor.write(reinterpret_cast<char const*>(m_values.data()), size);
 }
 
+void Int64ColumnWriter::add_statistics(TableStatistics& statistics) const {
+    statistics.add_integer_column(m_id, m_values);
+}
+
 size_t FloatColumnWriter::add_value(ParsedMessage::variable_t& value) {
     m_values.push_back(std::get<double>(value));
     return sizeof(double);
@@ -21,6 +29,10 @@ void FloatColumnWriter::store(ZstdCompressor& compressor) {
     compressor.write(reinterpret_cast<char const*>(m_values.data()), size);
 }
 
+void FloatColumnWriter::add_statistics(TableStatistics& statistics) const {
+    statistics.add_float_column(m_id, m_values);
+}
+
 size_t BooleanColumnWriter::add_value(ParsedMessage::variable_t& value) {
     m_values.push_back(std::get<bool>(value) ? 1 : 0);
     return sizeof(uint8_t);
@@ -56,6 +68,25 @@ void ClpStringColumnWriter::store(ZstdCompressor& compressor) {
     compressor.write(reinterpret_cast<char const*>(m_encoded_vars.data()), encoded_vars_size);
 }
 
+void ClpStringColumnWriter::add_statistics(TableStatistics& statistics) const {
+    // Arrays are searched by parsing them rather than by matching logtypes, so statistics about
+    // their encoding wouldn't be used
+    if (m_is_array) {
+        return;
+    }
+
+    std::vector<uint64_t> logtype_ids;
+    logtype_ids.reserve(m_logtypes.size());
+    for (auto const encoded_id : m_logtypes) {
+        logtype_ids.push_back(get_encoded_log_dict_id(encoded_id));
+    }
+    statistics.add_clp_string_column(
+            m_id,
+            std::move(logtype_ids),
+            std::vector<uint64_t>(m_encoded_vars.begin(), m_encoded_vars.end())
+    );
+}
+
 size_t VariableStringColumnWriter::add_value(ParsedMessage::variable_t& value) {
     std::string string_var = std::get<std::string>(value);
     uint64_t id;
@@ -69,6 +100,13 @@ void VariableStringColumnWriter::store(ZstdCompressor& compressor) {
     compressor.write(reinterpret_cast<char const*>(m_variables.data()), size);
 }
 
+void VariableStringColumnWriter::add_statistics(TableStatistics& statistics) const {
+    statistics.add_var_string_column(
+            m_id,
+            std::vector<uint64_t>(m_variables.begin(), m_variables.end())
+    );
+}
+
 size_t DateStringColumnWriter::add_value(ParsedMessage::variable_t& value) {
     auto encoded_timestamp = std::get<std::pair<uint64_t, epochtime_t>>(value);
     m_timestamps.push_back(encoded_timestamp.second);
@@ -83,4 +121,8 @@ void DateStringColumnWriter::store(ZstdCompressor& compressor) {
     size_t encodings_size = m_timestamp_encodings.size() * sizeof(int64_t);
     compressor.write(reinterpret_cast<char const*>(m_timestamp_encodings.data()), encodings_size);
 }
+
+void DateStringColumnWriter::add_statistics(TableStatistics& statistics) const {
+    statistics.add_integer_column(m_id, m_timestamps);
+}
 }  // namespace clp_s
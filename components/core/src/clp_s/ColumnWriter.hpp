@@ -9,6 +9,7 @@
 #include "DictionaryWriter.hpp"
 #include "FileWriter.hpp"
 #include "ParsedMessage.hpp"
+#include "TableStatistics.hpp"
 #include "TimestampDictionaryWriter.hpp"
 #include "VariableEncoder.hpp"
 #include "ZstdCompressor.hpp"
@@ -46,6 +47,13 @@ public:
      */
     virtual size_t get_total_header_size() const { return 0; }
 
+    /**
+     * Records statistics about the values in the column. Columns that can't be used to rule out
+     * tables during search record nothing.
+     * @param statistics
+     */
+    virtual void add_statistics(TableStatistics& statistics) const {}
+
 protected:
     int32_t m_id;
 };
@@ -63,6 +71,8 @@ public:
 
     void store(ZstdCompressor& compressor) override;
 
+    void add_statistics(TableStatistics& statistics) const override;
+
 private:
     std::vector<int64_t> m_values;
 };
@@ -80,6 +90,8 @@ public:
 
     void store(ZstdCompressor& compressor) override;
 
+    void add_statistics(TableStatistics& statistics) const override;
+
 private:
     std::vector<double> m_values;
 };
@@ -107,11 +119,13 @@ public:
     ClpStringColumnWriter(
             int32_t id,
             std::shared_ptr<VariableDictionaryWriter> var_dict,
-            std::shared_ptr<LogTypeDictionaryWriter> log_dict
+            std::shared_ptr<LogTypeDictionaryWriter> log_dict,
+            bool is_array = false
     )
             : BaseColumnWriter(id),
               m_var_dict(std::move(var_dict)),
-              m_log_dict(std::move(log_dict)) {}
+              m_log_dict(std::move(log_dict)),
+              m_is_array(is_array) {}
 
     // Destructor
     ~ClpStringColumnWriter() override = default;
@@ -123,6 +137,8 @@ public:
 
     size_t get_total_header_size() const override { return sizeof(size_t); }
 
+    void add_statistics(TableStatistics& statistics) const override;
+
     /**
      * @param encoded_id
      * @return the encoded log dict id
@@ -157,6 +173,7 @@ private:
     std::shared_ptr<VariableDictionaryWriter> m_var_dict;
     std::shared_ptr<LogTypeDictionaryWriter> m_log_dict;
     LogTypeDictionaryEntry m_logtype_entry;
+    bool m_is_array;
 
     std::vector<int64_t> m_logtypes;
     std::vector<int64_t> m_encoded_vars;
@@ -177,6 +194,8 @@ public:
 
     void store(ZstdCompressor& compressor) override;
 
+    void add_statistics(TableStatistics& statistics) const override;
+
 private:
     std::shared_ptr<VariableDictionaryWriter> m_var_dict;
     std::vector<int64_t> m_variables;
@@ -195,6 +214,8 @@ public:
 
     void store(ZstdCompressor& compressor) override;
 
+    void add_statistics(TableStatistics& statistics) const override;
+
 private:
     std::vector<int64_t> m_timestamps;
     std::vector<int64_t> m_timestamp_encodings;
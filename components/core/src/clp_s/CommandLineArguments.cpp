@@ -227,6 +227,11 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                     po::value<size_t>(&m_minimum_table_size)->value_name("MIN_TABLE_SIZE")->
                         default_value(m_minimum_table_size),
                     "Minimum size (B) for a packed table before it gets compressed."
+            )(
+                    "num-threads",
+                    po::value<size_t>(&m_num_compression_threads)->value_name("NUM")->
+                        default_value(m_num_compression_threads),
+                    "Number of threads used to compress the tables and dictionaries of an archive."
             )(
                     "max-document-size",
                     po::value<size_t>(&m_max_document_size)->value_name("DOC_SIZE")->
@@ -330,6 +335,10 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 throw std::invalid_argument("No input paths specified.");
             }
 
+            if (0 == m_num_compression_threads) {
+                throw std::invalid_argument("Value for num-threads must be greater than zero.");
+            }
+
             if (cJsonFileType == file_type) {
                 m_file_type = FileType::Json;
             } else if (cKeyValueIrFileType == file_type) {
@@ -377,10 +386,35 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                             ->value_name("SIZE"),
                     "Chunk size (B) for each output file when decompressing records in log order."
                     " When set to 0, no chunking is performed."
+            )(
+                    "ordered-memory-budget",
+                    po::value<size_t>(&m_ordered_memory_budget)
+                            ->default_value(m_ordered_memory_budget)
+                            ->value_name("SIZE"),
+                    "Maximum memory (B) used by tables loaded when decompressing records in log"
+                    " order. Tables beyond the budget are spilled to the output directory. When set"
+                    " to 0, memory use is unbounded."
             )(
                     "print-ordered-chunk-stats",
                     po::bool_switch(&m_print_ordered_chunk_stats),
                     "Print statistics (ndjson) about each chunk file after it's extracted."
+            )(
+                    "begin-log-event-idx",
+                    po::value<int64_t>()->value_name("IDX"),
+                    "Only extract the records with log event index >= IDX. Must be used with"
+                    " end-log-event-idx."
+            )(
+                    "end-log-event-idx",
+                    po::value<int64_t>()->value_name("IDX"),
+                    "Only extract the records with log event index < IDX. Must be used with"
+                    " begin-log-event-idx."
+            )(
+                    "num-threads",
+                    po::value<size_t>(&m_num_extraction_threads)
+                            ->value_name("NUM")
+                            ->default_value(m_num_extraction_threads),
+                    "Number of threads used to marshal records when decompressing them in log order"
+                    " without an ordered-memory-budget."
             )(
                     "archive-id",
                     po::value<std::string>(&archive_id)->value_name("ID"),
@@ -455,6 +489,35 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 throw std::invalid_argument("No output directory specified");
             }
 
+            if (0 == m_num_extraction_threads) {
+                throw std::invalid_argument("Value for num-threads must be greater than zero.");
+            }
+
+            if (parsed_command_line_options.count("begin-log-event-idx")
+                != parsed_command_line_options.count("end-log-event-idx"))
+            {
+                throw std::invalid_argument(
+                        "begin-log-event-idx and end-log-event-idx must both be specified"
+                );
+            }
+            if (parsed_command_line_options.count("begin-log-event-idx")) {
+                m_log_event_idx_range = {
+                        parsed_command_line_options["begin-log-event-idx"].as<int64_t>(),
+                        parsed_command_line_options["end-log-event-idx"].as<int64_t>()
+                };
+                if (m_log_event_idx_range->first >= m_log_event_idx_range->second) {
+                    throw std::invalid_argument(
+                            "Log event index range is invalid - begin index is not before end"
+                            " index."
+                    );
+                }
+                if (m_ordered_decompression) {
+                    throw std::invalid_argument(
+                            "Log event index range can't be used with ordered argument"
+                    );
+                }
+            }
+
             if (false == m_ordered_decompression) {
                 if (0 != m_target_ordered_chunk_size) {
                     throw std::invalid_argument(
@@ -462,6 +525,12 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                     );
                 }
 
+                if (0 != m_ordered_memory_budget) {
+                    throw std::invalid_argument(
+                            "ordered-memory-budget must be used with ordered argument"
+                    );
+                }
+
                 if (m_print_ordered_chunk_stats) {
                     throw std::invalid_argument(
                             "print-ordered-chunk-stats must be used with ordered argument"
@@ -499,7 +568,7 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
             )(
                     "query,q",
                     po::value<std::string>(&m_query),
-                    "Query to perform"
+                    "Query to perform, or \"-\" to read queries from stdin, one per line"
             )(
                     "output-handler",
                     po::value<std::string>(&output_handler_name)
@@ -530,6 +599,26 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 "ignore-case,i",
                 po::bool_switch(&m_ignore_case),
                 "Ignore case distinctions between values in the query and the compressed data"
+            )(
+                "num-threads",
+                po::value<size_t>(&m_num_search_threads)
+                    ->value_name("NUM")
+                    ->default_value(m_num_search_threads),
+                "Number of threads used to decompress and filter the tables of an archive. When"
+                " searching several archives concurrently, the threads are shared between them."
+            )(
+                "num-concurrent-archives",
+                po::value<size_t>(&m_num_concurrent_archives)
+                    ->value_name("NUM")
+                    ->default_value(m_num_concurrent_archives),
+                "Number of archives to search concurrently"
+            )(
+                "limit",
+                po::value<uint64_t>(&m_search_result_limit)
+                    ->value_name("NUM")
+                    ->default_value(m_search_result_limit),
+                "Stop searching once NUM results have been output across all archives (0 for no"
+                " limit). Can't be used with the results-cache output handler."
             )(
                 "archive-id",
                 po::value<std::string>(&archive_id)->value_name("ID"),
@@ -550,6 +639,13 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 "Type of authentication required for network requests (s3 | none). Authentication"
                 " with s3 requires the AWS_ACCESS_KEY_ID and AWS_SECRET_ACCESS_KEY environment"
                 " variables, and optionally the AWS_SESSION_TOKEN environment variable."
+            )(
+                "metadata-cache-size",
+                po::value<size_t>(&m_metadata_cache_size)
+                    ->value_name("SIZE")
+                    ->default_value(m_metadata_cache_size),
+                "When reading queries from stdin, the maximum number of bytes of decoded archive"
+                " metadata and dictionaries to keep cached between queries"
             );
             // clang-format on
             search_options.add(match_options);
@@ -691,6 +787,12 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                           << " --host localhost"
                           << " --port 14009"
                           << " --job-id 1" << std::endl;
+                std::cerr << std::endl;
+
+                std::cerr << "  # Search archives in archives-dir for KQL queries read from stdin,"
+                             " one per line, caching archive metadata between queries"
+                          << std::endl;
+                std::cerr << "  " << m_program_name << " s archives-dir -" << std::endl;
 
                 po::options_description visible_options;
                 visible_options.add(general_options);
@@ -727,6 +829,31 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 );
             }
 
+            if (0 == m_num_search_threads) {
+                throw std::invalid_argument("Value for num-threads must be greater than zero.");
+            }
+
+            if (0 == m_num_concurrent_archives) {
+                throw std::invalid_argument(
+                        "Value for num-concurrent-archives must be greater than zero."
+                );
+            }
+
+            if (m_num_concurrent_archives > 1 && serve_queries_from_stdin()) {
+                throw std::invalid_argument(
+                        "num-concurrent-archives can't be greater than one when reading queries"
+                        " from stdin."
+                );
+            }
+
+            if (false == parsed_command_line_options["metadata-cache-size"].defaulted()
+                && false == serve_queries_from_stdin())
+            {
+                throw std::invalid_argument(
+                        "metadata-cache-size can only be used when reading queries from stdin."
+                );
+            }
+
             if (parsed_command_line_options.count("count-by-time") > 0) {
                 m_do_count_by_time_aggregation = true;
                 if (m_count_by_time_bucket_size <= 0) {
@@ -798,6 +925,28 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 );
             }
 
+            if (0 != m_search_result_limit && OutputHandlerType::Reducer == m_output_handler_type)
+            {
+                throw std::invalid_argument("limit can't be used with aggregations.");
+            }
+
+            if (0 != m_search_result_limit
+                && OutputHandlerType::ResultsCache == m_output_handler_type)
+            {
+                // The limit would keep the first results written rather than the latest ones
+                throw std::invalid_argument(
+                        "limit can't be used with the results-cache output handler; use its"
+                        " max-num-results option instead."
+                );
+            }
+
+            if (serve_queries_from_stdin() && OutputHandlerType::Reducer == m_output_handler_type)
+            {
+                throw std::invalid_argument(
+                        "The reducer output handler can't be used when reading queries from stdin."
+                );
+            }
+
             if (m_do_count_by_time_aggregation && m_do_count_results_aggregation) {
                 throw std::invalid_argument(
                         "The --count-by-time and --count options are mutually exclusive."
@@ -1,8 +1,10 @@
 #ifndef CLP_S_COMMANDLINEARGUMENTS_HPP
 #define CLP_S_COMMANDLINEARGUMENTS_HPP
 
+#include <cstdint>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <boost/program_options/option.hpp>
@@ -41,6 +43,10 @@ public:
         KeyValueIr
     };
 
+    // Constants
+    // The query that makes the search command read queries from stdin
+    static constexpr char cStdinQuery[] = "-";
+
     // Constructors
     explicit CommandLineArguments(std::string const& program_name) : m_program_name(program_name) {}
 
@@ -87,12 +93,32 @@ public:
 
     std::string const& get_query() const { return m_query; }
 
+    /**
+     * @return Whether queries should be read from stdin, one per line, rather than taken from the
+     * command line
+     */
+    bool serve_queries_from_stdin() const {
+        return static_cast<char const*>(cStdinQuery) == m_query;
+    }
+
+    size_t get_metadata_cache_size() const { return m_metadata_cache_size; }
+
     std::optional<epochtime_t> get_search_begin_ts() const { return m_search_begin_ts; }
 
     std::optional<epochtime_t> get_search_end_ts() const { return m_search_end_ts; }
 
     bool get_ignore_case() const { return m_ignore_case; }
 
+    size_t get_num_search_threads() const { return m_num_search_threads; }
+
+    size_t get_num_concurrent_archives() const { return m_num_concurrent_archives; }
+
+    /**
+     * @return The maximum number of results to output across all searched archives, or 0 for no
+     * limit
+     */
+    uint64_t get_search_result_limit() const { return m_search_result_limit; }
+
     std::string const& get_reducer_host() const { return m_reducer_host; }
 
     int get_reducer_port() const { return m_reducer_port; }
@@ -115,8 +141,21 @@ public:
 
     size_t get_target_ordered_chunk_size() const { return m_target_ordered_chunk_size; }
 
+    size_t get_ordered_memory_budget() const { return m_ordered_memory_budget; }
+
+    size_t get_num_extraction_threads() const { return m_num_extraction_threads; }
+
+    /**
+     * @return The [begin, end) range of log event indices to extract, if one was specified
+     */
+    std::optional<std::pair<int64_t, int64_t>> const& get_log_event_idx_range() const {
+        return m_log_event_idx_range;
+    }
+
     size_t get_minimum_table_size() const { return m_minimum_table_size; }
 
+    size_t get_num_compression_threads() const { return m_num_compression_threads; }
+
     std::vector<std::string> const& get_projection_columns() const { return m_projection_columns; }
 
     bool get_record_log_order() const { return false == m_disable_log_order; }
@@ -190,8 +229,12 @@ private:
     bool m_structurize_arrays{false};
     bool m_ordered_decompression{false};
     size_t m_target_ordered_chunk_size{};
+    size_t m_ordered_memory_budget{};
+    size_t m_num_extraction_threads{1};
+    std::optional<std::pair<int64_t, int64_t>> m_log_event_idx_range;
     bool m_print_ordered_chunk_stats{false};
     size_t m_minimum_table_size{1ULL * 1024 * 1024};  // 1 MB
+    size_t m_num_compression_threads{1};
     bool m_disable_log_order{false};
     FileType m_file_type{FileType::Json};
 
@@ -210,7 +253,11 @@ private:
     std::optional<epochtime_t> m_search_begin_ts;
     std::optional<epochtime_t> m_search_end_ts;
     bool m_ignore_case{false};
+    size_t m_num_search_threads{1};
+    size_t m_num_concurrent_archives{1};
+    uint64_t m_search_result_limit{0};
     std::vector<std::string> m_projection_columns;
+    size_t m_metadata_cache_size{1ULL * 1024 * 1024 * 1024};  // 1 GiB
 
     // Search aggregation variables
     std::string m_reducer_host;
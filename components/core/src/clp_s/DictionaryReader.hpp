@@ -3,10 +3,19 @@
 #ifndef CLP_S_DICTIONARYREADER_HPP
 #define CLP_S_DICTIONARYREADER_HPP
 
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
 #include <unordered_set>
+#include <vector>
 
+#include <absl/container/flat_hash_map.h>
 #include <boost/algorithm/string/case_conv.hpp>
 
+#include "../clp/DictionaryWildcardIndex.hpp"
 #include "ArchiveReaderAdaptor.hpp"
 #include "DictionaryEntry.hpp"
 #include "Utils.hpp"
@@ -24,7 +33,7 @@ public:
     };
 
     // Constructors
-    DictionaryReader(ArchiveReaderAdaptor& adaptor) : m_is_open(false), m_adaptor(adaptor) {}
+    DictionaryReader(ArchiveReaderAdaptor& adaptor) : m_is_open(false), m_adaptor(&adaptor) {}
 
     // Methods
     /**
@@ -40,9 +49,16 @@ public:
 
     /**
      * Reads all entries from disk
+     * @throw DictionaryReader::OperationFailed if the adaptor was released
      */
     void read_entries(bool lazy = false);
 
+    /**
+     * Releases the adaptor that the entries are read through, so that the reader can outlive it
+     * (e.g., when it's shared through a cache). The entries can't be read again afterwards.
+     */
+    void release_adaptor() { m_adaptor = nullptr; }
+
     /**
      * @return All dictionary entries
      */
@@ -61,7 +77,10 @@ public:
     std::string const& get_value(DictionaryIdType id) const;
 
     /**
-     * Gets the entries matching the given search string
+     * Gets the entries matching the given search string. If the entries were fully decoded when
+     * they were read, the first call builds a hash index over the entries' values (or their
+     * upper-cased values when `ignore_case` is true), so subsequent calls take constant time. This
+     * method is thread-safe.
      * @param search_string
      * @param ignore_case
      * @return a vector of matching entries, or an empty vector if no entry matches.
@@ -70,7 +89,10 @@ public:
     get_entry_matching_value(std::string const& search_string, bool ignore_case) const;
 
     /**
-     * Gets the entries that match a given wildcard string
+     * Gets the entries that match a given wildcard string. If the entries were fully decoded when
+     * they were read, wildcard strings with a literal prefix or suffix are only matched against the
+     * entries with that prefix or suffix, using an index that is built the second time such a
+     * wildcard string is searched for. This method is thread-safe.
      * @param wildcard_string
      * @param ignore_case
      * @param entries Set in which to store found entries
@@ -82,11 +104,67 @@ public:
     ) const;
 
 protected:
+    // Methods
+    /**
+     * Gets the entries matching the given search string by comparing it against every entry.
+     * @param search_string
+     * @param ignore_case
+     * @return a vector of matching entries, or an empty vector if no entry matches.
+     */
+    std::vector<EntryType const*>
+    scan_entries_matching_value(std::string const& search_string, bool ignore_case) const;
+
+    /**
+     * Builds the index from each entry's value to its ID, if it hasn't been built already.
+     */
+    void build_value_index() const;
+
+    /**
+     * Builds the index from each entry's upper-cased value to the IDs of all entries with that
+     * upper-cased value, if it hasn't been built already.
+     */
+    void build_case_folded_value_index() const;
+
+    /**
+     * Gets the wildcard index over the entries' values (or their lower-cased values when
+     * `ignore_case` is true), building it if necessary.
+     * @param wildcard_string
+     * @param ignore_case
+     * @return The wildcard index, or nullptr if the entries can't be indexed, the wildcard string
+     * has no literal prefix or suffix, or the dictionary hasn't been searched often enough to be
+     * worth indexing
+     */
+    clp::DictionaryWildcardIndex const*
+    try_get_wildcard_index(std::string const& wildcard_string, bool ignore_case) const;
+
+    // Variables
     bool m_is_open;
-    ArchiveReaderAdaptor& m_adaptor;
+    ArchiveReaderAdaptor* m_adaptor;
     std::string m_dictionary_path;
     ZstdDecompressor m_dictionary_decompressor;
     std::vector<EntryType> m_entries;
+
+    // Lazily read entries (e.g., logtypes) may be decoded later, which replaces their values. The
+    // value indexes below point into or copy the entries' values, so they're only built when the
+    // entries were fully decoded as they were read.
+    bool m_are_entries_indexable{false};
+
+    // Indexes built on demand by `get_entry_matching_value`. The keys of `m_value_to_id` point into
+    // `m_entries`, so both indexes are cleared whenever the entries are re-read.
+    mutable std::mutex m_value_index_mutex;
+    mutable bool m_is_value_index_built{false};
+    mutable absl::flat_hash_map<std::string_view, DictionaryIdType> m_value_to_id;
+    mutable bool m_is_case_folded_value_index_built{false};
+    mutable absl::flat_hash_map<std::string, std::vector<DictionaryIdType>>
+            m_case_folded_value_to_ids;
+
+    // Wildcard indexes built on demand by `get_entries_matching_wildcard_string`
+    static constexpr size_t cNumAnchoredWildcardScansBeforeIndexing = 1;
+    mutable std::mutex m_wildcard_index_mutex;
+    mutable size_t m_num_anchored_wildcard_scans{0};
+    mutable std::unique_ptr<clp::DictionaryWildcardIndex> m_wildcard_index;
+    mutable std::vector<std::string> m_lowercase_values;
+    mutable std::unique_ptr<clp::DictionaryWildcardIndex> m_lowercase_wildcard_index;
 };
 
 using VariableDictionaryReader = DictionaryReader<uint64_t, VariableDictionaryEntry>;
@@ -115,14 +193,28 @@ void DictionaryReader<DictionaryIdType, EntryType>::read_entries(bool lazy) {
     if (false == m_is_open) {
         throw OperationFailed(ErrorCodeNotInit, __FILENAME__, __LINE__);
     }
+    if (nullptr == m_adaptor) {
+        throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
+    }
 
     constexpr size_t cDecompressorFileReadBufferCapacity = 64 * 1024;  // 64 KB
-    auto dictionary_reader = m_adaptor.checkout_reader_for_section(m_dictionary_path);
+    auto dictionary_reader = m_adaptor->checkout_reader_for_section(m_dictionary_path);
 
     uint64_t num_dictionary_entries;
     dictionary_reader->read_numeric_value(num_dictionary_entries, false);
     m_dictionary_decompressor.open(*dictionary_reader, cDecompressorFileReadBufferCapacity);
 
+    // Invalidate any indexes over the previous entries
+    m_are_entries_indexable = false == lazy;
+    m_is_value_index_built = false;
+    m_value_to_id.clear();
+    m_is_case_folded_value_index_built = false;
+    m_case_folded_value_to_ids.clear();
+    m_num_anchored_wildcard_scans = 0;
+    m_wildcard_index.reset();
+    m_lowercase_wildcard_index.reset();
+    m_lowercase_values.clear();
+
     // Read dictionary entries
     m_entries.resize(num_dictionary_entries);
     for (size_t i = 0; i < num_dictionary_entries; ++i) {
@@ -131,7 +223,7 @@ void DictionaryReader<DictionaryIdType, EntryType>::read_entries(bool lazy) {
     }
 
     m_dictionary_decompressor.close();
-    m_adaptor.checkin_reader_for_section(m_dictionary_path);
+    m_adaptor->checkin_reader_for_section(m_dictionary_path);
 }
 
 template <typename DictionaryIdType, typename EntryType>
@@ -160,6 +252,42 @@ std::vector<EntryType const*>
 DictionaryReader<DictionaryIdType, EntryType>::get_entry_matching_value(
         std::string const& search_string,
         bool ignore_case
+) const {
+    if (false == m_are_entries_indexable) {
+        return scan_entries_matching_value(search_string, ignore_case);
+    }
+
+    if (false == ignore_case) {
+        // In case-sensitive match, there can be only one matched entry.
+        build_value_index();
+        if (auto const it = m_value_to_id.find(std::string_view{search_string});
+            m_value_to_id.cend() != it)
+        {
+            return {&m_entries[it->second]};
+        }
+        return {};
+    }
+
+    build_case_folded_value_index();
+    auto const it = m_case_folded_value_to_ids.find(
+            boost::algorithm::to_upper_copy(search_string)
+    );
+    if (m_case_folded_value_to_ids.cend() == it) {
+        return {};
+    }
+    std::vector<EntryType const*> entries;
+    entries.reserve(it->second.size());
+    for (auto const id : it->second) {
+        entries.push_back(&m_entries[id]);
+    }
+    return entries;
+}
+
+template <typename DictionaryIdType, typename EntryType>
+std::vector<EntryType const*>
+DictionaryReader<DictionaryIdType, EntryType>::scan_entries_matching_value(
+        std::string const& search_string,
+        bool ignore_case
 ) const {
     if (false == ignore_case) {
         // In case-sensitive match, there can be only one matched entry.
@@ -184,18 +312,117 @@ DictionaryReader<DictionaryIdType, EntryType>::get_entry_matching_value(
     return entries;
 }
 
+template <typename DictionaryIdType, typename EntryType>
+void DictionaryReader<DictionaryIdType, EntryType>::build_value_index() const {
+    std::lock_guard const lock{m_value_index_mutex};
+    if (m_is_value_index_built) {
+        return;
+    }
+    m_value_to_id.reserve(m_entries.size());
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        // Keep the first entry for a value to match the behavior of a linear scan
+        m_value_to_id.try_emplace(std::string_view{m_entries[i].get_value()}, i);
+    }
+    m_is_value_index_built = true;
+}
+
+template <typename DictionaryIdType, typename EntryType>
+void DictionaryReader<DictionaryIdType, EntryType>::build_case_folded_value_index() const {
+    std::lock_guard const lock{m_value_index_mutex};
+    if (m_is_case_folded_value_index_built) {
+        return;
+    }
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        m_case_folded_value_to_ids[boost::algorithm::to_upper_copy(m_entries[i].get_value())]
+                .push_back(i);
+    }
+    m_is_case_folded_value_index_built = true;
+}
+
 template <typename DictionaryIdType, typename EntryType>
 void DictionaryReader<DictionaryIdType, EntryType>::get_entries_matching_wildcard_string(
         std::string const& wildcard_string,
         bool ignore_case,
         std::unordered_set<EntryType const*>& entries
 ) const {
-    for (auto const& entry : m_entries) {
+    auto const* index = try_get_wildcard_index(wildcard_string, ignore_case);
+    if (nullptr == index) {
+        for (auto const& entry : m_entries) {
+            if (StringUtils::wildcard_match_unsafe(
+                        entry.get_value(),
+                        wildcard_string,
+                        !ignore_case
+                ))
+            {
+                entries.insert(&entry);
+            }
+        }
+        return;
+    }
+
+    std::string lowercase_wildcard_string;
+    if (ignore_case) {
+        lowercase_wildcard_string = wildcard_string;
+        StringUtils::to_lower(lowercase_wildcard_string);
+    }
+    auto const candidate_ids
+            = index->get_candidate_ids(ignore_case ? lowercase_wildcard_string : wildcard_string);
+    for (auto const id : candidate_ids.value()) {
+        auto const& entry = m_entries[id];
         if (StringUtils::wildcard_match_unsafe(entry.get_value(), wildcard_string, !ignore_case)) {
             entries.insert(&entry);
         }
     }
 }
+
+template <typename DictionaryIdType, typename EntryType>
+clp::DictionaryWildcardIndex const*
+DictionaryReader<DictionaryIdType, EntryType>::try_get_wildcard_index(
+        std::string const& wildcard_string,
+        bool ignore_case
+) const {
+    if (false == m_are_entries_indexable) {
+        return nullptr;
+    }
+
+    std::string prefix;
+    std::string suffix;
+    clp::DictionaryWildcardIndex::get_literal_prefix_and_suffix(wildcard_string, prefix, suffix);
+    if (prefix.empty() && suffix.empty()) {
+        return nullptr;
+    }
+
+    std::lock_guard const lock{m_wildcard_index_mutex};
+    auto& index = ignore_case ? m_lowercase_wildcard_index : m_wildcard_index;
+    if (nullptr != index) {
+        return index.get();
+    }
+
+    // Building an index costs more than a single scan, so only build one once the dictionary is
+    // searched repeatedly
+    ++m_num_anchored_wildcard_scans;
+    if (m_num_anchored_wildcard_scans <= cNumAnchoredWildcardScansBeforeIndexing) {
+        return nullptr;
+    }
+
+    std::vector<std::string_view> values;
+    values.reserve(m_entries.size());
+    if (ignore_case) {
+        m_lowercase_values.clear();
+        m_lowercase_values.reserve(m_entries.size());
+        for (auto const& entry : m_entries) {
+            auto& value = m_lowercase_values.emplace_back(entry.get_value());
+            StringUtils::to_lower(value);
+            values.emplace_back(value);
+        }
+    } else {
+        for (auto const& entry : m_entries) {
+            values.emplace_back(entry.get_value());
+        }
+    }
+    index = std::make_unique<clp::DictionaryWildcardIndex>(std::move(values));
+    return index.get();
+}
 }  // namespace clp_s
 
 #endif  // CLP_S_DICTIONARYREADER_HPP
@@ -1,8 +1,11 @@
 #include "JsonConstructor.hpp"
 
+#include <cstdint>
 #include <filesystem>
-#include <queue>
+#include <string>
 #include <system_error>
+#include <utility>
+#include <vector>
 
 #include <fmt/core.h>
 #include <mongocxx/client.hpp>
@@ -13,6 +16,7 @@
 
 #include "archive_constants.hpp"
 #include "ErrorCode.hpp"
+#include "OrderedRecordReader.hpp"
 #include "ReaderUtils.hpp"
 #include "SchemaTree.hpp"
 #include "TraceableException.hpp"
@@ -47,7 +51,9 @@ void JsonConstructor::store() {
     }
 
     m_archive_reader->open_packed_streams();
-    if (false == m_option.ordered || false == m_archive_reader->has_log_order()) {
+    if (m_option.log_event_idx_range.has_value()) {
+        construct_log_event_range();
+    } else if (false == m_option.ordered || false == m_archive_reader->has_log_order()) {
         FileWriter writer;
         writer.open(
                 m_option.output_dir + "/original",
@@ -63,24 +69,6 @@ void JsonConstructor::store() {
 }
 
 void JsonConstructor::construct_in_order() {
-    std::string buffer;
-    auto tables = m_archive_reader->read_all_tables();
-    using ReaderPointer = std::shared_ptr<SchemaReader>;
-    auto cmp = [](ReaderPointer& left, ReaderPointer& right) {
-        return left->get_next_log_event_idx() > right->get_next_log_event_idx();
-    };
-    std::priority_queue record_queue(tables.begin(), tables.end(), cmp);
-    // Clear tables vector so that memory gets deallocated after we have marshalled all records for
-    // a given table
-    tables.clear();
-
-    int64_t first_idx{};
-    int64_t last_idx{};
-    size_t chunk_size{};
-    auto src_path = std::filesystem::path(m_option.output_dir) / m_archive_reader->get_archive_id();
-    FileWriter writer;
-    writer.open(src_path, FileWriter::OpenMode::CreateForWriting);
-
     mongocxx::client client;
     mongocxx::collection collection;
 
@@ -94,7 +82,112 @@ void JsonConstructor::construct_in_order() {
         }
     }
 
+    OrderedRecordReader record_reader{
+            *m_archive_reader,
+            m_option.ordered_memory_budget,
+            m_option.output_dir
+    };
+    if (m_option.num_threads > 1 && 0 == m_option.ordered_memory_budget) {
+        // Marshal the tables concurrently, leaving only the merge of their records to this thread
+        record_reader.marshal_in_parallel(m_option.num_threads);
+    }
+    auto const chunks = write_ordered_chunks(
+            record_reader,
+            std::filesystem::path(m_option.output_dir) / m_archive_reader->get_archive_id()
+    );
+    if (record_reader.get_num_spilled_tables() > 0) {
+        SPDLOG_INFO(
+                "Spilled {} tables to disk to stay within the ordered decompression memory budget.",
+                record_reader.get_num_spilled_tables()
+        );
+    }
+
+    if (false == m_option.metadata_db.has_value() || chunks.empty()) {
+        return;
+    }
     std::vector<bsoncxx::document::value> results;
+    results.reserve(chunks.size());
+    for (auto const& chunk : chunks) {
+        results.emplace_back(
+                std::move(
+                        bsoncxx::builder::basic::make_document(
+                                bsoncxx::builder::basic::kvp(
+                                        constants::results_cache::decompression::cPath,
+                                        chunk.path.filename()
+                                ),
+                                bsoncxx::builder::basic::kvp(
+                                        constants::results_cache::decompression::cStreamId,
+                                        std::string{m_archive_reader->get_archive_id()}
+                                ),
+                                bsoncxx::builder::basic::kvp(
+                                        constants::results_cache::decompression::cBeginMsgIx,
+                                        chunk.begin_log_event_idx
+                                ),
+                                bsoncxx::builder::basic::kvp(
+                                        constants::results_cache::decompression::cEndMsgIx,
+                                        chunk.end_log_event_idx
+                                ),
+                                bsoncxx::builder::basic::kvp(
+                                        constants::results_cache::decompression::cIsLastChunk,
+                                        &chunk == &chunks.back()
+                                )
+                        )
+                )
+        );
+    }
+    try {
+        collection.insert_many(results);
+    } catch (mongocxx::exception const& e) {
+        throw OperationFailed(ErrorCodeFailureDbBulkWrite, __FILE__, __LINE__, e.what());
+    }
+}
+
+void JsonConstructor::construct_log_event_range() {
+    if (false == m_archive_reader->has_log_order()) {
+        throw OperationFailed(
+                ErrorCodeUnsupported,
+                __FILENAME__,
+                __LINE__,
+                fmt::format(
+                        "Archive '{}' is missing ordering information, so records can't be"
+                        " extracted by log event index.",
+                        m_archive_reader->get_archive_id()
+                )
+        );
+    }
+
+    auto const [begin_log_event_idx, end_log_event_idx] = m_option.log_event_idx_range.value();
+    auto const records
+            = m_archive_reader->read_log_event_range(begin_log_event_idx, end_log_event_idx);
+
+    auto const path = std::filesystem::path(m_option.output_dir)
+                      / fmt::format(
+                              "{}_{}_{}.jsonl",
+                              m_archive_reader->get_archive_id(),
+                              begin_log_event_idx,
+                              end_log_event_idx
+                      );
+    FileWriter writer;
+    writer.open(path, FileWriter::OpenMode::CreateForWriting);
+    for (auto const& [log_event_idx, message] : records) {
+        writer.write(message.c_str(), message.length());
+    }
+    writer.close();
+}
+
+auto JsonConstructor::write_ordered_chunks(
+        OrderedRecordReader& record_reader,
+        std::filesystem::path const& src_path
+) -> std::vector<OrderedChunk> {
+    std::vector<OrderedChunk> chunks;
+    std::string buffer;
+    int64_t log_event_idx{};
+    int64_t first_idx{};
+    int64_t last_idx{};
+    size_t chunk_size{};
+    FileWriter writer;
+    writer.open(src_path, FileWriter::OpenMode::CreateForWriting);
+
     auto finalize_chunk = [&](bool open_new_writer) {
         // Add one to last_idx to match clp's behaviour of having the end index be exclusive
         ++last_idx;
@@ -108,58 +201,28 @@ void JsonConstructor::construct_in_order() {
             throw OperationFailed(ErrorCodeFailure, __FILE__, __LINE__, ec.message());
         }
 
-        if (m_option.metadata_db.has_value()) {
-            results.emplace_back(
-                    std::move(
-                            bsoncxx::builder::basic::make_document(
-                                    bsoncxx::builder::basic::kvp(
-                                            constants::results_cache::decompression::cPath,
-                                            new_file_path.filename()
-                                    ),
-                                    bsoncxx::builder::basic::kvp(
-                                            constants::results_cache::decompression::cStreamId,
-                                            std::string{m_archive_reader->get_archive_id()}
-                                    ),
-                                    bsoncxx::builder::basic::kvp(
-                                            constants::results_cache::decompression::cBeginMsgIx,
-                                            first_idx
-                                    ),
-                                    bsoncxx::builder::basic::kvp(
-                                            constants::results_cache::decompression::cEndMsgIx,
-                                            last_idx
-                                    ),
-                                    bsoncxx::builder::basic::kvp(
-                                            constants::results_cache::decompression::cIsLastChunk,
-                                            false == open_new_writer
-                                    )
-                            )
-                    )
-            );
-        }
-
         if (m_option.print_ordered_chunk_stats) {
             nlohmann::json json_msg;
             json_msg["path"] = new_file_path.string();
             std::cout << json_msg.dump(-1, ' ', true, nlohmann::json::error_handler_t::ignore)
                       << std::endl;
         }
+        chunks.emplace_back(OrderedChunk{
+                .path = std::move(new_file_path),
+                .begin_log_event_idx = first_idx,
+                .end_log_event_idx = last_idx
+        });
 
         if (open_new_writer) {
             writer.open(src_path, FileWriter::OpenMode::CreateForWriting);
         }
     };
 
-    while (false == record_queue.empty()) {
-        ReaderPointer next = record_queue.top();
-        record_queue.pop();
-        last_idx = next->get_next_log_event_idx();
+    while (record_reader.get_next_record(buffer, log_event_idx)) {
+        last_idx = log_event_idx;
         if (0 == chunk_size) {
             first_idx = last_idx;
         }
-        next->get_next_message(buffer);
-        if (false == next->done()) {
-            record_queue.emplace(std::move(next));
-        }
         writer.write(buffer.c_str(), buffer.length());
         chunk_size += buffer.length();
 
@@ -181,13 +244,6 @@ void JsonConstructor::construct_in_order() {
             throw OperationFailed(ErrorCodeFailure, __FILE__, __LINE__, ec.message());
         }
     }
-
-    if (false == results.empty()) {
-        try {
-            collection.insert_many(results);
-        } catch (mongocxx::exception const& e) {
-            throw OperationFailed(ErrorCodeFailureDbBulkWrite, __FILE__, __LINE__, e.what());
-        }
-    }
+    return chunks;
 }
 }  // namespace clp_s
@@ -1,10 +1,14 @@
 #ifndef CLP_S_JSONCONSTRUCTOR_HPP
 #define CLP_S_JSONCONSTRUCTOR_HPP
 
+#include <cstdint>
+#include <filesystem>
+#include <memory>
 #include <optional>
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "ArchiveReader.hpp"
 #include "ColumnReader.hpp"
@@ -12,6 +16,7 @@
 #include "ErrorCode.hpp"
 #include "FileWriter.hpp"
 #include "InputConfig.hpp"
+#include "OrderedRecordReader.hpp"
 #include "SchemaReader.hpp"
 #include "SchemaTree.hpp"
 #include "TraceableException.hpp"
@@ -33,6 +38,10 @@ struct JsonConstructorOption {
     bool ordered{false};
     bool print_ordered_chunk_stats{false};
     size_t target_ordered_chunk_size{};
+    size_t ordered_memory_budget{};
+    size_t num_threads{1};
+    // If set, only the records with log event indices in this [begin, end) range are extracted
+    std::optional<std::pair<int64_t, int64_t>> log_event_idx_range{std::nullopt};
     std::optional<MetadataDbOption> metadata_db{std::nullopt};
 };
 
@@ -66,12 +75,45 @@ public:
     void store();
 
 private:
+    // Types
+    struct OrderedChunk {
+        std::filesystem::path path;
+        int64_t begin_log_event_idx{};
+        // Exclusive
+        int64_t end_log_event_idx{};
+    };
+
+    // Methods
     /**
-     * Reads all of the tables from m_archive_reader and writes all of the records
-     * they contain to writer in log order.
+     * Reads the tables from m_archive_reader and writes all of the records they contain to chunk
+     * files in log order, recording the chunks in the metadata DB if one is configured.
+     *
+     * Tables are loaded as the records they contain are reached, and spilled to the output
+     * directory if the loaded tables exceed `ordered_memory_budget`. With more than one thread and
+     * no memory budget, tables are instead loaded and marshalled concurrently into bounded
+     * in-memory buffers that the merge reads from.
      */
     void construct_in_order();
 
+    /**
+     * Writes the records in `log_event_idx_range` to "<archive-id>_<begin>_<end>.jsonl" in the
+     * output directory, in log order, decompressing only the tables that contain them.
+     */
+    void construct_log_event_range();
+
+    /**
+     * Writes the records read from `record_reader` to chunk files of roughly
+     * `target_ordered_chunk_size` bytes, or to a single file if chunking is disabled.
+     * @param record_reader
+     * @param src_path The path that chunk file names are derived from, and that each chunk is
+     * written to before it's renamed
+     * @return The chunks that were written, in order
+     */
+    auto write_ordered_chunks(
+            OrderedRecordReader& record_reader,
+            std::filesystem::path const& src_path
+    ) -> std::vector<OrderedChunk>;
+
     JsonConstructorOption m_option{};
     std::unique_ptr<ArchiveReader> m_archive_reader;
 };
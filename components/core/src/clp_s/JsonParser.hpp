@@ -45,6 +45,7 @@ struct JsonParserOption {
     size_t target_encoded_size{};
     size_t max_document_size{};
     size_t min_table_size{};
+    size_t num_threads{1};
     int compression_level{};
     bool print_archive_stats{};
     bool structurize_arrays{};
@@ -0,0 +1,365 @@
+#include "OrderedRecordReader.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include "ArchiveReader.hpp"
+#include "ErrorCode.hpp"
+#include "FileWriter.hpp"
+#include "SchemaReader.hpp"
+#include "ThreadPool.hpp"
+
+namespace clp_s {
+OrderedRecordReader::OrderedRecordReader(
+        ArchiveReader& archive_reader,
+        size_t memory_budget,
+        std::string spill_dir
+)
+        : m_archive_reader{archive_reader},
+          m_memory_budget{memory_budget},
+          m_spill_dir{std::move(spill_dir)} {
+    auto const& schema_ids = m_archive_reader.get_schema_ids();
+    m_pending_tables.reserve(schema_ids.size());
+    for (auto const schema_id : schema_ids) {
+        auto const range = m_archive_reader.get_log_event_idx_range(schema_id);
+        m_pending_tables.emplace_back(PendingTable{
+                .schema_id = schema_id,
+                .first_log_event_idx
+                = range.has_value() ? range->min : std::numeric_limits<int64_t>::min()
+        });
+        ++m_streams[m_archive_reader.get_schema_metadata(schema_id).stream_id].num_pending_tables;
+    }
+
+    // Tables without a recorded range sort first. Ties keep the archive's table order, so that
+    // tables loaded up front are loaded in stream order.
+    std::stable_sort(
+            m_pending_tables.begin(),
+            m_pending_tables.end(),
+            [](PendingTable const& lhs, PendingTable const& rhs) {
+                return lhs.first_log_event_idx < rhs.first_log_event_idx;
+            }
+    );
+    m_next_stream_to_read = m_streams.begin();
+}
+
+OrderedRecordReader::~OrderedRecordReader() {
+    for (auto& table : m_tables) {
+        remove_spill_file(*table);
+    }
+}
+
+bool OrderedRecordReader::get_next_record(std::string& message, int64_t& log_event_idx) {
+    // Load every table whose first record precedes the next record of the loaded tables
+    while (m_next_pending_table_ix < m_pending_tables.size()
+           && (m_tables.empty()
+               || m_pending_tables[m_next_pending_table_ix].first_log_event_idx
+                          < m_tables.front()->next_log_event_idx))
+    {
+        if (nullptr == m_thread_pool) {
+            load_table(m_pending_tables[m_next_pending_table_ix]);
+        } else {
+            add_marshalled_table();
+        }
+        ++m_next_pending_table_ix;
+    }
+    if (m_tables.empty()) {
+        return false;
+    }
+
+    std::pop_heap(m_tables.begin(), m_tables.end(), has_later_next_record);
+    auto& table = *m_tables.back();
+    log_event_idx = table.next_log_event_idx;
+    if (nullptr == m_thread_pool) {
+        read_next_record(table, message);
+    } else {
+        read_next_marshalled_record(table, message);
+    }
+    if (table.done) {
+        m_tables.pop_back();
+    } else {
+        std::push_heap(m_tables.begin(), m_tables.end(), has_later_next_record);
+    }
+    return true;
+}
+
+void OrderedRecordReader::marshal_in_parallel(size_t num_threads) {
+    if (0 != m_memory_budget) {
+        throw OperationFailed(ErrorCodeUnsupported, __FILENAME__, __LINE__);
+    }
+    m_num_marshalling_threads = num_threads;
+    m_thread_pool = std::make_unique<ThreadPool>(num_threads);
+    marshal_pending_tables_ahead();
+}
+
+void OrderedRecordReader::add_marshalled_table() {
+    marshal_pending_tables_ahead();
+    auto table = std::move(m_tables_marshalled_ahead.front());
+    m_tables_marshalled_ahead.pop_front();
+    marshal_pending_tables_ahead();
+
+    if (false == wait_for_marshalled_record(*table)) {
+        return;
+    }
+    m_tables.emplace_back(std::move(table));
+    std::push_heap(m_tables.begin(), m_tables.end(), has_later_next_record);
+}
+
+void OrderedRecordReader::marshal_pending_tables_ahead() {
+    while (m_tables_marshalled_ahead.size() < m_num_marshalling_threads
+           && m_next_table_to_marshal_ix < m_pending_tables.size())
+    {
+        auto table = std::make_unique<Table>();
+        table->schema_id = m_pending_tables[m_next_table_to_marshal_ix].schema_id;
+        ++m_next_table_to_marshal_ix;
+
+        // Compressed streams are read in order on this thread
+        read_streams_up_to(m_archive_reader.get_schema_metadata(table->schema_id).stream_id);
+        table->is_marshalling = true;
+        submit_marshalling_task(*table);
+        m_tables_marshalled_ahead.emplace_back(std::move(table));
+    }
+}
+
+void OrderedRecordReader::submit_marshalling_task(Table& table) {
+    m_thread_pool->submit([this, &table](size_t) { marshal_records(table); });
+}
+
+void OrderedRecordReader::marshal_records(Table& table) {
+    try {
+        if (nullptr == table.reader) {
+            auto const stream_id = m_archive_reader.get_schema_metadata(table.schema_id).stream_id;
+            auto& stream = m_streams.at(stream_id);
+            std::shared_ptr<char[]> stream_buf;
+            {
+                // Tables loaded at the same time share the decompressed stream
+                std::lock_guard const lock{stream.mutex};
+                stream_buf = stream.decompressed_buf.lock();
+                if (nullptr == stream_buf) {
+                    stream_buf
+                            = m_archive_reader.decompress_stream(stream_id, stream.compressed_buf);
+                    stream.decompressed_buf = stream_buf;
+                }
+                if (0 == --stream.num_pending_tables) {
+                    std::vector<char>{}.swap(stream.compressed_buf);
+                }
+            }
+            table.reader = std::make_shared<SchemaReader>();
+            m_archive_reader
+                    .load_schema_table(*table.reader, table.schema_id, stream_buf, true, true);
+        }
+
+        bool should_continue{true};
+        while (should_continue) {
+            std::vector<MarshalledRecord> batch;
+            batch.reserve(cNumRecordsPerMarshalledBatch);
+            while (batch.size() < cNumRecordsPerMarshalledBatch && false == table.reader->done()) {
+                auto& record = batch.emplace_back();
+                record.log_event_idx = table.reader->get_next_log_event_idx();
+                table.reader->get_next_message(record.message);
+            }
+            bool const is_fully_marshalled = table.reader->done();
+            if (is_fully_marshalled) {
+                table.reader.reset();
+            }
+
+            {
+                std::lock_guard const lock{m_marshalling_mutex};
+                if (false == batch.empty()) {
+                    table.marshalled_batches.emplace_back(std::move(batch));
+                }
+                table.is_fully_marshalled = is_fully_marshalled;
+                should_continue = false == is_fully_marshalled
+                                  && table.marshalled_batches.size() < cMaxNumMarshalledBatches;
+                table.is_marshalling = should_continue;
+            }
+            m_record_marshalled_cv.notify_all();
+        }
+    } catch (...) {
+        {
+            std::lock_guard const lock{m_marshalling_mutex};
+            table.marshalling_exception = std::current_exception();
+            table.is_marshalling = false;
+        }
+        m_record_marshalled_cv.notify_all();
+    }
+}
+
+auto OrderedRecordReader::wait_for_marshalled_record(Table& table) -> bool {
+    std::unique_lock lock{m_marshalling_mutex};
+    m_record_marshalled_cv.wait(lock, [&] {
+        return false == table.marshalled_batches.empty() || table.is_fully_marshalled
+               || nullptr != table.marshalling_exception;
+    });
+    if (nullptr != table.marshalling_exception) {
+        std::rethrow_exception(table.marshalling_exception);
+    }
+    if (table.marshalled_batches.empty()) {
+        return false;
+    }
+    table.next_log_event_idx
+            = table.marshalled_batches.front()[table.next_marshalled_record_ix].log_event_idx;
+    return true;
+}
+
+void OrderedRecordReader::read_next_marshalled_record(Table& table, std::string& message) {
+    bool should_submit_task{false};
+    {
+        std::lock_guard const lock{m_marshalling_mutex};
+        auto& batch = table.marshalled_batches.front();
+        message = std::move(batch[table.next_marshalled_record_ix].message);
+        if (batch.size() == ++table.next_marshalled_record_ix) {
+            table.marshalled_batches.pop_front();
+            table.next_marshalled_record_ix = 0;
+            if (false == table.is_marshalling && false == table.is_fully_marshalled) {
+                table.is_marshalling = true;
+                should_submit_task = true;
+            }
+        }
+    }
+    if (should_submit_task) {
+        submit_marshalling_task(table);
+    }
+    table.done = false == wait_for_marshalled_record(table);
+}
+
+void OrderedRecordReader::load_table(PendingTable const& pending_table) {
+    auto const stream_id = m_archive_reader.get_schema_metadata(pending_table.schema_id).stream_id;
+    read_streams_up_to(stream_id);
+
+    // Tables loaded at the same time share the decompressed stream
+    auto& stream = m_streams.at(stream_id);
+    auto stream_buf = stream.decompressed_buf.lock();
+    if (nullptr == stream_buf) {
+        stream_buf = m_archive_reader.decompress_stream(stream_id, stream.compressed_buf);
+        stream.decompressed_buf = stream_buf;
+    }
+    if (0 == --stream.num_pending_tables) {
+        std::vector<char>{}.swap(stream.compressed_buf);
+    }
+
+    auto table = std::make_unique<Table>();
+    table->schema_id = pending_table.schema_id;
+    table->reader = std::make_shared<SchemaReader>();
+    m_archive_reader
+            .load_schema_table(*table->reader, pending_table.schema_id, stream_buf, true, true);
+    table->next_log_event_idx = table->reader->get_next_log_event_idx();
+    m_tables.emplace_back(std::move(table));
+    std::push_heap(m_tables.begin(), m_tables.end(), has_later_next_record);
+
+    stream_buf.reset();
+    enforce_memory_budget();
+}
+
+void OrderedRecordReader::read_streams_up_to(size_t stream_id) {
+    for (; m_streams.end() != m_next_stream_to_read && m_next_stream_to_read->first <= stream_id;
+         ++m_next_stream_to_read)
+    {
+        auto& [cur_stream_id, stream] = *m_next_stream_to_read;
+        m_archive_reader.read_compressed_stream(cur_stream_id, stream.compressed_buf);
+    }
+}
+
+void OrderedRecordReader::enforce_memory_budget() {
+    if (0 == m_memory_budget) {
+        return;
+    }
+    while (get_memory_in_use() > m_memory_budget) {
+        Table* table_to_spill{nullptr};
+        for (auto& table : m_tables) {
+            if (nullptr != table->reader
+                && (nullptr == table_to_spill
+                    || table->next_log_event_idx > table_to_spill->next_log_event_idx))
+            {
+                table_to_spill = table.get();
+            }
+        }
+        if (nullptr == table_to_spill) {
+            // Only compressed streams are left in memory
+            return;
+        }
+        spill_table(*table_to_spill);
+        ++m_num_spilled_tables;
+    }
+}
+
+size_t OrderedRecordReader::get_memory_in_use() const {
+    size_t memory_in_use{0};
+    for (auto const& [stream_id, stream] : m_streams) {
+        memory_in_use += stream.compressed_buf.size();
+        if (false == stream.decompressed_buf.expired()) {
+            memory_in_use += m_archive_reader.get_uncompressed_stream_size(stream_id);
+        }
+    }
+    return memory_in_use;
+}
+
+void OrderedRecordReader::spill_table(Table& table) {
+    auto const spill_file_name
+            = fmt::format(".{}.{}.spill", m_archive_reader.get_archive_id(), table.schema_id);
+    table.spill_path = (std::filesystem::path{m_spill_dir} / spill_file_name).string();
+
+    // Each spilled record is written as its log event index, its length, and the record itself
+    FileWriter writer;
+    writer.open(table.spill_path, FileWriter::OpenMode::CreateForWriting);
+    std::string message;
+    while (false == table.reader->done()) {
+        writer.write_numeric_value(table.reader->get_next_log_event_idx());
+        table.reader->get_next_message(message);
+        writer.write_numeric_value(static_cast<uint64_t>(message.size()));
+        writer.write(message.data(), message.size());
+    }
+    writer.close();
+    table.reader.reset();
+
+    table.spill_reader.open(table.spill_path);
+    table.spill_reader.read_numeric_value(table.next_log_event_idx, false);
+}
+
+void OrderedRecordReader::read_next_record(Table& table, std::string& message) {
+    if (nullptr != table.reader) {
+        table.reader->get_next_message(message);
+        if (table.reader->done()) {
+            table.done = true;
+            table.reader.reset();
+        } else {
+            table.next_log_event_idx = table.reader->get_next_log_event_idx();
+        }
+        return;
+    }
+
+    uint64_t message_size{};
+    table.spill_reader.read_numeric_value(message_size, false);
+    message.resize(message_size);
+    if (auto const error = table.spill_reader.try_read_exact_length(message.data(), message_size);
+        ErrorCodeSuccess != error)
+    {
+        throw OperationFailed(error, __FILENAME__, __LINE__);
+    }
+    if (false == table.spill_reader.read_numeric_value(table.next_log_event_idx, true)) {
+        table.done = true;
+        remove_spill_file(table);
+    }
+}
+
+void OrderedRecordReader::remove_spill_file(Table& table) {
+    if (table.spill_path.empty()) {
+        return;
+    }
+    table.spill_reader.close();
+    std::error_code error_code;
+    std::filesystem::remove(table.spill_path, error_code);
+    table.spill_path.clear();
+}
+}  // namespace clp_s
@@ -0,0 +1,265 @@
+#ifndef CLP_S_ORDEREDRECORDREADER_HPP
+#define CLP_S_ORDEREDRECORDREADER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ArchiveReader.hpp"
+#include "ErrorCode.hpp"
+#include "FileReader.hpp"
+#include "SchemaReader.hpp"
+#include "ThreadPool.hpp"
+#include "TraceableException.hpp"
+
+namespace clp_s {
+/**
+ * Reads the records of an archive in log order by merging its tables on their log event indices.
+ *
+ * Tables are loaded lazily: a table is only loaded once the merge reaches the first log event it
+ * contains (according to the log event index range recorded in the table's statistics), and it's
+ * released as soon as all of its records have been read. Tables without a recorded range are
+ * loaded up front.
+ *
+ * The memory used by loaded tables is bounded by a budget. It counts the decompressed packed
+ * streams that loaded tables refer to and the compressed packed streams that are kept because some
+ * of their tables haven't been loaded yet. Whenever loading a table exceeds the budget, the loaded
+ * tables whose next records are furthest in the future are marshalled to spill files on disk, from
+ * which their remaining records are then read.
+ *
+ * Without a budget, tables can instead be loaded and marshalled by a pool of threads, each table
+ * keeping a bounded number of marshalled records in memory ahead of the merge.
+ */
+class OrderedRecordReader {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    // Constructors
+    /**
+     * @param archive_reader An archive reader whose dictionaries, metadata, and packed streams have
+     * been opened. No packed streams may have been read from it yet.
+     * @param memory_budget The maximum number of bytes loaded tables may use, or 0 for no limit
+     * @param spill_dir The directory in which to create spill files
+     */
+    OrderedRecordReader(ArchiveReader& archive_reader, size_t memory_budget, std::string spill_dir);
+
+    // Destructor
+    ~OrderedRecordReader();
+
+    // Delete copy & move constructors and assignment operators
+    OrderedRecordReader(OrderedRecordReader const&) = delete;
+    OrderedRecordReader(OrderedRecordReader&&) = delete;
+    auto operator=(OrderedRecordReader const&) -> OrderedRecordReader& = delete;
+    auto operator=(OrderedRecordReader&&) -> OrderedRecordReader& = delete;
+
+    // Methods
+    /**
+     * Reads the next record in log order.
+     * @param message Returns the marshalled record
+     * @param log_event_idx Returns the record's log event index
+     * @return true if a record was read
+     * @return false if all records have been read
+     */
+    bool get_next_record(std::string& message, int64_t& log_event_idx);
+
+    /**
+     * Loads and marshals tables using a pool of threads, so that the records are only merged on the
+     * calling thread. Each table keeps at most `cMaxNumMarshalledBatches` batches of marshalled
+     * records in memory, and the next `num_threads` tables to be merged are marshalled ahead of
+     * time. Tables are never spilled in this mode, so it can't be used with a memory budget. Must
+     * be called before any record is read.
+     * @param num_threads
+     * @throw OperationFailed if a memory budget is set
+     */
+    void marshal_in_parallel(size_t num_threads);
+
+    /**
+     * @return The number of tables that were spilled to disk to respect the memory budget
+     */
+    [[nodiscard]] size_t get_num_spilled_tables() const { return m_num_spilled_tables; }
+
+private:
+    // Types
+    struct MarshalledRecord {
+        int64_t log_event_idx{};
+        std::string message;
+    };
+
+    /**
+     * A table whose records are being merged. Its remaining records are read either from the
+     * loaded table, from its spill file once the table has been spilled, or from the batches of
+     * records marshalled by the thread pool.
+     */
+    struct Table {
+        int32_t schema_id{};
+        int64_t next_log_event_idx{};
+        std::shared_ptr<SchemaReader> reader;
+        std::string spill_path;
+        FileReader spill_reader;
+        bool done{false};
+
+        // Only used when tables are marshalled in parallel. Every member but the index into the
+        // first batch is guarded by `m_marshalling_mutex`, and `reader` is only used by the thread
+        // marshalling the table.
+        std::deque<std::vector<MarshalledRecord>> marshalled_batches;
+        size_t next_marshalled_record_ix{0};
+        bool is_marshalling{false};
+        bool is_fully_marshalled{false};
+        std::exception_ptr marshalling_exception;
+    };
+
+    /**
+     * A table that hasn't been loaded yet.
+     */
+    struct PendingTable {
+        int32_t schema_id{};
+        int64_t first_log_event_idx{};
+    };
+
+    /**
+     * The state of a packed stream containing tables that are yet to be loaded or are loaded.
+     */
+    struct Stream {
+        std::vector<char> compressed_buf;
+        std::weak_ptr<char[]> decompressed_buf;
+        size_t num_pending_tables{0};
+        // Guards the buffers when tables are marshalled in parallel
+        std::mutex mutex;
+    };
+
+    // Methods
+    /**
+     * Loads a table and adds it to the merge, spilling tables if that exceeds the memory budget.
+     * @param pending_table
+     */
+    void load_table(PendingTable const& pending_table);
+
+    /**
+     * Adds the next pending table to the merge once its first records have been marshalled.
+     */
+    void add_marshalled_table();
+
+    /**
+     * Starts marshalling pending tables until `m_num_marshalling_threads` tables are marshalled
+     * ahead of the merge or no pending tables are left.
+     */
+    void marshal_pending_tables_ahead();
+
+    /**
+     * Queues a task that marshals the next batches of a table's records.
+     * @param table
+     */
+    void submit_marshalling_task(Table& table);
+
+    /**
+     * Loads a table if necessary, then marshals its records until it has `cMaxNumMarshalledBatches`
+     * batches or is fully marshalled. Runs on the thread pool.
+     * @param table
+     */
+    void marshal_records(Table& table);
+
+    /**
+     * Waits until a table's next record has been marshalled and advances the table to it.
+     * @param table
+     * @return Whether the table has a next record
+     * @throw The exception thrown while marshalling the table, if any
+     */
+    auto wait_for_marshalled_record(Table& table) -> bool;
+
+    /**
+     * Reads the next marshalled record of a table and advances the table to the record after it.
+     * @param table
+     * @param message Returns the marshalled record
+     */
+    void read_next_marshalled_record(Table& table, std::string& message);
+
+    /**
+     * Reads the compressed packed streams up to and including the given one, in order.
+     * @param stream_id
+     */
+    void read_streams_up_to(size_t stream_id);
+
+    /**
+     * Spills the loaded tables whose next records are furthest in the future until the memory in
+     * use fits in the budget or there are no loaded tables left.
+     */
+    void enforce_memory_budget();
+
+    /**
+     * @return The number of bytes used by compressed and decompressed packed streams
+     */
+    [[nodiscard]] size_t get_memory_in_use() const;
+
+    /**
+     * Marshals the remaining records of a loaded table to a spill file and releases the table. This
+     * method can be called concurrently for different tables.
+     * @param table
+     */
+    void spill_table(Table& table);
+
+    /**
+     * Reads the next record of a table and advances the table to the record after it.
+     * @param table
+     * @param message Returns the marshalled record
+     */
+    void read_next_record(Table& table, std::string& message);
+
+    /**
+     * Closes and deletes a table's spill file, if it has one.
+     * @param table
+     */
+    static void remove_spill_file(Table& table);
+
+    /**
+     * Orders tables so that the table with the earliest next record is at the top of the heap.
+     * @param lhs
+     * @param rhs
+     * @return Whether lhs's next record comes after rhs's
+     */
+    static bool
+    has_later_next_record(std::unique_ptr<Table> const& lhs, std::unique_ptr<Table> const& rhs) {
+        return lhs->next_log_event_idx > rhs->next_log_event_idx;
+    }
+
+    static constexpr size_t cNumRecordsPerMarshalledBatch{1024};
+    static constexpr size_t cMaxNumMarshalledBatches{4};
+
+    // Variables
+    ArchiveReader& m_archive_reader;
+    size_t m_memory_budget;
+    std::string m_spill_dir;
+
+    std::vector<PendingTable> m_pending_tables;
+    size_t m_next_pending_table_ix{0};
+    std::map<size_t, Stream> m_streams;
+    std::map<size_t, Stream>::iterator m_next_stream_to_read;
+
+    // A min-heap on the tables' next log event indices
+    std::vector<std::unique_ptr<Table>> m_tables;
+    size_t m_num_spilled_tables{0};
+
+    // Pending tables that are being marshalled ahead of the merge, in order
+    std::deque<std::unique_ptr<Table>> m_tables_marshalled_ahead;
+    size_t m_next_table_to_marshal_ix{0};
+    size_t m_num_marshalling_threads{0};
+    std::mutex m_marshalling_mutex;
+    std::condition_variable m_record_marshalled_cv;
+    // Declared last so that its tasks finish before the tables they refer to are destroyed
+    std::unique_ptr<ThreadPool> m_thread_pool;
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_ORDEREDRECORDREADER_HPP
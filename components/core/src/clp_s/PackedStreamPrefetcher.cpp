@@ -0,0 +1,84 @@
+#include "PackedStreamPrefetcher.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "ArchiveReader.hpp"
+#include "ErrorCode.hpp"
+
+namespace clp_s {
+PackedStreamPrefetcher::PackedStreamPrefetcher(
+        ArchiveReader& archive_reader,
+        std::vector<size_t> stream_ids,
+        size_t max_num_prefetched_streams
+)
+        : m_archive_reader{archive_reader},
+          m_stream_ids{std::move(stream_ids)},
+          m_max_num_prefetched_streams{std::max(size_t{1}, max_num_prefetched_streams)} {
+    m_thread = std::thread{&PackedStreamPrefetcher::prefetch_streams, this};
+}
+
+PackedStreamPrefetcher::~PackedStreamPrefetcher() {
+    {
+        std::lock_guard const lock{m_mutex};
+        m_is_stopping = true;
+    }
+    m_stream_consumed_cv.notify_all();
+    m_thread.join();
+}
+
+auto PackedStreamPrefetcher::get_next_stream() -> std::shared_ptr<char[]> {
+    if (m_num_streams_returned >= m_stream_ids.size()) {
+        throw OperationFailed(ErrorCodeOutOfBounds, __FILENAME__, __LINE__);
+    }
+
+    std::unique_lock lock{m_mutex};
+    m_stream_prefetched_cv.wait(lock, [&] {
+        return false == m_prefetched_streams.empty() || nullptr != m_prefetch_exception;
+    });
+    if (m_prefetched_streams.empty()) {
+        std::rethrow_exception(m_prefetch_exception);
+    }
+    auto stream_buffer = std::move(m_prefetched_streams.front());
+    m_prefetched_streams.pop();
+    ++m_num_streams_returned;
+    lock.unlock();
+
+    m_stream_consumed_cv.notify_one();
+    return stream_buffer;
+}
+
+void PackedStreamPrefetcher::prefetch_streams() {
+    std::vector<char> compressed_buf;
+    try {
+        for (auto const stream_id : m_stream_ids) {
+            // Reading the stream doesn't depend on the queue, so only wait before adding to it
+            m_archive_reader.read_compressed_stream(stream_id, compressed_buf);
+            auto stream_buffer = m_archive_reader.decompress_stream(stream_id, compressed_buf);
+
+            std::unique_lock lock{m_mutex};
+            m_stream_consumed_cv.wait(lock, [&] {
+                return m_is_stopping
+                       || m_prefetched_streams.size() < m_max_num_prefetched_streams;
+            });
+            if (m_is_stopping) {
+                return;
+            }
+            m_prefetched_streams.push(std::move(stream_buffer));
+            lock.unlock();
+            m_stream_prefetched_cv.notify_one();
+        }
+    } catch (...) {
+        {
+            std::lock_guard const lock{m_mutex};
+            m_prefetch_exception = std::current_exception();
+        }
+        m_stream_prefetched_cv.notify_one();
+    }
+}
+}  // namespace clp_s
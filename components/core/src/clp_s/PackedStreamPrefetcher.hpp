@@ -0,0 +1,93 @@
+#ifndef CLP_S_PACKEDSTREAMPREFETCHER_HPP
+#define CLP_S_PACKEDSTREAMPREFETCHER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "ArchiveReader.hpp"
+#include "ErrorCode.hpp"
+#include "TraceableException.hpp"
+
+namespace clp_s {
+/**
+ * Reads and decompresses a sequence of packed streams on a background thread, ahead of the thread
+ * consuming them, so that reading (possibly from remote storage) and decompressing the next streams
+ * overlaps with processing the tables of the current one.
+ *
+ * The number of decompressed streams waiting to be consumed is bounded, so the prefetcher holds at
+ * most that many streams (plus the one being read) in memory.
+ */
+class PackedStreamPrefetcher {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    // Constructors
+    /**
+     * Starts prefetching the given streams. While the prefetcher exists, the archive reader's
+     * packed streams must only be read through it.
+     * @param archive_reader An archive reader whose packed streams have been opened
+     * @param stream_ids The IDs of the streams to read, in ascending order
+     * @param max_num_prefetched_streams The maximum number of decompressed streams to keep ready
+     */
+    PackedStreamPrefetcher(
+            ArchiveReader& archive_reader,
+            std::vector<size_t> stream_ids,
+            size_t max_num_prefetched_streams
+    );
+
+    // Destructor
+    ~PackedStreamPrefetcher();
+
+    // Delete copy & move constructors and assignment operators
+    PackedStreamPrefetcher(PackedStreamPrefetcher const&) = delete;
+    PackedStreamPrefetcher(PackedStreamPrefetcher&&) = delete;
+    auto operator=(PackedStreamPrefetcher const&) -> PackedStreamPrefetcher& = delete;
+    auto operator=(PackedStreamPrefetcher&&) -> PackedStreamPrefetcher& = delete;
+
+    // Methods
+    /**
+     * Gets the next stream in the sequence, waiting for it to be decompressed if necessary.
+     * @return A buffer containing the decompressed stream
+     * @throw OperationFailed if every stream has already been returned
+     * @throw The exception thrown while reading or decompressing the stream, if any
+     */
+    [[nodiscard]] auto get_next_stream() -> std::shared_ptr<char[]>;
+
+private:
+    // Methods
+    /**
+     * Reads and decompresses the streams in order until they've all been read, the prefetcher is
+     * destroyed, or reading a stream fails.
+     */
+    void prefetch_streams();
+
+    // Variables
+    ArchiveReader& m_archive_reader;
+    std::vector<size_t> m_stream_ids;
+    size_t m_max_num_prefetched_streams;
+    size_t m_num_streams_returned{0};
+
+    std::queue<std::shared_ptr<char[]>> m_prefetched_streams;
+    std::exception_ptr m_prefetch_exception;
+    bool m_is_stopping{false};
+
+    std::mutex m_mutex;
+    std::condition_variable m_stream_prefetched_cv;
+    std::condition_variable m_stream_consumed_cv;
+    std::thread m_thread;
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_PACKEDSTREAMPREFETCHER_HPP
@@ -1,8 +1,12 @@
 #include "PackedStreamReader.hpp"
 
+#include <utility>
+#include <vector>
+
 #include "../clp/BoundedReader.hpp"
 #include "archive_constants.hpp"
 #include "ArchiveReaderAdaptor.hpp"
+#include "ByteRangeReader.hpp"
 
 namespace clp_s {
 void PackedStreamReader::read_metadata(ZstdDecompressor& decompressor) {
@@ -40,6 +44,17 @@ void PackedStreamReader::read_metadata(ZstdDecompressor& decompressor) {
     }
 }
 
+void PackedStreamReader::load_metadata(std::vector<PackedStreamMetadata> stream_metadata) {
+    switch (m_state) {
+        case PackedStreamReaderState::Uninitialized:
+            m_state = PackedStreamReaderState::MetadataRead;
+            break;
+        default:
+            throw OperationFailed(ErrorCodeNotReady, __FILE__, __LINE__);
+    }
+    m_stream_metadata = std::move(stream_metadata);
+}
+
 void PackedStreamReader::open_packed_streams(std::shared_ptr<ArchiveReaderAdaptor> adaptor) {
     switch (m_state) {
         case PackedStreamReaderState::MetadataRead:
@@ -58,6 +73,27 @@ void PackedStreamReader::open_packed_streams(std::shared_ptr<ArchiveReaderAdapto
     }
 }
 
+void PackedStreamReader::plan_stream_reads(std::vector<size_t> const& stream_ids) {
+    if (PackedStreamReaderState::PackedStreamsOpened != m_state) {
+        throw OperationFailed(ErrorCodeNotReady, __FILE__, __LINE__);
+    }
+
+    // Offsets are relative to the beginning of the tables section
+    std::vector<ByteRange> ranges;
+    ranges.reserve(stream_ids.size());
+    for (auto const stream_id : stream_ids) {
+        if (stream_id >= m_stream_metadata.size()) {
+            throw OperationFailed(ErrorCodeCorrupt, __FILE__, __LINE__);
+        }
+        size_t end_offset = m_adaptor->get_header().compressed_size - m_begin_offset;
+        if ((stream_id + 1) < m_stream_metadata.size()) {
+            end_offset = m_stream_metadata[stream_id + 1].file_offset;
+        }
+        ranges.emplace_back(ByteRange{m_stream_metadata[stream_id].file_offset, end_offset});
+    }
+    m_adaptor->plan_section_reads(constants::cArchiveTablesFile, std::move(ranges));
+}
+
 void PackedStreamReader::close() {
     bool needs_checkin{false};
     switch (m_state) {
@@ -79,9 +115,7 @@ void PackedStreamReader::close() {
     m_state = PackedStreamReaderState::Uninitialized;
 }
 
-void
-PackedStreamReader::read_stream(size_t stream_id, std::shared_ptr<char[]>& buf, size_t& buf_size) {
-    constexpr size_t cDecompressorFileReadBufferCapacity = 64 * 1024;  // 64 KB
+size_t PackedStreamReader::seek_to_stream(size_t stream_id) {
     if (stream_id >= m_stream_metadata.size()) {
         throw OperationFailed(ErrorCodeCorrupt, __FILE__, __LINE__);
     }
@@ -100,8 +134,7 @@ PackedStreamReader::read_stream(size_t stream_id, std::shared_ptr<char[]>& buf,
     }
     m_prev_stream_id = stream_id;
 
-    auto& [file_offset, uncompressed_size] = m_stream_metadata[stream_id];
-    size_t adjusted_file_offset = m_begin_offset + file_offset;
+    size_t adjusted_file_offset = m_begin_offset + m_stream_metadata[stream_id].file_offset;
     if (auto error = m_packed_stream_reader->try_seek_from_begin(adjusted_file_offset);
         clp::ErrorCode::ErrorCode_Success != error)
     {
@@ -112,21 +145,81 @@ PackedStreamReader::read_stream(size_t stream_id, std::shared_ptr<char[]>& buf,
     if ((stream_id + 1) < m_stream_metadata.size()) {
         end_pos = m_begin_offset + m_stream_metadata[stream_id + 1].file_offset;
     }
-    clp::BoundedReader bounded_reader{m_packed_stream_reader.get(), end_pos};
+    return end_pos;
+}
 
-    m_packed_stream_decompressor.open(bounded_reader, cDecompressorFileReadBufferCapacity);
+void PackedStreamReader::resize_buffer_for_stream(
+        size_t stream_id,
+        std::shared_ptr<char[]>& buf,
+        size_t& buf_size
+) const {
+    auto const uncompressed_size = m_stream_metadata.at(stream_id).uncompressed_size;
     if (buf_size < uncompressed_size) {
         // make_shared is supposed to work here for c++20, but it seems like the compiler version
         // we use doesn't support it, so we convert a unique_ptr to a shared_ptr instead.
         buf = std::make_unique<char[]>(uncompressed_size);
         buf_size = uncompressed_size;
     }
-    if (auto error
-        = m_packed_stream_decompressor.try_read_exact_length(buf.get(), uncompressed_size);
+}
+
+void
+PackedStreamReader::read_stream(size_t stream_id, std::shared_ptr<char[]>& buf, size_t& buf_size) {
+    constexpr size_t cDecompressorFileReadBufferCapacity = 64 * 1024;  // 64 KB
+    size_t const end_pos = seek_to_stream(stream_id);
+    clp::BoundedReader bounded_reader{m_packed_stream_reader.get(), end_pos};
+
+    m_packed_stream_decompressor.open(bounded_reader, cDecompressorFileReadBufferCapacity);
+    resize_buffer_for_stream(stream_id, buf, buf_size);
+    if (auto error = m_packed_stream_decompressor.try_read_exact_length(
+                buf.get(),
+                m_stream_metadata[stream_id].uncompressed_size
+        );
         ErrorCodeSuccess != error)
     {
         throw OperationFailed(error, __FILE__, __LINE__);
     }
     m_packed_stream_decompressor.close_for_reuse();
 }
+
+void PackedStreamReader::read_compressed_stream(
+        size_t stream_id,
+        std::vector<char>& compressed_buf
+) {
+    size_t const end_pos = seek_to_stream(stream_id);
+    size_t const begin_pos = m_begin_offset + m_stream_metadata[stream_id].file_offset;
+    if (end_pos < begin_pos) {
+        throw OperationFailed(ErrorCodeCorrupt, __FILE__, __LINE__);
+    }
+
+    compressed_buf.resize(end_pos - begin_pos);
+    if (auto error = m_packed_stream_reader->try_read_exact_length(
+                compressed_buf.data(),
+                compressed_buf.size()
+        );
+        clp::ErrorCode::ErrorCode_Success != error)
+    {
+        throw OperationFailed(static_cast<ErrorCode>(error), __FILE__, __LINE__);
+    }
+}
+
+void PackedStreamReader::decompress_stream(
+        size_t stream_id,
+        std::vector<char> const& compressed_buf,
+        std::shared_ptr<char[]>& buf,
+        size_t& buf_size
+) const {
+    resize_buffer_for_stream(stream_id, buf, buf_size);
+
+    ZstdDecompressor decompressor;
+    decompressor.open(compressed_buf.data(), compressed_buf.size());
+    if (auto error = decompressor.try_read_exact_length(
+                buf.get(),
+                m_stream_metadata.at(stream_id).uncompressed_size
+        );
+        ErrorCodeSuccess != error)
+    {
+        throw OperationFailed(error, __FILE__, __LINE__);
+    }
+    decompressor.close();
+}
 }  // namespace clp_s
@@ -42,12 +42,33 @@ public:
      */
     void read_metadata(ZstdDecompressor& decompressor);
 
+    /**
+     * Loads packed stream metadata previously read with `read_metadata`. Can be invoked instead of
+     * `read_metadata` before reading packed streams.
+     * @param stream_metadata
+     */
+    void load_metadata(std::vector<PackedStreamMetadata> stream_metadata);
+
+    /**
+     * @return The metadata of every packed stream
+     */
+    [[nodiscard]] std::vector<PackedStreamMetadata> const& get_metadata() const {
+        return m_stream_metadata;
+    }
+
     /**
      * Opens a file reader for the tables section. Must be invoked before reading packed streams.
      * @param adaptor a reader adaptor for the archive
      */
     void open_packed_streams(std::shared_ptr<ArchiveReaderAdaptor> adaptor);
 
+    /**
+     * Plans which streams are going to be read, so that only those streams are downloaded if the
+     * archive is remote. Must be invoked after opening the packed streams and before reading any.
+     * @param stream_ids The IDs of the streams to read
+     */
+    void plan_stream_reads(std::vector<size_t> const& stream_ids);
+
     /**
      * Closes the file reader for the tables section.
      */
@@ -73,11 +94,58 @@ public:
      */
     void read_stream(size_t stream_id, std::shared_ptr<char[]>& buf, size_t& buf_size);
 
+    /**
+     * Reads the compressed bytes of a stream with a given stream_id without decompressing them.
+     * The same ordering constraints as for read_stream apply. The returned bytes can be
+     * decompressed with decompress_stream, potentially on a different thread.
+     *
+     * @param stream_id
+     * @param compressed_buf Returns the compressed stream
+     */
+    void read_compressed_stream(size_t stream_id, std::vector<char>& compressed_buf);
+
+    /**
+     * Decompresses a stream previously read with read_compressed_stream. This method doesn't
+     * modify the state of the reader, so it can be called concurrently from multiple threads.
+     *
+     * @param stream_id
+     * @param compressed_buf
+     * @param buf a shared ptr to the buffer where the stream will be decompressed. The buffer gets
+     * resized if it is too small to contain the requested stream.
+     * @param buf_size the size of the underlying buffer owned by buf -- passed and updated by
+     * reference
+     */
+    void decompress_stream(
+            size_t stream_id,
+            std::vector<char> const& compressed_buf,
+            std::shared_ptr<char[]>& buf,
+            size_t& buf_size
+    ) const;
+
     [[nodiscard]] size_t get_uncompressed_stream_size(size_t stream_id) const {
         return m_stream_metadata.at(stream_id).uncompressed_size;
     }
 
 private:
+    /**
+     * Validates that a stream with a given stream_id can be read next and seeks to its beginning.
+     * @param stream_id
+     * @return the offset in the archive at which the compressed stream ends
+     */
+    size_t seek_to_stream(size_t stream_id);
+
+    /**
+     * Grows a buffer so that it can contain a given stream.
+     * @param stream_id
+     * @param buf
+     * @param buf_size
+     */
+    void resize_buffer_for_stream(
+            size_t stream_id,
+            std::shared_ptr<char[]>& buf,
+            size_t& buf_size
+    ) const;
+
     enum PackedStreamReaderState {
         Uninitialized,
         MetadataRead,
@@ -1,12 +1,14 @@
 #include "ReaderUtils.hpp"
 
 #include <exception>
+#include <optional>
 #include <string>
 #include <string_view>
 
 #include <spdlog/spdlog.h>
 
 #include "../clp/aws/AwsAuthenticationSigner.hpp"
+#include "../clp/CurlDownloadHandler.hpp"
 #include "../clp/FileReader.hpp"
 #include "../clp/NetworkReader.hpp"
 #include "../clp/ReaderInterface.hpp"
@@ -190,8 +192,11 @@ bool try_sign_url(std::string& url) {
     return true;
 }
 
-std::shared_ptr<clp::ReaderInterface>
-try_create_network_reader(std::string_view const url, NetworkAuthOption const& auth) {
+std::shared_ptr<clp::ReaderInterface> try_create_network_reader(
+        std::string_view const url,
+        NetworkAuthOption const& auth,
+        std::optional<ByteRange> const& range = std::nullopt
+) {
     std::string request_url{url};
     switch (auth.method) {
         case AuthMethod::S3PresignedUrlV4:
@@ -206,6 +211,19 @@ try_create_network_reader(std::string_view const url, NetworkAuthOption const& a
     }
 
     try {
+        if (range.has_value()) {
+            return std::make_shared<clp::NetworkReader>(
+                    request_url,
+                    range->begin_offset,
+                    false,
+                    clp::CurlDownloadHandler::cDefaultOverallTimeout,
+                    clp::CurlDownloadHandler::cDefaultConnectionTimeout,
+                    clp::NetworkReader::cDefaultBufferPoolSize,
+                    clp::NetworkReader::cDefaultBufferSize,
+                    std::nullopt,
+                    range->end_offset
+            );
+        }
         return std::make_shared<clp::NetworkReader>(request_url);
     } catch (clp::NetworkReader::OperationFailed const& e) {
         SPDLOG_ERROR("Failed to open url for reading - {}", e.what());
@@ -224,4 +242,15 @@ ReaderUtils::try_create_reader(Path const& path, NetworkAuthOption const& networ
         return nullptr;
     }
 }
+
+std::shared_ptr<clp::ReaderInterface> ReaderUtils::try_create_network_range_reader(
+        Path const& path,
+        NetworkAuthOption const& network_auth,
+        ByteRange range
+) {
+    if (InputSource::Network != path.source) {
+        return nullptr;
+    }
+    return try_create_network_reader(path.path, network_auth, range);
+}
 }  // namespace clp_s
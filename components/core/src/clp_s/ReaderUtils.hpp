@@ -5,6 +5,7 @@
 
 #include "../clp/ReaderInterface.hpp"
 #include "ArchiveReaderAdaptor.hpp"
+#include "ByteRangeReader.hpp"
 #include "DictionaryReader.hpp"
 #include "InputConfig.hpp"
 #include "Schema.hpp"
@@ -76,6 +77,21 @@ public:
     static std::shared_ptr<clp::ReaderInterface>
     try_create_reader(Path const& path, NetworkAuthOption const& network_auth);
 
+    /**
+     * Tries to open a clp::ReaderInterface for a byte range of the resource at the given network
+     * Path, using the given NetworkAuthOption.
+     * @param path
+     * @param network_auth
+     * @param range
+     * @return the opened clp::ReaderInterface, positioned at the beginning of the range, or nullptr
+     * on error
+     */
+    static std::shared_ptr<clp::ReaderInterface> try_create_network_range_reader(
+            Path const& path,
+            NetworkAuthOption const& network_auth,
+            ByteRange range
+    );
+
 private:
     /**
      * Appends a column to the given schema reader
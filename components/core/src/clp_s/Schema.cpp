@@ -1,8 +1,29 @@
 #include "Schema.hpp"
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 
 namespace clp_s {
+namespace {
+/**
+ * Mixes the bits of a value so that similar values (e.g., consecutive node IDs) map to unrelated
+ * hashes. This is the finalizer from SplitMix64.
+ * @param value
+ * @return The mixed value
+ */
+auto mix(uint64_t value) -> uint64_t;
+
+auto mix(uint64_t value) -> uint64_t {
+    value ^= value >> 30;
+    value *= 0xbf58'476d'1ce4'e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d0'49bb'1331'11ebULL;
+    value ^= value >> 31;
+    return value;
+}
+}  // namespace
+
 void Schema::insert_ordered(int32_t mst_node_id) {
     m_schema.insert(
             std::upper_bound(
@@ -14,13 +35,53 @@ void Schema::insert_ordered(int32_t mst_node_id) {
             mst_node_id
     );
     ++m_num_ordered;
+    m_ordered_hash += hash_ordered_entry(mst_node_id);
 }
 
 void Schema::insert_unordered(int32_t mst_node_id) {
+    m_unordered_hash += hash_unordered_entry(mst_node_id, m_schema.size() - m_num_ordered);
     m_schema.push_back(mst_node_id);
 }
 
 void Schema::insert_unordered(Schema const& schema) {
-    m_schema.insert(m_schema.end(), schema.begin(), schema.end());
+    for (auto const schema_entry : schema) {
+        insert_unordered(schema_entry);
+    }
+}
+
+void Schema::end_unordered_object(size_t start_position) {
+    auto& schema_entry = m_schema[start_position - 1];
+    auto const unordered_pos = start_position - 1 - m_num_ordered;
+    m_unordered_hash -= hash_unordered_entry(schema_entry, unordered_pos);
+    schema_entry |= static_cast<int32_t>(m_schema.size() - start_position);
+    m_unordered_hash += hash_unordered_entry(schema_entry, unordered_pos);
+}
+
+uint64_t Schema::get_hash() const {
+    if (false == m_hash_is_valid) {
+        recompute_hash();
+    }
+    return mix(m_ordered_hash ^ mix(m_unordered_hash + m_num_ordered));
+}
+
+uint64_t Schema::hash_ordered_entry(int32_t mst_node_id) {
+    return mix(static_cast<uint32_t>(mst_node_id));
+}
+
+uint64_t Schema::hash_unordered_entry(int32_t schema_entry, size_t unordered_pos) {
+    return mix((static_cast<uint64_t>(unordered_pos) << 32) | static_cast<uint32_t>(schema_entry));
+}
+
+void Schema::recompute_hash() const {
+    m_ordered_hash = 0;
+    m_unordered_hash = 0;
+    for (size_t i = 0; i < m_schema.size(); ++i) {
+        if (i < m_num_ordered) {
+            m_ordered_hash += hash_ordered_entry(m_schema[i]);
+        } else {
+            m_unordered_hash += hash_unordered_entry(m_schema[i], i - m_num_ordered);
+        }
+    }
+    m_hash_is_valid = true;
 }
 }  // namespace clp_s
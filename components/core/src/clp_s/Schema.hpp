@@ -20,6 +20,10 @@ namespace clp_s {
  * In the current implementation of clp-s, MST node IDs must be unique in the ordered region of a
  * schema, but can be repeated in the unordered region. The caller is responsible for not inserting
  * duplicate MST nodes into the ordered region of a schema.
+ *
+ * The schema maintains its hash as nodes are inserted so that looking it up in a SchemaMap doesn't
+ * require rehashing every node. Methods that expose the underlying schema for modification
+ * invalidate the hash, and it is recomputed the next time it's requested.
  */
 class Schema {
 public:
@@ -52,6 +56,9 @@ public:
     void clear() {
         m_schema.clear();
         m_num_ordered = 0;
+        m_ordered_hash = 0;
+        m_unordered_hash = 0;
+        m_hash_is_valid = true;
     }
 
     /**
@@ -59,7 +66,10 @@ public:
      * decompression to help initialize this object.
      * @param num_ordered
      */
-    void set_num_ordered(size_t num_ordered) { m_num_ordered = num_ordered; }
+    void set_num_ordered(size_t num_ordered) {
+        m_num_ordered = num_ordered;
+        m_hash_is_valid = false;
+    }
 
     /**
      * @return the number of ordered elements in the underlying schema
@@ -74,12 +84,18 @@ public:
     /**
      * @return iterator to the start of the underlying schema
      */
-    [[nodiscard]] auto begin() { return m_schema.begin(); }
+    [[nodiscard]] auto begin() {
+        m_hash_is_valid = false;
+        return m_schema.begin();
+    }
 
     /**
      * @return iterator to the end of the underlying schema
      */
-    [[nodiscard]] auto end() { return m_schema.end(); }
+    [[nodiscard]] auto end() {
+        m_hash_is_valid = false;
+        return m_schema.end();
+    }
 
     /**
      * @return constant iterator to the start of the underlying schema
@@ -110,6 +126,7 @@ public:
      * @return a view into the ordered region of the underlying schema
      */
     [[nodiscard]] std::span<int32_t> get_ordered_schema_view() {
+        m_hash_is_valid = false;
         return std::span<int32_t>{m_schema.data(), m_num_ordered};
     }
 
@@ -122,6 +139,7 @@ public:
         if (i + size > m_schema.size()) {
             throw OperationFailed(ErrorCodeOutOfBounds, __FILENAME__, __LINE__);
         }
+        m_hash_is_valid = false;
         return std::span<int32_t>{m_schema.data() + i, size};
     }
 
@@ -129,7 +147,10 @@ public:
      * Resizes the internal schema vector to match the given length.
      * @param size
      */
-    void resize(size_t size) { m_schema.resize(size); }
+    void resize(size_t size) {
+        m_schema.resize(size);
+        m_hash_is_valid = false;
+    }
 
     /**
      * Less than comparison operator so that Schema can act as a key for SchemaMap
@@ -145,6 +166,11 @@ public:
      */
     bool operator==(Schema const& rhs) const { return m_schema == rhs.m_schema; }
 
+    /**
+     * @return a hash of the schema's nodes and the number of nodes in its ordered region
+     */
+    [[nodiscard]] uint64_t get_hash() const;
+
     /**
      * Starts an unordered object of a given NodeType.
      *
@@ -162,9 +188,7 @@ public:
      * Ends an unordered object which was started by calling `start_unordered_object`.
      * @param start_position
      */
-    void end_unordered_object(size_t start_position) {
-        m_schema[start_position - 1] |= static_cast<int32_t>(m_schema.size() - start_position);
-    }
+    void end_unordered_object(size_t start_position);
 
     /**
      * Encodes a NodeType as a schema entry to delimit an unordered object using bithacks.
@@ -207,8 +231,32 @@ private:
     static constexpr int32_t cEncodedTypeBitmask = 0xFF00'0000;
     static constexpr int32_t cEncodedTypeLengthBitmask = ~cEncodedTypeBitmask;
 
+    /**
+     * @param mst_node_id
+     * @return The contribution of a node in the ordered region to the schema's hash. Since the
+     * ordered region is kept sorted, the contribution doesn't depend on the node's position.
+     */
+    static uint64_t hash_ordered_entry(int32_t mst_node_id);
+
+    /**
+     * @param schema_entry
+     * @param unordered_pos The position of the entry relative to the start of the unordered region
+     * @return The contribution of an entry in the unordered region to the schema's hash
+     */
+    static uint64_t hash_unordered_entry(int32_t schema_entry, size_t unordered_pos);
+
+    /**
+     * Recomputes the hash from scratch after the schema was modified directly.
+     */
+    void recompute_hash() const;
+
     std::vector<int32_t> m_schema;
     size_t m_num_ordered{0};
+
+    // The hash is the sum of every entry's contribution, tracked separately per region
+    mutable uint64_t m_ordered_hash{0};
+    mutable uint64_t m_unordered_hash{0};
+    mutable bool m_hash_is_valid{true};
 };
 }  // namespace clp_s
 
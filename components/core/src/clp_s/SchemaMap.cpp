@@ -1,17 +1,27 @@
 #include "SchemaMap.hpp"
 
+#include <algorithm>
+#include <vector>
+
 #include "archive_constants.hpp"
 #include "FileWriter.hpp"
 #include "ZstdCompressor.hpp"
 
 namespace clp_s {
 int32_t SchemaMap::add_schema(Schema const& schema) {
-    auto const schema_it = m_schema_map.find(schema);
-    if (m_schema_map.end() != schema_it) {
-        return schema_it->second;
+    if (nullptr != m_last_schema_mapping
+        && m_last_schema_mapping->first.get_hash() == schema.get_hash()
+        && SchemaEqual{}(m_last_schema_mapping->first, schema))
+    {
+        return m_last_schema_mapping->second;
+    }
+
+    auto const [schema_it, inserted] = m_schema_map.try_emplace(schema, m_current_schema_id);
+    if (inserted) {
+        ++m_current_schema_id;
     }
-    m_schema_map.emplace(schema, m_current_schema_id);
-    return m_current_schema_id++;
+    m_last_schema_mapping = &(*schema_it);
+    return schema_it->second;
 }
 
 size_t SchemaMap::store(std::string const& archives_dir, int compression_level) {
@@ -24,10 +34,22 @@ size_t SchemaMap::store(std::string const& archives_dir, int compression_level)
             FileWriter::OpenMode::CreateForWriting
     );
     schema_map_compressor.open(schema_map_writer, compression_level);
-    schema_map_compressor.write_numeric_value(m_schema_map.size());
+    // Write the schemas in ID order so that the output doesn't depend on the map's iteration order
+    std::vector<schema_map_t::const_pointer> schema_mappings;
+    schema_mappings.reserve(m_schema_map.size());
     for (auto const& schema_mapping : m_schema_map) {
-        auto const& schema = schema_mapping.first;
-        schema_map_compressor.write_numeric_value(schema_mapping.second);
+        schema_mappings.push_back(&schema_mapping);
+    }
+    std::sort(
+            schema_mappings.begin(),
+            schema_mappings.end(),
+            [](auto const* lhs, auto const* rhs) { return lhs->second < rhs->second; }
+    );
+
+    schema_map_compressor.write_numeric_value(m_schema_map.size());
+    for (auto const* schema_mapping : schema_mappings) {
+        auto const& schema = schema_mapping->first;
+        schema_map_compressor.write_numeric_value(schema_mapping->second);
         schema_map_compressor.write_numeric_value(static_cast<uint32_t>(schema.size()));
         schema_map_compressor.write_numeric_value(static_cast<uint32_t>(schema.get_num_ordered()));
         for (int32_t mst_node_id : schema) {
@@ -1,15 +1,36 @@
 #ifndef CLP_S_SCHEMAMAP_HPP
 #define CLP_S_SCHEMAMAP_HPP
 
-#include <map>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <utility>
 
 #include "Schema.hpp"
 
 namespace clp_s {
 class SchemaMap {
 public:
-    using schema_map_t = std::map<Schema, int32_t>;
+    // Types
+    /**
+     * Hashes a schema using the hash it maintains as nodes are inserted.
+     */
+    struct SchemaHash {
+        size_t operator()(Schema const& schema) const { return schema.get_hash(); }
+    };
+
+    /**
+     * Schemas with the same nodes but a different number of ordered nodes are stored differently,
+     * so they're treated as distinct.
+     */
+    struct SchemaEqual {
+        bool operator()(Schema const& lhs, Schema const& rhs) const {
+            return lhs.get_num_ordered() == rhs.get_num_ordered() && lhs == rhs;
+        }
+    };
+
+    using schema_map_t = std::unordered_map<Schema, int32_t, SchemaHash, SchemaEqual>;
 
     // Constructor
     SchemaMap() : m_current_schema_id(0) {}
@@ -33,7 +54,10 @@ public:
     /**
      * Clear the schema map
      */
-    void clear() { m_schema_map.clear(); }
+    void clear() {
+        m_schema_map.clear();
+        m_last_schema_mapping = nullptr;
+    }
 
     /**
      * Get const iterators into the schema map
@@ -50,6 +74,10 @@ public:
 private:
     int32_t m_current_schema_id;
     schema_map_t m_schema_map;
+    // Consecutive records usually share a schema, so the last schema looked up is checked before
+    // the map. Elements of an unordered_map aren't moved when it rehashes, so the pointer stays
+    // valid until the map is cleared.
+    std::pair<Schema const, int32_t> const* m_last_schema_mapping{nullptr};
 };
 }  // namespace clp_s
 
@@ -1,5 +1,7 @@
 #include "SchemaReader.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <stack>
 #include <string>
 
@@ -46,6 +48,24 @@ int64_t SchemaReader::get_next_log_event_idx() const {
     return 0;
 }
 
+void SchemaReader::skip_to_log_event_idx(int64_t log_event_idx) {
+    if (nullptr == m_log_event_idx_column) {
+        return;
+    }
+    auto log_event_idxs = m_log_event_idx_column->get_values();
+    uint64_t begin{m_cur_message};
+    uint64_t end{m_num_messages};
+    while (begin < end) {
+        auto const mid = begin + (end - begin) / 2;
+        if (log_event_idxs[mid] < log_event_idx) {
+            begin = mid + 1;
+        } else {
+            end = mid;
+        }
+    }
+    m_cur_message = begin;
+}
+
 void
 SchemaReader::load(std::shared_ptr<char[]> stream_buffer, size_t offset, size_t uncompressed_size) {
     m_stream_buffer = stream_buffer;
@@ -197,7 +217,7 @@ bool SchemaReader::get_next_message(std::string& message) {
 
 bool SchemaReader::get_next_message(std::string& message, FilterClass* filter) {
     while (m_cur_message < m_num_messages) {
-        if (false == filter->filter(m_cur_message)) {
+        if (false == filter_current_message(filter)) {
             m_cur_message++;
             continue;
         }
@@ -221,6 +241,23 @@ bool SchemaReader::get_next_message(std::string& message, FilterClass* filter) {
     return false;
 }
 
+uint64_t SchemaReader::count_matching_messages(FilterClass* filter) {
+    uint64_t num_matches{0};
+    while (m_cur_message < m_num_messages) {
+        // Evaluate the filter for the batch containing the current message, then count the rest of
+        // the batch in one pass
+        filter_current_message(filter);
+        num_matches += std::count_if(
+                m_filter_selection.cbegin()
+                        + static_cast<std::ptrdiff_t>(m_cur_message - m_filter_batch_begin),
+                m_filter_selection.cend(),
+                [](uint8_t is_selected) { return 0 != is_selected; }
+        );
+        m_cur_message = m_filter_batch_end;
+    }
+    return num_matches;
+}
+
 bool SchemaReader::get_next_message_with_metadata(
         std::string& message,
         epochtime_t& timestamp,
@@ -230,7 +267,7 @@ bool SchemaReader::get_next_message_with_metadata(
     // TODO: If we already get max_num_results messages, we can skip messages
     // with the timestamp less than the smallest timestamp in the priority queue
     while (m_cur_message < m_num_messages) {
-        if (false == filter->filter(m_cur_message)) {
+        if (false == filter_current_message(filter)) {
             m_cur_message++;
             continue;
         }
@@ -257,11 +294,25 @@ bool SchemaReader::get_next_message_with_metadata(
     return false;
 }
 
+bool SchemaReader::filter_current_message(FilterClass* filter) {
+    if (m_cur_message >= m_filter_batch_end) {
+        m_filter_batch_begin = m_cur_message;
+        m_filter_batch_end = std::min(m_cur_message + cFilterBatchSize, m_num_messages);
+        m_filter_selection.resize(m_filter_batch_end - m_filter_batch_begin);
+        filter->filter_batch(m_filter_batch_begin, m_filter_selection);
+    }
+    return 0 != m_filter_selection[m_cur_message - m_filter_batch_begin];
+}
+
 void SchemaReader::initialize_filter(FilterClass* filter) {
+    m_filter_batch_begin = 0;
+    m_filter_batch_end = 0;
     filter->init(this, m_columns);
 }
 
 void SchemaReader::initialize_filter_with_column_map(FilterClass* filter) {
+    m_filter_batch_begin = 0;
+    m_filter_batch_end = 0;
     filter->init(this, m_column_map);
 }
 
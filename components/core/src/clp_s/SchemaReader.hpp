@@ -7,6 +7,7 @@
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "ColumnReader.hpp"
 #include "FileReader.hpp"
@@ -43,6 +44,19 @@ public:
      * @return true if the message is accepted
      */
     virtual bool filter(uint64_t cur_message) = 0;
+
+    /**
+     * Filters a contiguous batch of messages. The default implementation calls `filter` once per
+     * message; implementations can override it to evaluate whole columns at a time.
+     * @param begin_message the first message in the batch
+     * @param selection Returns one entry per message in the batch: 1 if the message is accepted
+     * and 0 otherwise. The size of the batch is the size of this vector.
+     */
+    virtual void filter_batch(uint64_t begin_message, std::vector<uint8_t>& selection) {
+        for (size_t i = 0; i < selection.size(); ++i) {
+            selection[i] = filter(begin_message + i) ? 1 : 0;
+        }
+    }
 };
 
 class SchemaReader {
@@ -113,6 +127,8 @@ public:
         m_global_schema_tree = std::move(schema_tree);
         m_projection = std::move(projection);
         m_should_marshal_records = should_marshal_records;
+        m_filter_batch_begin = 0;
+        m_filter_batch_end = 0;
     }
 
     /**
@@ -169,6 +185,13 @@ public:
      */
     bool get_next_message(std::string& message, FilterClass* filter);
 
+    /**
+     * Counts the remaining messages matching a filter without marshalling them, consuming them.
+     * @param filter
+     * @return the number of matching messages
+     */
+    uint64_t count_matching_messages(FilterClass* filter);
+
     /**
      * Gets the next message matching a filter as well as its timestamp and log event index.
      * @param message
@@ -235,6 +258,14 @@ public:
      */
     bool done() const { return m_cur_message >= m_num_messages; }
 
+    /**
+     * Skips the records whose log event index is lower than the given one. Records are stored in
+     * log order, so the first record to keep is found with a binary search. Does nothing if this
+     * table has no log_event_idx.
+     * @param log_event_idx
+     */
+    void skip_to_log_event_idx(int64_t log_event_idx);
+
 private:
     /**
      * Merges the current local schema tree with the section of the global schema tree corresponding
@@ -309,6 +340,17 @@ private:
      */
     void initialize_serializer();
 
+    /**
+     * Checks whether the message pointed to by m_cur_message is accepted by a filter. Messages are
+     * filtered in batches of cFilterBatchSize, so the filter is only invoked when m_cur_message
+     * moves past the end of the current batch.
+     * @param filter
+     * @return true if the message is accepted
+     */
+    bool filter_current_message(FilterClass* filter);
+
+    static constexpr size_t cFilterBatchSize = 4 * 1024;
+
     int32_t m_schema_id;
     uint64_t m_num_messages;
     uint64_t m_cur_message;
@@ -334,6 +376,10 @@ private:
     std::shared_ptr<search::Projection> m_projection;
 
     std::map<int32_t, std::pair<size_t, std::span<int32_t>>> m_global_id_to_unordered_object;
+
+    std::vector<uint8_t> m_filter_selection;
+    uint64_t m_filter_batch_begin{0};
+    uint64_t m_filter_batch_end{0};
 };
 }  // namespace clp_s
 
@@ -32,6 +32,12 @@ void SchemaWriter::store(ZstdCompressor& compressor) {
     }
 }
 
+void SchemaWriter::add_statistics(TableStatistics& statistics) const {
+    for (auto const* writer : m_columns) {
+        writer->add_statistics(statistics);
+    }
+}
+
 SchemaWriter::~SchemaWriter() {
     for (auto i : m_columns) {
         delete i;
@@ -6,6 +6,7 @@
 #include "ColumnWriter.hpp"
 #include "FileWriter.hpp"
 #include "ParsedMessage.hpp"
+#include "TableStatistics.hpp"
 #include "ZstdCompressor.hpp"
 
 namespace clp_s {
@@ -43,6 +44,12 @@ public:
      */
     void store(ZstdCompressor& compressor);
 
+    /**
+     * Records statistics about the values in each column.
+     * @param statistics
+     */
+    void add_statistics(TableStatistics& statistics) const;
+
     uint64_t get_num_messages() const { return m_num_messages; }
 
     /**
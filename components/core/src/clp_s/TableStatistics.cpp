@@ -0,0 +1,230 @@
+#include "TableStatistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "BloomFilter.hpp"
+#include "ErrorCode.hpp"
+#include "ZstdCompressor.hpp"
+#include "ZstdDecompressor.hpp"
+
+namespace clp_s {
+void TableStatistics::add_integer_column(int32_t column_id, std::span<int64_t const> values) {
+    if (values.empty()) {
+        return;
+    }
+    auto const [min_it, max_it] = std::minmax_element(values.begin(), values.end());
+    add_column(column_id, IntegerRange{*min_it, *max_it});
+}
+
+void TableStatistics::add_float_column(int32_t column_id, std::span<double const> values) {
+    if (values.empty()) {
+        return;
+    }
+    if (std::any_of(values.begin(), values.end(), [](double value) { return std::isnan(value); }))
+    {
+        add_column(column_id, std::monostate{});
+        return;
+    }
+    auto const [min_it, max_it] = std::minmax_element(values.begin(), values.end());
+    add_column(column_id, FloatRange{*min_it, *max_it});
+}
+
+void TableStatistics::add_clp_string_column(
+        int32_t column_id,
+        std::vector<uint64_t> logtype_ids,
+        std::vector<uint64_t> encoded_vars
+) {
+    auto const values_size_in_bytes = (logtype_ids.size() + encoded_vars.size()) * sizeof(uint64_t);
+    sort_and_deduplicate(logtype_ids);
+    sort_and_deduplicate(encoded_vars);
+    auto const filters_size_in_bytes = BloomFilter::get_size_in_bytes(logtype_ids.size())
+                                       + BloomFilter::get_size_in_bytes(encoded_vars.size());
+    if (false == fits_size_cap(filters_size_in_bytes, values_size_in_bytes)) {
+        add_column(column_id, std::monostate{});
+        return;
+    }
+
+    ClpStringIds ids{
+            .logtype_ids = BloomFilter{logtype_ids.size()},
+            .encoded_vars = BloomFilter{encoded_vars.size()}
+    };
+    for (auto const logtype_id : logtype_ids) {
+        ids.logtype_ids.add(logtype_id);
+    }
+    for (auto const encoded_var : encoded_vars) {
+        ids.encoded_vars.add(encoded_var);
+    }
+    add_column(column_id, std::move(ids));
+}
+
+void TableStatistics::add_var_string_column(int32_t column_id, std::vector<uint64_t> var_ids) {
+    auto const values_size_in_bytes = var_ids.size() * sizeof(uint64_t);
+    sort_and_deduplicate(var_ids);
+    auto const filter_size_in_bytes = BloomFilter::get_size_in_bytes(var_ids.size());
+    if (false == fits_size_cap(filter_size_in_bytes, values_size_in_bytes)) {
+        add_column(column_id, std::monostate{});
+        return;
+    }
+
+    VarStringIds ids{.var_ids = BloomFilter{var_ids.size()}};
+    for (auto const var_id : var_ids) {
+        ids.var_ids.add(var_id);
+    }
+    add_column(column_id, std::move(ids));
+}
+
+auto TableStatistics::get_column_statistics(int32_t column_id) const -> ColumnStatistics const* {
+    auto const it = m_column_statistics.find(column_id);
+    if (m_column_statistics.end() == it || std::holds_alternative<std::monostate>(it->second)) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+void TableStatistics::write(ZstdCompressor& compressor) const {
+    uint64_t const num_columns = std::count_if(
+            m_column_statistics.begin(),
+            m_column_statistics.end(),
+            [](auto const& entry) {
+                return false == std::holds_alternative<std::monostate>(entry.second);
+            }
+    );
+    compressor.write_numeric_value(num_columns);
+    for (auto const& [column_id, statistics] : m_column_statistics) {
+        if (auto const* range = std::get_if<IntegerRange>(&statistics); nullptr != range) {
+            compressor.write_numeric_value(column_id);
+            compressor.write_numeric_value(StatisticsType::IntegerRange);
+            compressor.write_numeric_value(range->min);
+            compressor.write_numeric_value(range->max);
+        } else if (auto const* range = std::get_if<FloatRange>(&statistics); nullptr != range) {
+            compressor.write_numeric_value(column_id);
+            compressor.write_numeric_value(StatisticsType::FloatRange);
+            compressor.write_numeric_value(range->min);
+            compressor.write_numeric_value(range->max);
+        } else if (auto const* ids = std::get_if<ClpStringIds>(&statistics); nullptr != ids) {
+            compressor.write_numeric_value(column_id);
+            compressor.write_numeric_value(StatisticsType::ClpStringIds);
+            ids->logtype_ids.write(compressor);
+            ids->encoded_vars.write(compressor);
+        } else if (auto const* ids = std::get_if<VarStringIds>(&statistics); nullptr != ids) {
+            compressor.write_numeric_value(column_id);
+            compressor.write_numeric_value(StatisticsType::VarStringIds);
+            ids->var_ids.write(compressor);
+        }
+    }
+}
+
+auto TableStatistics::try_read(ZstdDecompressor& decompressor) -> ErrorCode {
+    m_column_statistics.clear();
+
+    uint64_t num_columns{};
+    if (auto const rc = decompressor.try_read_numeric_value(num_columns); ErrorCodeSuccess != rc) {
+        return rc;
+    }
+    for (uint64_t i = 0; i < num_columns; ++i) {
+        int32_t column_id{};
+        StatisticsType type{};
+        if (auto const rc = decompressor.try_read_numeric_value(column_id); ErrorCodeSuccess != rc)
+        {
+            return rc;
+        }
+        if (auto const rc = decompressor.try_read_numeric_value(type); ErrorCodeSuccess != rc) {
+            return rc;
+        }
+
+        ErrorCode rc{ErrorCodeSuccess};
+        switch (type) {
+            case StatisticsType::IntegerRange: {
+                IntegerRange range;
+                rc = decompressor.try_read_numeric_value(range.min);
+                if (ErrorCodeSuccess == rc) {
+                    rc = decompressor.try_read_numeric_value(range.max);
+                }
+                m_column_statistics.emplace(column_id, range);
+                break;
+            }
+            case StatisticsType::FloatRange: {
+                FloatRange range;
+                rc = decompressor.try_read_numeric_value(range.min);
+                if (ErrorCodeSuccess == rc) {
+                    rc = decompressor.try_read_numeric_value(range.max);
+                }
+                m_column_statistics.emplace(column_id, range);
+                break;
+            }
+            case StatisticsType::ClpStringIds: {
+                ClpStringIds ids;
+                rc = ids.logtype_ids.try_read(decompressor);
+                if (ErrorCodeSuccess == rc) {
+                    rc = ids.encoded_vars.try_read(decompressor);
+                }
+                m_column_statistics.emplace(column_id, std::move(ids));
+                break;
+            }
+            case StatisticsType::VarStringIds: {
+                VarStringIds ids;
+                rc = ids.var_ids.try_read(decompressor);
+                m_column_statistics.emplace(column_id, std::move(ids));
+                break;
+            }
+            default:
+                return ErrorCodeCorrupt;
+        }
+        if (ErrorCodeSuccess != rc) {
+            return rc;
+        }
+    }
+    return ErrorCodeSuccess;
+}
+
+auto TableStatistics::get_size_in_bytes() const -> size_t {
+    size_t size_in_bytes{0};
+    for (auto const& [column_id, statistics] : m_column_statistics) {
+        size_in_bytes += sizeof(column_id) + sizeof(statistics);
+        if (auto const* ids = std::get_if<ClpStringIds>(&statistics); nullptr != ids) {
+            size_in_bytes += ids->logtype_ids.get_size_in_bytes()
+                             + ids->encoded_vars.get_size_in_bytes();
+        } else if (auto const* ids = std::get_if<VarStringIds>(&statistics); nullptr != ids) {
+            size_in_bytes += ids->var_ids.get_size_in_bytes();
+        }
+    }
+    return size_in_bytes;
+}
+
+void TableStatistics::add_column(int32_t column_id, ColumnStatistics statistics) {
+    auto const [it, inserted] = m_column_statistics.try_emplace(column_id, std::move(statistics));
+    if (inserted) {
+        return;
+    }
+
+    // Ranges can be merged, but bloom filters of different sizes can't
+    auto& existing = it->second;
+    auto* existing_int_range = std::get_if<IntegerRange>(&existing);
+    auto const* int_range = std::get_if<IntegerRange>(&statistics);
+    if (nullptr != existing_int_range && nullptr != int_range) {
+        existing_int_range->min = std::min(existing_int_range->min, int_range->min);
+        existing_int_range->max = std::max(existing_int_range->max, int_range->max);
+        return;
+    }
+    auto* existing_float_range = std::get_if<FloatRange>(&existing);
+    auto const* float_range = std::get_if<FloatRange>(&statistics);
+    if (nullptr != existing_float_range && nullptr != float_range) {
+        existing_float_range->min = std::min(existing_float_range->min, float_range->min);
+        existing_float_range->max = std::max(existing_float_range->max, float_range->max);
+        return;
+    }
+    existing = std::monostate{};
+}
+
+void TableStatistics::sort_and_deduplicate(std::vector<uint64_t>& values) {
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+}  // namespace clp_s
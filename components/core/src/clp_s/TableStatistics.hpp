@@ -0,0 +1,164 @@
+#ifndef CLP_S_TABLESTATISTICS_HPP
+#define CLP_S_TABLESTATISTICS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <span>
+#include <variant>
+#include <vector>
+
+#include "BloomFilter.hpp"
+#include "ErrorCode.hpp"
+#include "ZstdCompressor.hpp"
+#include "ZstdDecompressor.hpp"
+
+namespace clp_s {
+/**
+ * Statistics about the values stored in each column of a schema table. They're recorded when the
+ * table is compressed and let searches rule out tables that can't contain matches without reading
+ * them:
+ * - integer, float, and date string columns record the range of their values;
+ * - clp string columns record bloom filters over their logtype IDs and encoded variables;
+ * - variable string columns record a bloom filter over their variable dictionary IDs.
+ *
+ * A column ID can appear more than once in a table (e.g., within unordered objects), in which case
+ * the statistics describe every occurrence.
+ *
+ * A column's bloom filters may use at most 1/cMaxBloomFilterSizeRatio of the bytes its values take
+ * in the table, so the statistics only add a small fraction to the table's size. Columns whose
+ * filters would be larger (i.e., columns where more than about a fifth of the values are distinct)
+ * get no statistics.
+ */
+class TableStatistics {
+public:
+    // Types
+    struct IntegerRange {
+        int64_t min{};
+        int64_t max{};
+    };
+
+    struct FloatRange {
+        double min{};
+        double max{};
+    };
+
+    struct ClpStringIds {
+        BloomFilter logtype_ids;
+        BloomFilter encoded_vars;
+    };
+
+    struct VarStringIds {
+        BloomFilter var_ids;
+    };
+
+    // std::monostate marks columns that have no usable statistics
+    using ColumnStatistics
+            = std::variant<std::monostate, IntegerRange, FloatRange, ClpStringIds, VarStringIds>;
+
+    // Constants
+    static constexpr size_t cMaxBloomFilterSizeRatio{32};
+
+    // Methods
+    /**
+     * Records the statistics for an integer or date string column.
+     * @param column_id
+     * @param values
+     */
+    void add_integer_column(int32_t column_id, std::span<int64_t const> values);
+
+    /**
+     * Records the statistics for a float column. Columns containing NaNs get no statistics.
+     * @param column_id
+     * @param values
+     */
+    void add_float_column(int32_t column_id, std::span<double const> values);
+
+    /**
+     * Records the statistics for a clp string column, unless its bloom filters would exceed the size
+     * cap.
+     * @param column_id
+     * @param logtype_ids
+     * @param encoded_vars
+     */
+    void add_clp_string_column(
+            int32_t column_id,
+            std::vector<uint64_t> logtype_ids,
+            std::vector<uint64_t> encoded_vars
+    );
+
+    /**
+     * Records the statistics for a variable string column, unless its bloom filter would exceed the
+     * size cap.
+     * @param column_id
+     * @param var_ids
+     */
+    void add_var_string_column(int32_t column_id, std::vector<uint64_t> var_ids);
+
+    /**
+     * @param column_id
+     * @return The statistics recorded for the column, or nullptr if there are none
+     */
+    [[nodiscard]] auto get_column_statistics(int32_t column_id) const -> ColumnStatistics const*;
+
+    /**
+     * Writes the statistics to a compressor.
+     * @param compressor
+     */
+    void write(ZstdCompressor& compressor) const;
+
+    /**
+     * Reads statistics previously written with `write`.
+     * @param decompressor
+     * @return ErrorCodeSuccess on success
+     * @return ErrorCodeCorrupt if the serialized statistics are invalid
+     * @return Same as ZstdDecompressor::try_read_numeric_value on failure
+     */
+    [[nodiscard]] auto try_read(ZstdDecompressor& decompressor) -> ErrorCode;
+
+    /**
+     * @return An estimate of the number of bytes used by the statistics in memory
+     */
+    [[nodiscard]] auto get_size_in_bytes() const -> size_t;
+
+private:
+    // Types
+    enum class StatisticsType : uint8_t {
+        IntegerRange = 0,
+        FloatRange = 1,
+        ClpStringIds = 2,
+        VarStringIds = 3
+    };
+
+    // Methods
+    /**
+     * Records the statistics for a column, or marks the column as having no usable statistics if
+     * another occurrence of the column was already recorded and the two can't be merged.
+     * @param column_id
+     * @param statistics
+     */
+    void add_column(int32_t column_id, ColumnStatistics statistics);
+
+    /**
+     * @param filters_size_in_bytes
+     * @param values_size_in_bytes
+     * @return Whether bloom filters of the given size may be recorded for a column whose values
+     * take the given number of bytes
+     */
+    [[nodiscard]] static auto
+    fits_size_cap(size_t filters_size_in_bytes, size_t values_size_in_bytes) -> bool {
+        return filters_size_in_bytes * cMaxBloomFilterSizeRatio <= values_size_in_bytes;
+    }
+
+    /**
+     * Sorts and deduplicates values in place.
+     * @param values
+     */
+    static void sort_and_deduplicate(std::vector<uint64_t>& values);
+
+    // Variables
+    std::map<int32_t, ColumnStatistics> m_column_statistics;
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_TABLESTATISTICS_HPP
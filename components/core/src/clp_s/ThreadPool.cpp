@@ -0,0 +1,143 @@
+#include "ThreadPool.hpp"
+
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <utility>
+
+namespace clp_s {
+ThreadPool::ThreadPool(size_t num_threads) {
+    if (0 == num_threads) {
+        num_threads = 1;
+    }
+    m_workers.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        m_workers.emplace_back(&ThreadPool::run_worker, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard const lock{m_mutex};
+        m_is_stopping = true;
+    }
+    m_task_available_cv.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(Task task) {
+    {
+        std::lock_guard const lock{m_mutex};
+        m_tasks.push(std::move(task));
+        ++m_num_pending_tasks;
+    }
+    m_task_available_cv.notify_one();
+}
+
+void ThreadPool::wait(size_t max_pending_tasks) {
+    std::unique_lock lock{m_mutex};
+    m_task_completed_cv.wait(lock, [&] {
+        return m_num_pending_tasks <= max_pending_tasks || nullptr != m_task_exception;
+    });
+    if (nullptr != m_task_exception) {
+        // Wait for the tasks that are still running so that no task outlives the caller's state
+        m_task_completed_cv.wait(lock, [&] { return 0 == m_num_pending_tasks; });
+        std::exception_ptr task_exception;
+        std::swap(task_exception, m_task_exception);
+        std::rethrow_exception(task_exception);
+    }
+}
+
+void ThreadPool::run_worker(size_t worker_id) {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock lock{m_mutex};
+            m_task_available_cv.wait(lock, [&] {
+                return m_is_stopping || false == m_tasks.empty();
+            });
+            if (m_tasks.empty()) {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop();
+            if (nullptr != m_task_exception) {
+                // A previous task failed, so discard the remaining work
+                --m_num_pending_tasks;
+                m_task_completed_cv.notify_all();
+                continue;
+            }
+        }
+
+        std::exception_ptr task_exception;
+        try {
+            task(worker_id);
+        } catch (...) {
+            task_exception = std::current_exception();
+        }
+
+        {
+            std::lock_guard const lock{m_mutex};
+            if (nullptr != task_exception && nullptr == m_task_exception) {
+                m_task_exception = task_exception;
+            }
+            --m_num_pending_tasks;
+        }
+        m_task_completed_cv.notify_all();
+    }
+}
+
+TaskGroup::~TaskGroup() {
+    std::unique_lock lock{m_mutex};
+    m_task_completed_cv.wait(lock, [&] { return 0 == m_num_pending_tasks; });
+}
+
+void TaskGroup::submit(ThreadPool::Task task) {
+    {
+        std::lock_guard const lock{m_mutex};
+        ++m_num_pending_tasks;
+    }
+    m_thread_pool.submit([this, task = std::move(task)](size_t worker_id) {
+        bool should_skip{false};
+        {
+            std::lock_guard const lock{m_mutex};
+            // A previous task in the group failed, so discard the remaining work
+            should_skip = nullptr != m_task_exception;
+        }
+
+        std::exception_ptr task_exception;
+        if (false == should_skip) {
+            try {
+                task(worker_id);
+            } catch (...) {
+                task_exception = std::current_exception();
+            }
+        }
+
+        // Notify while holding the lock, since the group may be destroyed as soon as a waiter
+        // observes that its last task completed
+        std::lock_guard const lock{m_mutex};
+        if (nullptr != task_exception && nullptr == m_task_exception) {
+            m_task_exception = task_exception;
+        }
+        --m_num_pending_tasks;
+        m_task_completed_cv.notify_all();
+    });
+}
+
+void TaskGroup::wait(size_t max_pending_tasks) {
+    std::unique_lock lock{m_mutex};
+    m_task_completed_cv.wait(lock, [&] {
+        return m_num_pending_tasks <= max_pending_tasks || nullptr != m_task_exception;
+    });
+    if (nullptr != m_task_exception) {
+        // Wait for the tasks that are still running so that no task outlives the caller's state
+        m_task_completed_cv.wait(lock, [&] { return 0 == m_num_pending_tasks; });
+        std::exception_ptr task_exception;
+        std::swap(task_exception, m_task_exception);
+        std::rethrow_exception(task_exception);
+    }
+}
+}  // namespace clp_s
@@ -0,0 +1,123 @@
+#ifndef CLP_S_THREADPOOL_HPP
+#define CLP_S_THREADPOOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace clp_s {
+/**
+ * A fixed-size pool of worker threads that execute tasks in submission order.
+ *
+ * Each task is passed the index of the worker executing it so that callers can keep per-worker
+ * state (e.g., a reader or query runner) without additional synchronization. If a task throws, the
+ * remaining queued tasks are discarded and the first exception is rethrown by `wait`.
+ */
+class ThreadPool {
+public:
+    // Types
+    using Task = std::function<void(size_t worker_id)>;
+
+    // Constructors
+    explicit ThreadPool(size_t num_threads);
+
+    // Delete copy & move constructors and assignment operators
+    ThreadPool(ThreadPool const&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    auto operator=(ThreadPool const&) -> ThreadPool& = delete;
+    auto operator=(ThreadPool&&) -> ThreadPool& = delete;
+
+    // Destructor
+    ~ThreadPool();
+
+    // Methods
+    [[nodiscard]] auto get_num_threads() const -> size_t { return m_workers.size(); }
+
+    /**
+     * Queues a task for execution.
+     * @param task
+     */
+    void submit(Task task);
+
+    /**
+     * Blocks until at most `max_pending_tasks` tasks are queued or running. Passing a non-zero
+     * value allows a producer to bound the amount of work (and memory) that is in flight.
+     * @param max_pending_tasks
+     * @throw The first exception thrown by any task since the last call to `wait`.
+     */
+    void wait(size_t max_pending_tasks = 0);
+
+private:
+    // Methods
+    /**
+     * Executes tasks until the pool is destroyed.
+     * @param worker_id
+     */
+    void run_worker(size_t worker_id);
+
+    // Variables
+    std::vector<std::thread> m_workers;
+    std::queue<Task> m_tasks;
+    size_t m_num_pending_tasks{0};
+    bool m_is_stopping{false};
+    std::exception_ptr m_task_exception;
+
+    std::mutex m_mutex;
+    std::condition_variable m_task_available_cv;
+    std::condition_variable m_task_completed_cv;
+};
+
+/**
+ * A group of tasks executed by a ThreadPool that may be shared with other groups (e.g., the groups
+ * searching different archives concurrently). Waiting on a group only waits for its own tasks, and
+ * only rethrows exceptions thrown by its own tasks.
+ *
+ * If a task throws, the group's remaining queued tasks are skipped and the first exception is
+ * rethrown by `wait`. The destructor waits for the group's remaining tasks, so tasks may refer to
+ * state that outlives the group.
+ */
+class TaskGroup {
+public:
+    // Constructors
+    explicit TaskGroup(ThreadPool& thread_pool) : m_thread_pool{thread_pool} {}
+
+    // Delete copy & move constructors and assignment operators
+    TaskGroup(TaskGroup const&) = delete;
+    TaskGroup(TaskGroup&&) = delete;
+    auto operator=(TaskGroup const&) -> TaskGroup& = delete;
+    auto operator=(TaskGroup&&) -> TaskGroup& = delete;
+
+    // Destructor
+    ~TaskGroup();
+
+    // Methods
+    /**
+     * Queues a task for execution by the thread pool.
+     * @param task
+     */
+    void submit(ThreadPool::Task task);
+
+    /**
+     * Blocks until at most `max_pending_tasks` of the group's tasks are queued or running.
+     * @param max_pending_tasks
+     * @throw The first exception thrown by any of the group's tasks since the last call to `wait`.
+     */
+    void wait(size_t max_pending_tasks = 0);
+
+private:
+    // Variables
+    ThreadPool& m_thread_pool;
+    size_t m_num_pending_tasks{0};
+    std::exception_ptr m_task_exception;
+
+    std::mutex m_mutex;
+    std::condition_variable m_task_completed_cv;
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_THREADPOOL_HPP
@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <spdlog/spdlog.h>
 #include <zstd.h>
@@ -80,9 +81,31 @@ public:
      */
     void open(FileWriter& file_writer, int compression_level = cDefaultCompressionLevel);
 
+    /**
+     * Initialize streaming compressor to append compressed data to an in-memory buffer
+     * @param compressed_buf
+     * @param compression_level
+     */
+    void open(std::vector<char>& compressed_buf, int compression_level = cDefaultCompressionLevel);
+
 private:
+    // Methods
+    /**
+     * Initializes the compression stream
+     * @param compression_level
+     */
+    void init_compression_stream(int compression_level);
+
+    /**
+     * Writes compressed data to the configured destination
+     * @param data
+     * @param data_length
+     */
+    void write_compressed_data(char const* data, size_t data_length);
+
     // Variables
     FileWriter* m_compressed_stream_file_writer{};
+    std::vector<char>* m_compressed_stream_buf{};
 
     // Compressed stream variables
     ZSTD_CStream* m_compression_stream;
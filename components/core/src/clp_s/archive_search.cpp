@@ -0,0 +1,295 @@
+#include "archive_search.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "../clp/type_utils.hpp"
+#include "ArchiveMetadataCache.hpp"
+#include "ArchiveReader.hpp"
+#include "Defs.hpp"
+#include "ErrorCode.hpp"
+#include "InputConfig.hpp"
+#include "search/AddTimestampConditions.hpp"
+#include "search/ast/ColumnDescriptor.hpp"
+#include "search/ast/ConvertToExists.hpp"
+#include "search/ast/EmptyExpr.hpp"
+#include "search/ast/Expression.hpp"
+#include "search/ast/NarrowTypes.hpp"
+#include "search/ast/OrOfAndForm.hpp"
+#include "search/ast/SearchUtils.hpp"
+#include "search/EvaluateTimestampIndex.hpp"
+#include "search/Output.hpp"
+#include "search/OutputHandler.hpp"
+#include "search/Projection.hpp"
+#include "search/SchemaMatch.hpp"
+#include "ThreadPool.hpp"
+
+using clp_s::search::AddTimestampConditions;
+using clp_s::search::EvaluateTimestampIndex;
+using clp_s::search::Output;
+using clp_s::search::OutputHandler;
+using clp_s::search::Projection;
+using clp_s::search::ProjectionMode;
+using clp_s::search::SchemaMatch;
+using clp_s::search::SharedOutputHandler;
+
+namespace ast = clp_s::search::ast;
+
+namespace clp_s {
+namespace {
+/**
+ * Normalizes the search AST with the passes that don't depend on the archive being searched.
+ * @param query
+ * @param expr The search AST, which may be modified
+ * @return The normalized search AST, or nullptr if the query is logically false
+ */
+auto normalize_query(std::string const& query, std::shared_ptr<ast::Expression> expr)
+        -> std::shared_ptr<ast::Expression>;
+
+/**
+ * Searches the given archive.
+ * @param option
+ * @param query
+ * @param archive_reader
+ * @param expr A copy of the normalized search AST which may be modified
+ * @param output_handler
+ * @param thread_pool The thread pool used to search tables in parallel. May be nullptr.
+ * @return Whether the search succeeded
+ */
+auto search_archive(
+        ArchiveSearchOption const& option,
+        std::string const& query,
+        std::shared_ptr<ArchiveReader> const& archive_reader,
+        std::shared_ptr<ast::Expression> expr,
+        std::unique_ptr<OutputHandler> output_handler,
+        std::shared_ptr<ThreadPool> const& thread_pool
+) -> bool;
+
+auto normalize_query(std::string const& query, std::shared_ptr<ast::Expression> expr)
+        -> std::shared_ptr<ast::Expression> {
+    ast::OrOfAndForm standardize_pass;
+    if (expr = standardize_pass.run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
+        SPDLOG_ERROR("Query '{}' is logically false", query);
+        return nullptr;
+    }
+
+    ast::NarrowTypes narrow_pass;
+    if (expr = narrow_pass.run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
+        SPDLOG_ERROR("Query '{}' is logically false", query);
+        return nullptr;
+    }
+
+    ast::ConvertToExists convert_pass;
+    if (expr = convert_pass.run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
+        SPDLOG_ERROR("Query '{}' is logically false", query);
+        return nullptr;
+    }
+    return expr;
+}
+
+auto search_archive(
+        ArchiveSearchOption const& option,
+        std::string const& query,
+        std::shared_ptr<ArchiveReader> const& archive_reader,
+        std::shared_ptr<ast::Expression> expr,
+        std::unique_ptr<OutputHandler> output_handler,
+        std::shared_ptr<ThreadPool> const& thread_pool
+) -> bool {
+    auto timestamp_dict = archive_reader->get_timestamp_dictionary();
+    AddTimestampConditions add_timestamp_conditions(
+            timestamp_dict->get_authoritative_timestamp_tokenized_column(),
+            option.begin_ts,
+            option.end_ts
+    );
+    if (expr = add_timestamp_conditions.run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr))
+    {
+        SPDLOG_ERROR(
+                "Query '{}' specified timestamp filters tge {} tle {}, but no authoritative "
+                "timestamp column was found for this archive",
+                query,
+                option.begin_ts.value_or(cEpochTimeMin),
+                option.end_ts.value_or(cEpochTimeMax)
+        );
+        return false;
+    }
+
+    // The query was normalized once for every archive, so only the timestamp conditions added for
+    // this archive need to be normalized
+    if (option.begin_ts.has_value() || option.end_ts.has_value()) {
+        if (expr = normalize_query(query, expr); nullptr == expr) {
+            return false;
+        }
+    }
+
+    // skip decompressing the archive if we won't match based on
+    // the timestamp index
+    EvaluateTimestampIndex timestamp_index(timestamp_dict);
+    if (EvaluatedValue::False == timestamp_index.run(expr)) {
+        SPDLOG_INFO("No matching timestamp ranges for query '{}'", query);
+        return true;
+    }
+
+    // Narrow against schemas
+    auto match_pass = std::make_shared<SchemaMatch>(
+            archive_reader->get_schema_tree(),
+            archive_reader->get_schema_map()
+    );
+    if (expr = match_pass->run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
+        SPDLOG_INFO("No matching schemas for query '{}'", query);
+        return true;
+    }
+
+    // Populate projection
+    auto projection = std::make_shared<Projection>(
+            option.projection_columns.empty() ? ProjectionMode::ReturnAllColumns
+                                              : ProjectionMode::ReturnSelectedColumns
+    );
+    try {
+        for (auto const& column : option.projection_columns) {
+            std::vector<std::string> descriptor_tokens;
+            std::string descriptor_namespace;
+            if (false
+                == ast::tokenize_column_descriptor(
+                        column,
+                        descriptor_tokens,
+                        descriptor_namespace
+                ))
+            {
+                SPDLOG_ERROR("Can not tokenize invalid column: \"{}\"", column);
+                return false;
+            }
+            projection->add_column(
+                    ast::ColumnDescriptor::create_from_escaped_tokens(
+                            descriptor_tokens,
+                            descriptor_namespace
+                    )
+            );
+        }
+    } catch (std::exception const& e) {
+        SPDLOG_ERROR("{}", e.what());
+        return false;
+    }
+    projection->resolve_columns(archive_reader->get_schema_tree());
+    archive_reader->set_projection(projection);
+
+    // output result
+    Output output(
+            match_pass,
+            expr,
+            archive_reader,
+            std::move(output_handler),
+            option.ignore_case,
+            option.num_threads,
+            thread_pool
+    );
+    return output.filter();
+}
+}  // namespace
+
+auto search_archives(
+        ArchiveSearchOption const& option,
+        std::string const& query,
+        std::shared_ptr<ast::Expression> const& expr,
+        std::vector<Path> const& archive_paths,
+        std::shared_ptr<ArchiveMetadataCache> const& metadata_cache,
+        std::unique_ptr<OutputHandler> output_handler
+) -> bool {
+    if (archive_paths.empty()) {
+        return true;
+    }
+
+    auto const normalized_expr = normalize_query(query, expr->copy());
+    if (nullptr == normalized_expr) {
+        return false;
+    }
+
+    SharedOutputHandler shared_output_handler{std::move(output_handler), option.max_num_results};
+
+    std::shared_ptr<ThreadPool> table_thread_pool;
+    if (option.num_threads > 1) {
+        table_thread_pool = std::make_shared<ThreadPool>(option.num_threads);
+    }
+
+    // The metadata cache isn't thread-safe, so archives that use it are opened one at a time
+    std::mutex metadata_cache_mutex;
+    auto const search_one_archive = [&](Path const& archive_path) -> bool {
+        auto archive_reader = std::make_shared<ArchiveReader>();
+        archive_reader->set_metadata_cache(metadata_cache);
+        try {
+            std::unique_lock<std::mutex> metadata_cache_lock{metadata_cache_mutex, std::defer_lock};
+            if (nullptr != metadata_cache) {
+                metadata_cache_lock.lock();
+            }
+            archive_reader->open(archive_path, option.network_auth);
+        } catch (std::exception const& e) {
+            SPDLOG_ERROR("Failed to open archive - {}", e.what());
+            return false;
+        }
+        if (false
+            == search_archive(
+                    option,
+                    query,
+                    archive_reader,
+                    normalized_expr->copy(),
+                    shared_output_handler.create_view(),
+                    table_thread_pool
+            ))
+        {
+            return false;
+        }
+        archive_reader->close();
+        return true;
+    };
+
+    auto const num_concurrent_archives
+            = std::min(option.num_concurrent_archives, archive_paths.size());
+    if (num_concurrent_archives <= 1) {
+        for (auto const& archive_path : archive_paths) {
+            if (shared_output_handler.is_result_limit_reached()) {
+                break;
+            }
+            if (false == search_one_archive(archive_path)) {
+                return false;
+            }
+        }
+    } else {
+        // Each archive is searched by one of these threads, which reads the archive's packed
+        // streams while the shared table thread pool filters them. The table work can't be queued
+        // on this pool since its tasks would block waiting for tasks queued behind them.
+        std::atomic<bool> has_failed{false};
+        ThreadPool archive_thread_pool{num_concurrent_archives};
+        for (auto const& archive_path : archive_paths) {
+            archive_thread_pool.submit([&](size_t) {
+                if (has_failed.load() || shared_output_handler.is_result_limit_reached()) {
+                    return;
+                }
+                if (false == search_one_archive(archive_path)) {
+                    has_failed.store(true);
+                }
+            });
+        }
+        archive_thread_pool.wait();
+        if (has_failed.load()) {
+            return false;
+        }
+    }
+
+    auto const ecode = shared_output_handler.finish();
+    if (ErrorCode::ErrorCodeSuccess != ecode) {
+        SPDLOG_ERROR(
+                "Failed to finish output handler, error={}.",
+                clp::enum_to_underlying_type(ecode)
+        );
+        return false;
+    }
+    return true;
+}
+}  // namespace clp_s
@@ -0,0 +1,57 @@
+#ifndef CLP_S_ARCHIVE_SEARCH_HPP
+#define CLP_S_ARCHIVE_SEARCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "ArchiveMetadataCache.hpp"
+#include "Defs.hpp"
+#include "InputConfig.hpp"
+#include "search/ast/Expression.hpp"
+#include "search/OutputHandler.hpp"
+
+namespace clp_s {
+struct ArchiveSearchOption {
+    // Only records with an authoritative timestamp in [begin_ts, end_ts] match
+    std::optional<epochtime_t> begin_ts{std::nullopt};
+    std::optional<epochtime_t> end_ts{std::nullopt};
+    std::vector<std::string> projection_columns;
+    bool ignore_case{false};
+    // The number of threads that search the tables of the archives
+    size_t num_threads{1};
+    size_t num_concurrent_archives{1};
+    // The maximum number of results to output, or 0 for no limit
+    uint64_t max_num_results{0};
+    NetworkAuthOption network_auth{};
+};
+
+/**
+ * Searches the given archives with a query that's normalized once for all of them. Up to
+ * `num_concurrent_archives` archives are searched at a time, and their tables are searched by a
+ * thread pool shared between them. Results from every archive go to the given output handler,
+ * which is finished once every archive has been searched, and the search stops early once
+ * `max_num_results` results have been output.
+ * @param option
+ * @param query
+ * @param expr The search AST
+ * @param archive_paths
+ * @param metadata_cache The cache of decoded archive metadata, or nullptr. Archives are opened one at
+ * a time when it's used, since it isn't thread-safe.
+ * @param output_handler
+ * @return Whether the search succeeded
+ */
+[[nodiscard]] auto search_archives(
+        ArchiveSearchOption const& option,
+        std::string const& query,
+        std::shared_ptr<search::ast::Expression> const& expr,
+        std::vector<Path> const& archive_paths,
+        std::shared_ptr<ArchiveMetadataCache> const& metadata_cache,
+        std::unique_ptr<search::OutputHandler> output_handler
+) -> bool;
+}  // namespace clp_s
+
+#endif  // CLP_S_ARCHIVE_SEARCH_HPP
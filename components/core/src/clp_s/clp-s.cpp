@@ -1,3 +1,4 @@
+#include <cstddef>
 #include <cstdlib>
 #include <exception>
 #include <filesystem>
@@ -7,6 +8,7 @@
 #include <string>
 #include <system_error>
 #include <utility>
+#include <vector>
 
 #include <mongocxx/instance.hpp>
 #include <nlohmann/json.hpp>
@@ -17,31 +19,23 @@
 #include "../clp/ir/constants.hpp"
 #include "../clp/streaming_archive/ArchiveMetadata.hpp"
 #include "../reducer/network_utils.hpp"
+#include "archive_search.hpp"
+#include "ArchiveMetadataCache.hpp"
 #include "CommandLineArguments.hpp"
 #include "Defs.hpp"
+#include "InputConfig.hpp"
 #include "JsonConstructor.hpp"
 #include "JsonParser.hpp"
 #include "kv_ir_search.hpp"
-#include "search/AddTimestampConditions.hpp"
-#include "search/ast/ConvertToExists.hpp"
 #include "search/ast/EmptyExpr.hpp"
 #include "search/ast/Expression.hpp"
-#include "search/ast/NarrowTypes.hpp"
-#include "search/ast/OrOfAndForm.hpp"
-#include "search/ast/SearchUtils.hpp"
-#include "search/EvaluateTimestampIndex.hpp"
 #include "search/kql/kql.hpp"
-#include "search/Output.hpp"
 #include "search/OutputHandler.hpp"
-#include "search/Projection.hpp"
-#include "search/SchemaMatch.hpp"
 #include "TimestampPattern.hpp"
 #include "Utils.hpp"
 
 using namespace clp_s::search;
 using clp_s::cArchiveFormatDevelopmentVersionFlag;
-using clp_s::cEpochTimeMax;
-using clp_s::cEpochTimeMin;
 using clp_s::CommandLineArguments;
 using clp_s::KvIrSearchError;
 using clp_s::KvIrSearchErrorEnum;
@@ -62,20 +56,47 @@ bool compress(CommandLineArguments const& command_line_arguments);
 void decompress_archive(clp_s::JsonConstructorOption const& json_constructor_option);
 
 /**
- * Searches the given archive.
+ * Creates the output handler specified by the command line arguments.
  * @param command_line_arguments
- * @param archive_reader
- * @param expr A copy of the search AST which may be modified
+ * @param reducer_socket_fd
+ * @return The output handler, or nullptr on failure
+ */
+std::unique_ptr<OutputHandler>
+create_output_handler(CommandLineArguments const& command_line_arguments, int reducer_socket_fd);
+
+/**
+ * Parses a KQL query.
+ * @param query
+ * @return The search AST, or nullptr if the query is invalid or logically false
+ */
+std::shared_ptr<ast::Expression> parse_query(std::string const& query);
+
+/**
+ * Searches the inputs specified by the command line arguments.
+ * @param command_line_arguments
+ * @param query
+ * @param expr The search AST
+ * @param metadata_cache The cache of decoded archive metadata. May be nullptr.
  * @param reducer_socket_fd
  * @return Whether the search succeeded
  */
-bool search_archive(
+bool search(
         CommandLineArguments const& command_line_arguments,
-        std::shared_ptr<clp_s::ArchiveReader> const& archive_reader,
-        std::shared_ptr<ast::Expression> expr,
+        std::string const& query,
+        std::shared_ptr<ast::Expression> const& expr,
+        std::shared_ptr<clp_s::ArchiveMetadataCache> const& metadata_cache,
         int reducer_socket_fd
 );
 
+/**
+ * Searches the inputs specified by the command line arguments for each query read from stdin, one
+ * query per line, until stdin is exhausted. The decoded metadata and dictionaries of the archives
+ * are cached between queries, so repeated queries against the same archives skip reading them.
+ * When outputting to stdout, each query's results are followed by an empty line.
+ * @param command_line_arguments
+ */
+void serve_queries_from_stdin(CommandLineArguments const& command_line_arguments);
+
 bool compress(CommandLineArguments const& command_line_arguments) {
     auto archives_dir = std::filesystem::path(command_line_arguments.get_archives_dir());
 
@@ -99,6 +120,7 @@ bool compress(CommandLineArguments const& command_line_arguments) {
     option.target_encoded_size = command_line_arguments.get_target_encoded_size();
     option.max_document_size = command_line_arguments.get_max_document_size();
     option.min_table_size = command_line_arguments.get_minimum_table_size();
+    option.num_threads = command_line_arguments.get_num_compression_threads();
     option.compression_level = command_line_arguments.get_compression_level();
     option.timestamp_key = command_line_arguments.get_timestamp_key();
     option.print_archive_stats = command_line_arguments.print_archive_stats();
@@ -127,153 +149,183 @@ void decompress_archive(clp_s::JsonConstructorOption const& json_constructor_opt
     constructor.store();
 }
 
-bool search_archive(
-        CommandLineArguments const& command_line_arguments,
-        std::shared_ptr<clp_s::ArchiveReader> const& archive_reader,
-        std::shared_ptr<ast::Expression> expr,
-        int reducer_socket_fd
-) {
-    auto const& query = command_line_arguments.get_query();
-
-    auto timestamp_dict = archive_reader->get_timestamp_dictionary();
-    AddTimestampConditions add_timestamp_conditions(
-            timestamp_dict->get_authoritative_timestamp_tokenized_column(),
-            command_line_arguments.get_search_begin_ts(),
-            command_line_arguments.get_search_end_ts()
-    );
-    if (expr = add_timestamp_conditions.run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr))
-    {
-        SPDLOG_ERROR(
-                "Query '{}' specified timestamp filters tge {} tle {}, but no authoritative "
-                "timestamp column was found for this archive",
-                query,
-                command_line_arguments.get_search_begin_ts().value_or(cEpochTimeMin),
-                command_line_arguments.get_search_end_ts().value_or(cEpochTimeMax)
-        );
-        return false;
-    }
-
-    ast::OrOfAndForm standardize_pass;
-    if (expr = standardize_pass.run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
-        SPDLOG_ERROR("Query '{}' is logically false", query);
-        return false;
-    }
-
-    ast::NarrowTypes narrow_pass;
-    if (expr = narrow_pass.run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
-        SPDLOG_ERROR("Query '{}' is logically false", query);
-        return false;
-    }
-
-    ast::ConvertToExists convert_pass;
-    if (expr = convert_pass.run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
-        SPDLOG_ERROR("Query '{}' is logically false", query);
-        return false;
-    }
-
-    // skip decompressing the archive if we won't match based on
-    // the timestamp index
-    EvaluateTimestampIndex timestamp_index(timestamp_dict);
-    if (clp_s::EvaluatedValue::False == timestamp_index.run(expr)) {
-        SPDLOG_INFO("No matching timestamp ranges for query '{}'", query);
-        return true;
-    }
-
-    // Narrow against schemas
-    auto match_pass = std::make_shared<SchemaMatch>(
-            archive_reader->get_schema_tree(),
-            archive_reader->get_schema_map()
-    );
-    if (expr = match_pass->run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
-        SPDLOG_INFO("No matching schemas for query '{}'", query);
-        return true;
-    }
-
-    // Populate projection
-    auto projection = std::make_shared<Projection>(
-            command_line_arguments.get_projection_columns().empty()
-                    ? ProjectionMode::ReturnAllColumns
-                    : ProjectionMode::ReturnSelectedColumns
-    );
-    try {
-        for (auto const& column : command_line_arguments.get_projection_columns()) {
-            std::vector<std::string> descriptor_tokens;
-            std::string descriptor_namespace;
-            if (false
-                == clp_s::search::ast::tokenize_column_descriptor(
-                        column,
-                        descriptor_tokens,
-                        descriptor_namespace
-                ))
-            {
-                SPDLOG_ERROR("Can not tokenize invalid column: \"{}\"", column);
-                return false;
-            }
-            projection->add_column(
-                    ast::ColumnDescriptor::create_from_escaped_tokens(
-                            descriptor_tokens,
-                            descriptor_namespace
-                    )
-            );
-        }
-    } catch (std::exception const& e) {
-        SPDLOG_ERROR("{}", e.what());
-        return false;
-    }
-    projection->resolve_columns(archive_reader->get_schema_tree());
-    archive_reader->set_projection(projection);
-
-    std::unique_ptr<OutputHandler> output_handler;
+std::unique_ptr<OutputHandler>
+create_output_handler(CommandLineArguments const& command_line_arguments, int reducer_socket_fd) {
     try {
         switch (command_line_arguments.get_output_handler_type()) {
             case CommandLineArguments::OutputHandlerType::Network:
-                output_handler = std::make_unique<NetworkOutputHandler>(
+                return std::make_unique<NetworkOutputHandler>(
                         command_line_arguments.get_network_dest_host(),
                         command_line_arguments.get_network_dest_port()
                 );
-                break;
             case CommandLineArguments::OutputHandlerType::Reducer:
                 if (command_line_arguments.do_count_results_aggregation()) {
-                    output_handler = std::make_unique<CountOutputHandler>(reducer_socket_fd);
-                } else if (command_line_arguments.do_count_by_time_aggregation()) {
-                    output_handler = std::make_unique<CountByTimeOutputHandler>(
+                    return std::make_unique<CountOutputHandler>(reducer_socket_fd);
+                }
+                if (command_line_arguments.do_count_by_time_aggregation()) {
+                    return std::make_unique<CountByTimeOutputHandler>(
                             reducer_socket_fd,
                             command_line_arguments.get_count_by_time_bucket_size()
                     );
-                } else {
-                    SPDLOG_ERROR("Unhandled aggregation type.");
-                    return false;
                 }
-                break;
+                SPDLOG_ERROR("Unhandled aggregation type.");
+                return nullptr;
             case CommandLineArguments::OutputHandlerType::ResultsCache:
-                output_handler = std::make_unique<ResultsCacheOutputHandler>(
+                return std::make_unique<ResultsCacheOutputHandler>(
                         command_line_arguments.get_mongodb_uri(),
                         command_line_arguments.get_mongodb_collection(),
                         command_line_arguments.get_batch_size(),
                         command_line_arguments.get_max_num_results()
                 );
-                break;
             case CommandLineArguments::OutputHandlerType::Stdout:
-                output_handler = std::make_unique<StandardOutputHandler>();
-                break;
+                return std::make_unique<StandardOutputHandler>();
             default:
                 SPDLOG_ERROR("Unhandled OutputHandlerType.");
-                return false;
+                return nullptr;
         }
     } catch (std::exception const& e) {
         SPDLOG_ERROR("Failed to create output handler - {}", e.what());
-        return false;
+        return nullptr;
+    }
+}
+
+std::shared_ptr<ast::Expression> parse_query(std::string const& query) {
+    auto query_stream = std::istringstream(query);
+    auto expr = kql::parse_kql_expression(query_stream);
+    if (nullptr == expr) {
+        return nullptr;
+    }
+
+    if (std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
+        SPDLOG_ERROR("Query '{}' is logically false", query);
+        return nullptr;
+    }
+    return expr;
+}
+
+bool search(
+        CommandLineArguments const& command_line_arguments,
+        std::string const& query,
+        std::shared_ptr<ast::Expression> const& expr,
+        std::shared_ptr<clp_s::ArchiveMetadataCache> const& metadata_cache,
+        int reducer_socket_fd
+) {
+    std::vector<clp_s::Path> archive_paths;
+    for (auto const& input_path : command_line_arguments.get_input_paths()) {
+        if (std::string::npos != input_path.path.find(clp::ir::cIrFileExtension)) {
+            auto const result{clp_s::search_kv_ir_stream(
+                    input_path,
+                    command_line_arguments,
+                    expr->copy(),
+                    reducer_socket_fd
+            )};
+            if (false == result.has_error()) {
+                continue;
+            }
+
+            auto const error{result.error()};
+            if (std::errc::result_out_of_range == error) {
+                // To support real-time search, we will allow incomplete IR streams.
+                // TODO: Use dedicated error code for this case once issue #904 is resolved.
+                SPDLOG_WARN("IR stream `{}` is truncated", input_path.path);
+                continue;
+            }
+
+            if (KvIrSearchError{KvIrSearchErrorEnum::ProjectionSupportNotImplemented} == error
+                || KvIrSearchError{KvIrSearchErrorEnum::UnsupportedOutputHandlerType} == error
+                || KvIrSearchError{KvIrSearchErrorEnum::CountSupportNotImplemented} == error)
+            {
+                // These errors are treated as non-fatal because they result from unsupported
+                // features. However, this approach may cause archives with this extension to be
+                // skipped if the search uses advanced features that are not yet implemented. To
+                // mitigate this, we log a warning and proceed to search the input as an
+                // archive.
+                SPDLOG_WARN(
+                        "Attempted to search an IR stream using unsupported features. Falling"
+                        " back to searching the input as an archive."
+                );
+            } else if (KvIrSearchError{KvIrSearchErrorEnum::DeserializerCreationFailure}
+                       != error)
+            {
+                // If the error is `DeserializerCreationFailure`, we may continue to treat the
+                // input as an archive and retry. Otherwise, it should be considered as a
+                // non-recoverable failure and return directly.
+                SPDLOG_ERROR(
+                        "Failed to search '{}' as an IR stream, error_category={}, error={}",
+                        input_path.path,
+                        error.category().name(),
+                        error.message()
+                );
+                return false;
+            }
+        }
+
+        archive_paths.push_back(input_path);
+    }
+    if (archive_paths.empty()) {
+        return true;
     }
 
-    // output result
-    Output output(
-            match_pass,
+    auto output_handler = create_output_handler(command_line_arguments, reducer_socket_fd);
+    if (nullptr == output_handler) {
+        return false;
+    }
+    clp_s::ArchiveSearchOption option{};
+    option.begin_ts = command_line_arguments.get_search_begin_ts();
+    option.end_ts = command_line_arguments.get_search_end_ts();
+    option.projection_columns = command_line_arguments.get_projection_columns();
+    option.ignore_case = command_line_arguments.get_ignore_case();
+    option.num_threads = command_line_arguments.get_num_search_threads();
+    option.num_concurrent_archives = command_line_arguments.get_num_concurrent_archives();
+    option.max_num_results = command_line_arguments.get_search_result_limit();
+    option.network_auth = command_line_arguments.get_network_auth();
+    return clp_s::search_archives(
+            option,
+            query,
             expr,
-            archive_reader,
-            std::move(output_handler),
-            command_line_arguments.get_ignore_case()
+            archive_paths,
+            metadata_cache,
+            std::move(output_handler)
     );
-    return output.filter();
+}
+
+void serve_queries_from_stdin(CommandLineArguments const& command_line_arguments) {
+    auto const metadata_cache = std::make_shared<clp_s::ArchiveMetadataCache>(
+            command_line_arguments.get_metadata_cache_size()
+    );
+    bool const is_stdout_output = CommandLineArguments::OutputHandlerType::Stdout
+                                  == command_line_arguments.get_output_handler_type();
+
+    std::string query;
+    while (std::getline(std::cin, query)) {
+        if (query.empty()) {
+            continue;
+        }
+
+        // Each archive is searched with a new reader that shares the cache, since a failed search
+        // can leave its reader open
+        try {
+            auto const expr = parse_query(query);
+            if (nullptr == expr
+                || false == search(command_line_arguments, query, expr, metadata_cache, -1))
+            {
+                SPDLOG_ERROR("Failed to search for query '{}'", query);
+            }
+        } catch (std::exception const& e) {
+            SPDLOG_ERROR("Encountered error while searching for query '{}' - {}", query, e.what());
+        }
+
+        if (is_stdout_output) {
+            std::cout << std::endl;
+        }
+        SPDLOG_DEBUG(
+                "Metadata cache holds {} archives in {} bytes after {} hits and {} misses",
+                metadata_cache->get_num_cached_archives(),
+                metadata_cache->get_memory_in_use(),
+                metadata_cache->get_num_hits(),
+                metadata_cache->get_num_misses()
+        );
+    }
 }
 }  // namespace
 
@@ -317,6 +369,9 @@ int main(int argc, char const* argv[]) {
         option.output_dir = command_line_arguments.get_output_dir();
         option.ordered = command_line_arguments.get_ordered_decompression();
         option.target_ordered_chunk_size = command_line_arguments.get_target_ordered_chunk_size();
+        option.ordered_memory_budget = command_line_arguments.get_ordered_memory_budget();
+        option.num_threads = command_line_arguments.get_num_extraction_threads();
+        option.log_event_idx_range = command_line_arguments.get_log_event_idx_range();
         option.print_ordered_chunk_stats = command_line_arguments.print_ordered_chunk_stats();
         option.network_auth = command_line_arguments.get_network_auth();
         if (false == command_line_arguments.get_mongodb_uri().empty()) {
@@ -334,19 +389,15 @@ int main(int argc, char const* argv[]) {
             SPDLOG_ERROR("Encountered error during decompression - {}", e.what());
             return 1;
         }
+    } else if (command_line_arguments.serve_queries_from_stdin()) {
+        serve_queries_from_stdin(command_line_arguments);
     } else {
         auto const& query = command_line_arguments.get_query();
-        auto query_stream = std::istringstream(query);
-        auto expr = kql::parse_kql_expression(query_stream);
+        auto expr = parse_query(query);
         if (nullptr == expr) {
             return 1;
         }
 
-        if (std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
-            SPDLOG_ERROR("Query '{}' is logically false", query);
-            return 1;
-        }
-
         int reducer_socket_fd{-1};
         if (command_line_arguments.get_output_handler_type()
             == CommandLineArguments::OutputHandlerType::Reducer)
@@ -362,73 +413,9 @@ int main(int argc, char const* argv[]) {
             }
         }
 
-        auto archive_reader = std::make_shared<clp_s::ArchiveReader>();
-        for (auto const& input_path : command_line_arguments.get_input_paths()) {
-            if (std::string::npos != input_path.path.find(clp::ir::cIrFileExtension)) {
-                auto const result{clp_s::search_kv_ir_stream(
-                        input_path,
-                        command_line_arguments,
-                        expr->copy(),
-                        reducer_socket_fd
-                )};
-                if (false == result.has_error()) {
-                    continue;
-                }
-
-                auto const error{result.error()};
-                if (std::errc::result_out_of_range == error) {
-                    // To support real-time search, we will allow incomplete IR streams.
-                    // TODO: Use dedicated error code for this case once issue #904 is resolved.
-                    SPDLOG_WARN("IR stream `{}` is truncated", input_path.path);
-                    continue;
-                }
-
-                if (KvIrSearchError{KvIrSearchErrorEnum::ProjectionSupportNotImplemented} == error
-                    || KvIrSearchError{KvIrSearchErrorEnum::UnsupportedOutputHandlerType} == error
-                    || KvIrSearchError{KvIrSearchErrorEnum::CountSupportNotImplemented} == error)
-                {
-                    // These errors are treated as non-fatal because they result from unsupported
-                    // features. However, this approach may cause archives with this extension to be
-                    // skipped if the search uses advanced features that are not yet implemented. To
-                    // mitigate this, we log a warning and proceed to search the input as an
-                    // archive.
-                    SPDLOG_WARN(
-                            "Attempted to search an IR stream using unsupported features. Falling"
-                            " back to searching the input as an archive."
-                    );
-                } else if (KvIrSearchError{KvIrSearchErrorEnum::DeserializerCreationFailure}
-                           != error)
-                {
-                    // If the error is `DeserializerCreationFailure`, we may continue to treat the
-                    // input as an archive and retry. Otherwise, it should be considered as a
-                    // non-recoverable failure and return directly.
-                    SPDLOG_ERROR(
-                            "Failed to search '{}' as an IR stream, error_category={}, error={}",
-                            input_path.path,
-                            error.category().name(),
-                            error.message()
-                    );
-                    return 1;
-                }
-            }
-
-            try {
-                archive_reader->open(input_path, command_line_arguments.get_network_auth());
-            } catch (std::exception const& e) {
-                SPDLOG_ERROR("Failed to open archive - {}", e.what());
-                return 1;
-            }
-            if (false
-                == search_archive(
-                        command_line_arguments,
-                        archive_reader,
-                        expr->copy(),
-                        reducer_socket_fd
-                ))
-            {
-                return 1;
-            }
-            archive_reader->close();
+        if (false == search(command_line_arguments, query, expr, nullptr, reducer_socket_fd))
+        {
+            return 1;
         }
     }
 
@@ -1,10 +1,20 @@
 #include "Output.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
 #include "../../clp/type_utils.hpp"
+#include "../PackedStreamPrefetcher.hpp"
+#include "../SchemaReader.hpp"
 #include "../SchemaTree.hpp"
+#include "../ThreadPool.hpp"
 #include "../Utils.hpp"
 #include "ast/AndExpr.hpp"
 #include "ast/ColumnDescriptor.hpp"
@@ -37,6 +47,11 @@ bool Output::filter() {
     bool has_array = false;
     bool has_array_search = false;
 
+    // Another search sharing the output handler may have already found enough results
+    if (m_output_handler->is_result_limit_reached()) {
+        return true;
+    }
+
     m_archive_reader->read_metadata();
     for (auto schema_id : m_archive_reader->get_schema_ids()) {
         if (m_match->schema_matched(schema_id)) {
@@ -56,12 +71,20 @@ bool Output::filter() {
         return true;
     }
 
+    // Skip the archive if none of its tables can contain results later than those already kept
+    record_max_timestamps(matched_schemas);
+    if (std::none_of(matched_schemas.begin(), matched_schemas.end(), [&](int32_t schema_id) {
+            return may_contain_kept_results(get_max_timestamp(schema_id));
+        }))
+    {
+        return true;
+    }
+
     // Skip decompressing the rest of the archive if it won't match based on the timestamp range
     // index. This check happens a second time here because some ambiguous columns may now match the
     // timestamp column after column resolution.
     EvaluateTimestampIndex timestamp_index(m_archive_reader->get_timestamp_dictionary());
     if (EvaluatedValue::False == timestamp_index.run(m_expr)) {
-        m_archive_reader->close();
         return true;
     }
 
@@ -69,31 +92,153 @@ bool Output::filter() {
     m_archive_reader->read_log_type_dictionary();
 
     if (has_array) {
-        if (has_array_search) {
+        // Lazily decoded dictionary entries are mutated on read, so workers need a fully decoded
+        // dictionary
+        if (has_array_search || m_num_threads > 1) {
             m_archive_reader->read_array_dictionary();
         } else {
             m_archive_reader->read_array_dictionary(true);
         }
     }
 
-    m_query_runner.global_init();
     m_archive_reader->open_packed_streams();
+    if (m_num_threads > 1) {
+        return search_tables_in_parallel(matched_schemas);
+    }
+    return search_tables(matched_schemas);
+}
+
+void Output::record_max_timestamps(std::vector<int32_t> const& matched_schemas) {
+    m_schema_id_to_max_timestamp.clear();
+    if (m_is_count_only || false == m_output_handler->keeps_only_latest_results()) {
+        return;
+    }
+    for (int32_t schema_id : matched_schemas) {
+        auto const timestamp_range = m_archive_reader->get_timestamp_range(schema_id);
+        if (timestamp_range.has_value()) {
+            m_schema_id_to_max_timestamp.emplace(schema_id, timestamp_range->max);
+        }
+    }
+}
 
+auto Output::get_max_timestamp(int32_t schema_id) const -> epochtime_t {
+    auto const it = m_schema_id_to_max_timestamp.find(schema_id);
+    return m_schema_id_to_max_timestamp.end() == it ? cEpochTimeMax : it->second;
+}
+
+auto Output::may_contain_kept_results(epochtime_t max_timestamp) const -> bool {
+    auto const cutoff = m_output_handler->get_latest_results_cutoff();
+    return false == cutoff.has_value() || max_timestamp > cutoff.value();
+}
+
+void Output::order_tables_by_max_timestamp(std::vector<int32_t>& schema_ids) const {
+    if (m_schema_id_to_max_timestamp.empty()) {
+        return;
+    }
+    std::stable_sort(schema_ids.begin(), schema_ids.end(), [&](int32_t lhs, int32_t rhs) {
+        auto const lhs_stream_id = m_archive_reader->get_schema_metadata(lhs).stream_id;
+        auto const rhs_stream_id = m_archive_reader->get_schema_metadata(rhs).stream_id;
+        if (lhs_stream_id != rhs_stream_id) {
+            return lhs_stream_id < rhs_stream_id;
+        }
+        return get_max_timestamp(lhs) > get_max_timestamp(rhs);
+    });
+}
+
+auto Output::search_tables(std::vector<int32_t> const& matched_schemas) -> bool {
+    m_query_runner.global_init();
+
+    // Decide which tables have to be read up front, so that their streams can be prefetched
+    std::vector<int32_t> schemas_to_read;
+    for (int32_t schema_id : matched_schemas) {
+        auto const expression_value = m_query_runner.schema_init(schema_id);
+        if (EvaluatedValue::False == expression_value) {
+            continue;
+        }
+
+        if (m_is_count_only && EvaluatedValue::True == expression_value) {
+            // Every record in the table matches, so there's no need to read it
+            m_output_handler->write_count(
+                    m_archive_reader->get_schema_metadata(schema_id).num_messages
+            );
+            auto ecode = m_output_handler->flush();
+            if (ErrorCode::ErrorCodeSuccess != ecode) {
+                SPDLOG_ERROR(
+                        "Failed to flush output handler, error={}.",
+                        clp::enum_to_underlying_type(ecode)
+                );
+                return false;
+            }
+            continue;
+        }
+
+        // The context is restored when the table is searched below
+        m_query_runner.keep_schema_context();
+        schemas_to_read.push_back(schema_id);
+    }
+    order_tables_by_max_timestamp(schemas_to_read);
+
+    std::vector<size_t> stream_ids;
+    for (int32_t schema_id : schemas_to_read) {
+        auto const stream_id = m_archive_reader->get_schema_metadata(schema_id).stream_id;
+        if (stream_ids.empty() || stream_ids.back() != stream_id) {
+            stream_ids.push_back(stream_id);
+        }
+    }
+
+    // The latest timestamp in each table and the tables after it
+    std::vector<epochtime_t> remaining_max_timestamps(schemas_to_read.size());
+    epochtime_t remaining_max_timestamp{cEpochTimeMin};
+    for (size_t i = schemas_to_read.size(); i > 0; --i) {
+        remaining_max_timestamp
+                = std::max(remaining_max_timestamp, get_max_timestamp(schemas_to_read[i - 1]));
+        remaining_max_timestamps[i - 1] = remaining_max_timestamp;
+    }
+
+    m_archive_reader->plan_stream_reads(stream_ids);
+
+    // The next streams are read and decompressed in the background while the current table is
+    // being filtered
+    PackedStreamPrefetcher prefetcher{
+            *m_archive_reader,
+            std::move(stream_ids),
+            cMaxNumPrefetchedStreams
+    };
+    SchemaReader reader;
+    std::shared_ptr<char[]> stream_buffer;
+    size_t cur_stream_id{0};
     std::string message;
     auto const archive_id = m_archive_reader->get_archive_id();
-    for (int32_t schema_id : matched_schemas) {
-        if (EvaluatedValue::False == m_query_runner.schema_init(schema_id)) {
+    for (size_t i = 0; i < schemas_to_read.size(); ++i) {
+        auto const schema_id = schemas_to_read[i];
+        if (m_output_handler->is_result_limit_reached()
+            || false == may_contain_kept_results(remaining_max_timestamps[i]))
+        {
+            break;
+        }
+
+        auto const stream_id = m_archive_reader->get_schema_metadata(schema_id).stream_id;
+        if (nullptr == stream_buffer || cur_stream_id != stream_id) {
+            stream_buffer = prefetcher.get_next_stream();
+            cur_stream_id = stream_id;
+        }
+        if (false == may_contain_kept_results(get_max_timestamp(schema_id))) {
             continue;
         }
+        m_query_runner.schema_init(schema_id);
 
-        auto& reader = m_archive_reader->read_schema_table(
+        m_archive_reader->load_schema_table(
+                reader,
                 schema_id,
+                stream_buffer,
                 m_output_handler->should_output_metadata(),
                 m_should_marshal_records
         );
         reader.initialize_filter(&m_query_runner);
 
-        if (m_output_handler->should_output_metadata()) {
+        if (m_is_count_only) {
+            m_output_handler->write_count(reader.count_matching_messages(&m_query_runner));
+        } else if (m_output_handler->should_output_metadata()) {
             epochtime_t timestamp{};
             int64_t log_event_idx{};
             while (reader.get_next_message_with_metadata(
@@ -104,10 +249,16 @@ bool Output::filter() {
             ))
             {
                 m_output_handler->write(message, timestamp, archive_id, log_event_idx);
+                if (m_output_handler->is_result_limit_reached()) {
+                    break;
+                }
             }
         } else {
             while (reader.get_next_message(message, &m_query_runner)) {
                 m_output_handler->write(message);
+                if (m_output_handler->is_result_limit_reached()) {
+                    break;
+                }
             }
         }
         auto ecode = m_output_handler->flush();
@@ -129,4 +280,214 @@ bool Output::filter() {
     }
     return true;
 }
+
+auto Output::search_tables_in_parallel(std::vector<int32_t> const& matched_schemas) -> bool {
+    // Tables that can't match (e.g., because their statistics rule the query out) are dropped
+    // here so that streams containing only such tables are never read. When only counting
+    // matches, tables that match entirely can also be resolved without reading their streams.
+    uint64_t num_messages_in_fully_matched_tables{0};
+    m_query_runner.global_init();
+
+    // Tables are stored in packed streams, so group the matched tables by stream and hand each
+    // stream to a worker. Streams have to be read in ascending order, so the map is ordered.
+    std::map<size_t, std::vector<int32_t>> stream_id_to_schema_ids;
+    for (int32_t schema_id : matched_schemas) {
+        auto const expression_value = m_query_runner.schema_init(schema_id);
+        if (EvaluatedValue::False == expression_value) {
+            continue;
+        }
+        if (m_is_count_only && EvaluatedValue::True == expression_value) {
+            num_messages_in_fully_matched_tables
+                    += m_archive_reader->get_schema_metadata(schema_id).num_messages;
+            continue;
+        }
+        auto const stream_id = m_archive_reader->get_schema_metadata(schema_id).stream_id;
+        stream_id_to_schema_ids[stream_id].push_back(schema_id);
+    }
+
+    auto thread_pool = m_thread_pool;
+    if (nullptr == thread_pool) {
+        thread_pool = std::make_shared<ThreadPool>(m_num_threads);
+    }
+    auto const num_threads = thread_pool->get_num_threads();
+
+    // Workers only run one task at a time, so each needs its own state even if the pool is shared
+    std::vector<std::unique_ptr<WorkerState>> worker_states;
+    worker_states.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        worker_states.emplace_back(std::make_unique<WorkerState>());
+    }
+
+    std::vector<size_t> stream_ids;
+    stream_ids.reserve(stream_id_to_schema_ids.size());
+    for (auto& [stream_id, schema_ids] : stream_id_to_schema_ids) {
+        order_tables_by_max_timestamp(schema_ids);
+        stream_ids.push_back(stream_id);
+    }
+    m_archive_reader->plan_stream_reads(stream_ids);
+
+    // The latest timestamp in each stream and the streams after it
+    std::map<size_t, epochtime_t> stream_id_to_remaining_max_timestamp;
+    epochtime_t remaining_max_timestamp{cEpochTimeMin};
+    for (auto it = stream_id_to_schema_ids.rbegin(); stream_id_to_schema_ids.rend() != it; ++it) {
+        remaining_max_timestamp
+                = std::max(remaining_max_timestamp, get_max_timestamp(it->second.front()));
+        stream_id_to_remaining_max_timestamp.emplace(it->first, remaining_max_timestamp);
+    }
+
+    try {
+        if (num_messages_in_fully_matched_tables > 0) {
+            write_count(num_messages_in_fully_matched_tables);
+        }
+
+        // Only this search's tasks are waited on, since the pool may be shared with other searches
+        TaskGroup task_group{*thread_pool};
+        for (auto const& [stream_id, schema_ids] : stream_id_to_schema_ids) {
+            // Bound the number of compressed streams held in memory
+            task_group.wait(2 * num_threads);
+            if (m_output_handler->is_result_limit_reached()
+                || false
+                           == may_contain_kept_results(
+                                   stream_id_to_remaining_max_timestamp.at(stream_id)
+                           ))
+            {
+                break;
+            }
+            if (false == may_contain_kept_results(get_max_timestamp(schema_ids.front()))) {
+                continue;
+            }
+
+            auto compressed_buf = std::make_shared<std::vector<char>>();
+            m_archive_reader->read_compressed_stream(stream_id, *compressed_buf);
+            task_group.submit([this, &worker_states, &schema_ids, stream_id, compressed_buf](
+                                      size_t worker_id
+                              ) {
+                auto const stream_buffer
+                        = m_archive_reader->decompress_stream(stream_id, *compressed_buf);
+                search_stream(*worker_states[worker_id], stream_buffer, schema_ids);
+            });
+        }
+        task_group.wait();
+    } catch (TraceableException& e) {
+        SPDLOG_ERROR(
+                "Failed to search archive, error={} at {}:{}.",
+                clp::enum_to_underlying_type(e.get_error_code()),
+                e.get_filename(),
+                e.get_line_number()
+        );
+        return false;
+    } catch (std::exception& e) {
+        SPDLOG_ERROR("Failed to search archive - {}.", e.what());
+        return false;
+    }
+
+    auto ecode = m_output_handler->finish();
+    if (ErrorCode::ErrorCodeSuccess != ecode) {
+        SPDLOG_ERROR(
+                "Failed to flush output handler, error={}.",
+                clp::enum_to_underlying_type(ecode)
+        );
+        return false;
+    }
+    return true;
+}
+
+void Output::search_stream(
+        WorkerState& state,
+        std::shared_ptr<char[]> const& stream_buffer,
+        std::vector<int32_t> const& schema_ids
+) {
+    if (nullptr == state.query_runner) {
+        state.query_runner
+                = std::make_unique<QueryRunner>(m_match, m_expr, m_archive_reader, m_ignore_case);
+        state.query_runner->global_init();
+    }
+    auto* query_runner = state.query_runner.get();
+    auto& reader = state.schema_reader;
+    bool const should_output_metadata = m_output_handler->should_output_metadata();
+
+    std::string message;
+    epochtime_t timestamp{};
+    int64_t log_event_idx{};
+    for (int32_t schema_id : schema_ids) {
+        // Tables are ordered by their latest timestamps, so none of the remaining tables can
+        // contain kept results either
+        if (m_output_handler->is_result_limit_reached()
+            || false == may_contain_kept_results(get_max_timestamp(schema_id)))
+        {
+            break;
+        }
+        if (EvaluatedValue::False == query_runner->schema_init(schema_id)) {
+            continue;
+        }
+
+        m_archive_reader->load_schema_table(
+                reader,
+                schema_id,
+                stream_buffer,
+                should_output_metadata,
+                m_should_marshal_records
+        );
+        reader.initialize_filter(query_runner);
+
+        if (m_is_count_only) {
+            write_count(reader.count_matching_messages(query_runner));
+            continue;
+        }
+
+        auto const get_next_message = [&]() -> bool {
+            if (should_output_metadata) {
+                return reader.get_next_message_with_metadata(
+                        message,
+                        timestamp,
+                        log_event_idx,
+                        query_runner
+                );
+            }
+            return reader.get_next_message(message, query_runner);
+        };
+        while (get_next_message()) {
+            state.results.emplace_back(BufferedResult{message, timestamp, log_event_idx});
+            if (state.results.size() >= cMaxNumBufferedResults) {
+                write_buffered_results(state.results, false);
+                if (m_output_handler->is_result_limit_reached()) {
+                    break;
+                }
+            }
+        }
+        write_buffered_results(state.results, true);
+    }
+}
+
+void Output::write_buffered_results(std::vector<BufferedResult>& results, bool should_flush) {
+    std::lock_guard const lock{m_output_handler_mutex};
+    if (m_output_handler->should_output_metadata()) {
+        auto const archive_id = m_archive_reader->get_archive_id();
+        for (auto const& result : results) {
+            m_output_handler
+                    ->write(result.message, result.timestamp, archive_id, result.log_event_idx);
+        }
+    } else {
+        for (auto const& result : results) {
+            m_output_handler->write(result.message);
+        }
+    }
+    results.clear();
+
+    if (should_flush) {
+        auto ecode = m_output_handler->flush();
+        if (ErrorCode::ErrorCodeSuccess != ecode) {
+            throw OperationFailed(ecode, __FILENAME__, __LINE__);
+        }
+    }
+}
+
+void Output::write_count(uint64_t count) {
+    std::lock_guard const lock{m_output_handler_mutex};
+    m_output_handler->write_count(count);
+    auto ecode = m_output_handler->flush();
+    if (ErrorCode::ErrorCodeSuccess != ecode) {
+        throw OperationFailed(ecode, __FILENAME__, __LINE__);
+    }
+}
 }  // namespace clp_s::search
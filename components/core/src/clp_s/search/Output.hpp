@@ -1,18 +1,25 @@
 #ifndef CLP_S_SEARCH_OUTPUT_HPP
 #define CLP_S_SEARCH_OUTPUT_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <stack>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include <simdjson.h>
 
 #include "../ArchiveReader.hpp"
 #include "../SchemaReader.hpp"
+#include "../ThreadPool.hpp"
+#include "../TraceableException.hpp"
 #include "../Utils.hpp"
 #include "ast/Expression.hpp"
 #include "ast/StringLiteral.hpp"
@@ -32,17 +39,47 @@ namespace clp_s::search {
  */
 class Output {
 public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    // Constructors
+    /**
+     * @param match
+     * @param expr
+     * @param archive_reader
+     * @param output_handler
+     * @param ignore_case
+     * @param num_threads The number of threads used to decompress and filter tables. When greater
+     * than one, each worker thread searches whole packed streams with its own QueryRunner and
+     * SchemaReader, and results are handed to the output handler one batch at a time.
+     * @param thread_pool A thread pool shared with other searches, used instead of creating a pool
+     * of `num_threads` threads when searching tables in parallel. May be nullptr.
+     */
     Output(std::shared_ptr<SchemaMatch> const& match,
            std::shared_ptr<ast::Expression> const& expr,
            std::shared_ptr<ArchiveReader> const& archive_reader,
            std::unique_ptr<OutputHandler> output_handler,
-           bool ignore_case)
+           bool ignore_case,
+           size_t num_threads = 1,
+           std::shared_ptr<ThreadPool> thread_pool = nullptr)
             : m_query_runner(match, expr, archive_reader, ignore_case),
               m_archive_reader(archive_reader),
               m_expr(expr),
               m_match(match),
               m_output_handler(std::move(output_handler)),
-              m_should_marshal_records(m_output_handler->should_marshal_records()) {}
+              m_should_marshal_records(m_output_handler->should_marshal_records()),
+              m_is_count_only(
+                      false == m_should_marshal_records
+                      && false == m_output_handler->should_output_metadata()
+              ),
+              m_ignore_case(ignore_case),
+              m_num_threads(num_threads),
+              m_thread_pool(std::move(thread_pool)) {}
 
     /**
      * Filters messages within the archive and outputs the filtered messages to the configured
@@ -53,12 +90,115 @@ public:
     auto filter() -> bool;
 
 private:
+    // Types
+    struct BufferedResult {
+        std::string message;
+        epochtime_t timestamp;
+        int64_t log_event_idx;
+    };
+
+    /**
+     * The state owned by each worker thread during multi-threaded search.
+     */
+    struct WorkerState {
+        std::unique_ptr<QueryRunner> query_runner;
+        SchemaReader schema_reader;
+        std::vector<BufferedResult> results;
+    };
+
+    // Methods
+    /**
+     * Records the latest timestamp in each matched table if the output handler only keeps the
+     * results with the latest timestamps.
+     * @param matched_schemas
+     */
+    void record_max_timestamps(std::vector<int32_t> const& matched_schemas);
+
+    /**
+     * @param schema_id
+     * @return The latest timestamp in the table, or cEpochTimeMax if it's unknown or wasn't recorded
+     */
+    [[nodiscard]] auto get_max_timestamp(int32_t schema_id) const -> epochtime_t;
+
+    /**
+     * @param max_timestamp The latest timestamp in a table
+     * @return Whether the table may contain results that the output handler would keep
+     */
+    [[nodiscard]] auto may_contain_kept_results(epochtime_t max_timestamp) const -> bool;
+
+    /**
+     * Orders the tables in each packed stream so that tables with later timestamps are searched
+     * first. Packed streams can only be read in ascending order, so the order of the streams is
+     * kept.
+     * @param schema_ids Tables ordered by packed stream
+     */
+    void order_tables_by_max_timestamp(std::vector<int32_t>& schema_ids) const;
+
+    /**
+     * Searches the matched tables one at a time on the calling thread, while the packed streams
+     * containing the next tables are prefetched on a background thread.
+     * @param matched_schemas
+     * @return true on success, false otherwise
+     */
+    auto search_tables(std::vector<int32_t> const& matched_schemas) -> bool;
+
+    /**
+     * Searches the matched tables using a pool of worker threads (either the shared thread pool or
+     * a pool of m_num_threads threads). The calling thread reads compressed packed streams in order,
+     * while the workers decompress and filter them.
+     * @param matched_schemas
+     * @return true on success, false otherwise
+     */
+    auto search_tables_in_parallel(std::vector<int32_t> const& matched_schemas) -> bool;
+
+    /**
+     * Filters the tables of a decompressed packed stream on a worker thread.
+     * @param state
+     * @param stream_buffer
+     * @param schema_ids the matched tables within the stream
+     * @throw OperationFailed if the output handler fails to flush results
+     */
+    void search_stream(
+            WorkerState& state,
+            std::shared_ptr<char[]> const& stream_buffer,
+            std::vector<int32_t> const& schema_ids
+    );
+
+    /**
+     * Writes a worker's buffered results to the output handler.
+     * @param results
+     * @param should_flush whether to flush the output handler after writing the results
+     * @throw OperationFailed if the output handler fails to flush results
+     */
+    void write_buffered_results(std::vector<BufferedResult>& results, bool should_flush);
+
+    /**
+     * Writes the number of matches in a table to the output handler and flushes it.
+     * @param count
+     * @throw OperationFailed if the output handler fails to flush results
+     */
+    void write_count(uint64_t count);
+
+    static constexpr size_t cMaxNumBufferedResults = 1024;
+    static constexpr size_t cMaxNumPrefetchedStreams = 2;
+
+    // Variables
     QueryRunner m_query_runner;
     std::shared_ptr<ArchiveReader> m_archive_reader;
     std::shared_ptr<ast::Expression> m_expr;
     std::shared_ptr<SchemaMatch> m_match;
     std::unique_ptr<OutputHandler> m_output_handler;
     bool m_should_marshal_records{true};
+    // Whether the output handler only needs the number of matches, in which case matches are
+    // counted without marshalling them, and tables that match entirely aren't read at all
+    bool m_is_count_only{false};
+    bool m_ignore_case{false};
+    size_t m_num_threads{1};
+    std::shared_ptr<ThreadPool> m_thread_pool;
+    // The latest timestamp in each matched table, when the output handler only keeps the results
+    // with the latest timestamps
+    std::unordered_map<int32_t, epochtime_t> m_schema_id_to_max_timestamp;
+    std::mutex m_output_handler_mutex;
 };
 }  // namespace clp_s::search
 
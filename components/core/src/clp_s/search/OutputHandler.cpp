@@ -1,5 +1,9 @@
 #include "OutputHandler.hpp"
 
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -9,7 +13,6 @@
 #include "../../clp/networking/socket_utils.hpp"
 #include "../../reducer/CountOperator.hpp"
 #include "../../reducer/network_utils.hpp"
-#include "../../reducer/Record.hpp"
 #include "../archive_constants.hpp"
 
 using std::string;
@@ -46,6 +49,23 @@ void NetworkOutputHandler::write(
     }
 }
 
+bool LatestResultsTracker::add(epochtime_t timestamp) {
+    if (0 == m_max_num_results) {
+        return false;
+    }
+    if (m_latest_timestamps.size() >= m_max_num_results) {
+        if (timestamp <= m_latest_timestamps.top()) {
+            return false;
+        }
+        m_latest_timestamps.pop();
+    }
+    m_latest_timestamps.push(timestamp);
+    if (m_latest_timestamps.size() >= m_max_num_results) {
+        m_cutoff.store(m_latest_timestamps.top());
+    }
+    return true;
+}
+
 ResultsCacheOutputHandler::ResultsCacheOutputHandler(
         string const& uri,
         string const& collection,
@@ -55,7 +75,8 @@ ResultsCacheOutputHandler::ResultsCacheOutputHandler(
 )
         : OutputHandler(should_output_timestamp, true),
           m_batch_size(batch_size),
-          m_max_num_results(max_num_results) {
+          m_max_num_results(max_num_results),
+          m_latest_results_tracker(max_num_results) {
     try {
         auto mongo_uri = mongocxx::uri(uri);
         m_client = mongocxx::client(mongo_uri);
@@ -66,7 +87,7 @@ ResultsCacheOutputHandler::ResultsCacheOutputHandler(
     }
 }
 
-ErrorCode ResultsCacheOutputHandler::flush() {
+ErrorCode ResultsCacheOutputHandler::finish() {
     size_t count = 0;
     while (false == m_latest_results.empty()) {
         auto result = std::move(*m_latest_results.top());
@@ -128,6 +149,11 @@ void ResultsCacheOutputHandler::write(
         string_view archive_id,
         int64_t log_event_idx
 ) {
+    // Results that aren't among the latest written so far can't be among the latest overall
+    if (false == m_latest_results_tracker.add(timestamp)) {
+        return;
+    }
+
     if (m_latest_results.size() < m_max_num_results) {
         m_latest_results.emplace(
                 std::make_unique<
@@ -144,18 +170,22 @@ void ResultsCacheOutputHandler::write(
 
 CountOutputHandler::CountOutputHandler(int reducer_socket_fd)
         : OutputHandler(false, false),
-          m_reducer_socket_fd(reducer_socket_fd),
-          m_pipeline(reducer::PipelineInputMode::InterStage) {
-    m_pipeline.add_pipeline_stage(std::make_shared<reducer::CountOperator>());
-}
-
-void CountOutputHandler::write(string_view message) {
-    m_pipeline.push_record(reducer::EmptyRecord{});
-}
+          m_reducer_socket_fd(reducer_socket_fd) {}
 
 ErrorCode CountOutputHandler::finish() {
+    // Matches the output of a reducer::CountOperator, which emits no groups if nothing matched
+    std::map<reducer::GroupTags, int64_t> group_counts;
+    if (m_count > 0) {
+        group_counts.emplace(reducer::GroupTags{}, m_count);
+    }
     if (false
-        == reducer::send_pipeline_results(m_reducer_socket_fd, std::move(m_pipeline.finish())))
+        == reducer::send_pipeline_results(
+                m_reducer_socket_fd,
+                std::make_unique<reducer::Int64MapRecordGroupIterator>(
+                        group_counts,
+                        reducer::CountOperator::cRecordElementKey
+                )
+        ))
     {
         return ErrorCode::ErrorCodeFailureNetwork;
     }
@@ -176,4 +206,56 @@ ErrorCode CountByTimeOutputHandler::finish() {
     }
     return ErrorCode::ErrorCodeSuccess;
 }
+
+std::unique_ptr<OutputHandler> SharedOutputHandler::create_view() {
+    return std::make_unique<View>(*this);
+}
+
+ErrorCode SharedOutputHandler::finish() {
+    std::lock_guard const lock{m_mutex};
+    return m_output_handler->finish();
+}
+
+bool SharedOutputHandler::try_count_result() {
+    if (0 == m_max_num_results) {
+        return true;
+    }
+    if (m_num_results >= m_max_num_results) {
+        return false;
+    }
+    if (++m_num_results == m_max_num_results) {
+        m_is_result_limit_reached.store(true);
+    }
+    return true;
+}
+
+void SharedOutputHandler::View::write(
+        string_view message,
+        epochtime_t timestamp,
+        string_view archive_id,
+        int64_t log_event_idx
+) {
+    std::lock_guard const lock{m_shared_output_handler.m_mutex};
+    if (m_shared_output_handler.try_count_result()) {
+        m_shared_output_handler.m_output_handler
+                ->write(message, timestamp, archive_id, log_event_idx);
+    }
+}
+
+void SharedOutputHandler::View::write(string_view message) {
+    std::lock_guard const lock{m_shared_output_handler.m_mutex};
+    if (m_shared_output_handler.try_count_result()) {
+        m_shared_output_handler.m_output_handler->write(message);
+    }
+}
+
+void SharedOutputHandler::View::write_count(uint64_t count) {
+    std::lock_guard const lock{m_shared_output_handler.m_mutex};
+    m_shared_output_handler.m_output_handler->write_count(count);
+}
+
+ErrorCode SharedOutputHandler::View::flush() {
+    std::lock_guard const lock{m_shared_output_handler.m_mutex};
+    return m_shared_output_handler.m_output_handler->flush();
+}
 }  // namespace clp_s::search
@@ -5,10 +5,18 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <queue>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include <mongocxx/client.hpp>
@@ -19,7 +27,7 @@
 #include <msgpack.hpp>
 #include <spdlog/spdlog.h>
 
-#include "../../reducer/Pipeline.hpp"
+#include "../../reducer/GroupTags.hpp"
 #include "../../reducer/RecordGroupIterator.hpp"
 #include "../Defs.hpp"
 #include "../TraceableException.hpp"
@@ -30,6 +38,14 @@ namespace clp_s::search {
  */
 class OutputHandler {
 public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
     // Constructors
     explicit OutputHandler(bool should_output_metadata, bool should_marshal_records)
             : m_should_output_metadata(should_output_metadata),
@@ -59,6 +75,17 @@ public:
      */
     virtual void write(std::string_view message) = 0;
 
+    /**
+     * Writes the number of log events that matched without writing the log events themselves. This
+     * is only called for handlers that neither output metadata nor marshal records, which must
+     * override it.
+     * @param count The number of matching log events.
+     * @throw OutputHandler::OperationFailed if the handler doesn't support counts
+     */
+    virtual void write_count([[maybe_unused]] uint64_t count) {
+        throw OperationFailed(ErrorCodeUnsupported, __FILENAME__, __LINE__);
+    }
+
     /**
      * Flushes the output handler after each table that gets searched.
      * @return ErrorCodeSuccess on success or relevant error code on error
@@ -71,6 +98,26 @@ public:
      */
     virtual ErrorCode finish() { return ErrorCode::ErrorCodeSuccess; }
 
+    /**
+     * @return Whether the handler has accepted as many results as it can, in which case the search
+     * can stop early.
+     */
+    [[nodiscard]] virtual bool is_result_limit_reached() const { return false; }
+
+    /**
+     * @return Whether the handler only keeps the results with the latest timestamps, in which case
+     * the search can skip tables whose timestamps are all at or below `get_latest_results_cutoff`.
+     */
+    [[nodiscard]] virtual bool keeps_only_latest_results() const { return false; }
+
+    /**
+     * Gets the timestamp that results must exceed to be kept. This method is thread-safe.
+     * @return The cutoff, or std::nullopt if every result is currently kept
+     */
+    [[nodiscard]] virtual std::optional<epochtime_t> get_latest_results_cutoff() const {
+        return std::nullopt;
+    }
+
     [[nodiscard]] bool should_output_metadata() const { return m_should_output_metadata; }
 
     [[nodiscard]] bool should_marshal_records() const { return m_should_marshal_records; }
@@ -145,6 +192,47 @@ private:
     int m_socket_fd;
 };
 
+/**
+ * Tracks the timestamps of the latest results written to an output handler that only keeps a
+ * limited number of the latest results. Once that many results have been written, the earliest of
+ * their timestamps is a cutoff that later results must exceed to be kept. Results whose timestamp
+ * equals the cutoff are dropped, so ties are resolved in favour of the results written first.
+ */
+class LatestResultsTracker {
+public:
+    // Constructors
+    explicit LatestResultsTracker(uint64_t max_num_results) : m_max_num_results{max_num_results} {}
+
+    // Methods
+    /**
+     * Records the timestamp of a written result. This method isn't thread-safe.
+     * @param timestamp
+     * @return Whether the result is among the latest results written so far
+     */
+    bool add(epochtime_t timestamp);
+
+    /**
+     * Gets the timestamp that results must exceed to be kept. This method is thread-safe.
+     * @return The cutoff, or std::nullopt if fewer than the maximum number of results have been
+     * written
+     */
+    [[nodiscard]] std::optional<epochtime_t> get_cutoff() const {
+        auto const cutoff = m_cutoff.load();
+        if (cEpochTimeMin == cutoff) {
+            return std::nullopt;
+        }
+        return cutoff;
+    }
+
+private:
+    // Variables
+    uint64_t m_max_num_results;
+    std::priority_queue<epochtime_t, std::vector<epochtime_t>, std::greater<>> m_latest_timestamps;
+    // The earliest of the latest timestamps once `m_max_num_results` results have been written, or
+    // cEpochTimeMin before then
+    std::atomic<epochtime_t> m_cutoff{cEpochTimeMin};
+};
+
 /**
  * Output handler that writes to a MongoDB collection.
  */
@@ -200,11 +288,12 @@ public:
 
     // Methods inherited from OutputHandler
     /**
-     * Flushes the output handler after each table that gets searched.
+     * Writes the latest results to the results cache. They're kept until every table of every
+     * archive has been searched, so at most `max_num_results` results are written in total.
      * @return ErrorCodeSuccess on success
      * @return ErrorCodeFailureDbBulkWrite on failure to write results to the results cache
      */
-    ErrorCode flush() override;
+    ErrorCode finish() override;
 
     void write(
             std::string_view message,
@@ -215,6 +304,12 @@ public:
 
     void write(std::string_view message) override { write(message, 0, {}, 0); }
 
+    [[nodiscard]] bool keeps_only_latest_results() const override { return true; }
+
+    [[nodiscard]] std::optional<epochtime_t> get_latest_results_cutoff() const override {
+        return m_latest_results_tracker.get_cutoff();
+    }
+
 private:
     mongocxx::client m_client;
     mongocxx::collection m_collection;
@@ -226,6 +321,8 @@ private:
             std::vector<std::unique_ptr<QueryResult>>,
             QueryResultGreaterTimestampComparator>
             m_latest_results;
+    // Tracks the timestamps of the latest results written so far
+    LatestResultsTracker m_latest_results_tracker;
 };
 
 /**
@@ -244,7 +341,9 @@ public:
             int64_t log_event_idx
     ) override {}
 
-    void write(std::string_view message) override;
+    void write(std::string_view message) override { ++m_count; }
+
+    void write_count(uint64_t count) override { m_count += static_cast<int64_t>(count); }
 
     /**
      * Flushes the count.
@@ -255,7 +354,7 @@ public:
 
 private:
     int m_reducer_socket_fd;
-    reducer::Pipeline m_pipeline;
+    int64_t m_count{0};
 };
 
 /**
@@ -343,6 +442,99 @@ public:
 private:
     std::vector<QueryResult>& m_output;
 };
+
+/**
+ * Lets several concurrent searches (e.g., of different archives) write to one output handler.
+ * Access to the underlying handler is serialized, and the total number of results it's given can be
+ * limited, in which case the searches stop early once the limit is reached.
+ *
+ * Each search writes to its own view of the handler, created with `create_view`. Views don't finish
+ * the underlying handler, so `finish` must be called once every search is done.
+ */
+class SharedOutputHandler {
+public:
+    // Constructors
+    /**
+     * @param output_handler
+     * @param max_num_results The maximum number of results to write, or 0 for no limit. Counts of
+     * results written with `write_count` aren't limited.
+     */
+    SharedOutputHandler(std::unique_ptr<OutputHandler> output_handler, uint64_t max_num_results)
+            : m_output_handler{std::move(output_handler)},
+              m_max_num_results{max_num_results} {}
+
+    // Methods
+    /**
+     * @return An output handler for one search that writes to the shared handler.
+     */
+    [[nodiscard]] std::unique_ptr<OutputHandler> create_view();
+
+    /**
+     * Performs any final operations after every search is done.
+     * @return Same as the underlying handler's `finish`
+     */
+    ErrorCode finish();
+
+    [[nodiscard]] bool is_result_limit_reached() const { return m_is_result_limit_reached.load(); }
+
+private:
+    // Types
+    class View;
+
+    // Methods
+    /**
+     * Counts a result against the limit, if there's one. Must be called with the mutex held.
+     * @return Whether the result should be written.
+     */
+    bool try_count_result();
+
+    // Variables
+    std::unique_ptr<OutputHandler> m_output_handler;
+    uint64_t m_max_num_results;
+    uint64_t m_num_results{0};
+    std::atomic<bool> m_is_result_limit_reached{false};
+    std::mutex m_mutex;
+};
+
+class SharedOutputHandler::View : public OutputHandler {
+public:
+    // Constructors
+    explicit View(SharedOutputHandler& shared_output_handler)
+            : OutputHandler(
+                      shared_output_handler.m_output_handler->should_output_metadata(),
+                      shared_output_handler.m_output_handler->should_marshal_records()
+              ),
+              m_shared_output_handler{shared_output_handler} {}
+
+    // Methods inherited from OutputHandler
+    void write(
+            std::string_view message,
+            epochtime_t timestamp,
+            std::string_view archive_id,
+            int64_t log_event_idx
+    ) override;
+
+    void write(std::string_view message) override;
+
+    void write_count(uint64_t count) override;
+
+    ErrorCode flush() override;
+
+    [[nodiscard]] bool is_result_limit_reached() const override {
+        return m_shared_output_handler.is_result_limit_reached();
+    }
+
+    [[nodiscard]] bool keeps_only_latest_results() const override {
+        return m_shared_output_handler.m_output_handler->keeps_only_latest_results();
+    }
+
+    [[nodiscard]] std::optional<epochtime_t> get_latest_results_cutoff() const override {
+        return m_shared_output_handler.m_output_handler->get_latest_results_cutoff();
+    }
+
+private:
+    SharedOutputHandler& m_shared_output_handler;
+};
 }  // namespace clp_s::search
 
 #endif  // CLP_S_SEARCH_OUTPUTHANDLER_HPP
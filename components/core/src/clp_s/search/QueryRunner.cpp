@@ -1,10 +1,15 @@
 #include "QueryRunner.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <variant>
 #include <vector>
 
 #include "../../clp/type_utils.hpp"
 #include "../SchemaTree.hpp"
+#include "../TableStatistics.hpp"
 #include "../Utils.hpp"
 #include "ast/AndExpr.hpp"
 #include "ast/ColumnDescriptor.hpp"
@@ -32,13 +37,111 @@ using clp_s::search::ast::OrExpr;
 
 #define eval(op, a, b) (((op) == FilterOperation::EQ) ? ((a) == (b)) : ((a) != (b)))
 
+namespace {
+/**
+ * Evaluates `value op operand` for every value in a batch, ORing the result into `selection`.
+ * Each comparison is a separate loop over the column so that the compiler can vectorize it.
+ * @tparam T
+ * @param op
+ * @param values
+ * @param begin_message
+ * @param operand
+ * @param selection
+ */
+template <typename T>
+void evaluate_numeric_filter_batch(
+        FilterOperation op,
+        clp_s::UnalignedMemSpan<T> values,
+        uint64_t begin_message,
+        T operand,
+        std::vector<uint8_t>& selection
+) {
+    auto const select = [&](auto predicate) {
+        size_t const batch_size = selection.size();
+        for (size_t i = 0; i < batch_size; ++i) {
+            selection[i] |= static_cast<uint8_t>(predicate(values[begin_message + i]));
+        }
+    };
+
+    switch (op) {
+        case FilterOperation::EQ:
+            select([operand](T value) { return value == operand; });
+            break;
+        case FilterOperation::NEQ:
+            select([operand](T value) { return value != operand; });
+            break;
+        case FilterOperation::LT:
+            select([operand](T value) { return value < operand; });
+            break;
+        case FilterOperation::GT:
+            select([operand](T value) { return value > operand; });
+            break;
+        case FilterOperation::LTE:
+            select([operand](T value) { return value <= operand; });
+            break;
+        case FilterOperation::GTE:
+            select([operand](T value) { return value >= operand; });
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * Checks whether any value in the range [min, max] could satisfy `value op operand`.
+ * @tparam T
+ * @param op
+ * @param min
+ * @param max
+ * @param operand
+ * @return Whether a value in the range could satisfy the comparison
+ */
+template <typename T>
+auto range_may_contain_match(FilterOperation op, T min, T max, T operand) -> bool {
+    switch (op) {
+        case FilterOperation::EQ:
+            return min <= operand && operand <= max;
+        case FilterOperation::NEQ:
+            return false == (min == operand && max == operand);
+        case FilterOperation::LT:
+            return min < operand;
+        case FilterOperation::GT:
+            return max > operand;
+        case FilterOperation::LTE:
+            return min <= operand;
+        case FilterOperation::GTE:
+            return max >= operand;
+        default:
+            return true;
+    }
+}
+}  // namespace
+
 namespace clp_s::search {
 void QueryRunner::global_init() {
+    // Queries from a previous archive may be freed and their addresses reused
+    m_query_to_subqueries_by_logtype.clear();
+    m_kept_schema_contexts.clear();
     populate_internal_columns();
     populate_string_queries(m_expr);
 }
 
 auto QueryRunner::schema_init(int32_t schema_id) -> EvaluatedValue {
+    if (auto it = m_kept_schema_contexts.find(schema_id); m_kept_schema_contexts.end() != it) {
+        auto& context = it->second;
+        m_expr = std::move(context.expr);
+        m_expression_value = context.expression_value;
+        m_expr_clp_query = std::move(context.expr_clp_query);
+        m_expr_var_match_map = std::move(context.expr_var_match_map);
+        m_wildcard_columns = std::move(context.wildcard_columns);
+        m_wildcard_to_searched_basic_columns
+                = std::move(context.wildcard_to_searched_basic_columns);
+        m_wildcard_type_mask = context.wildcard_type_mask;
+        m_schema = schema_id;
+        m_kept_schema_contexts.erase(it);
+        return m_expression_value;
+    }
+
     m_expr_clp_query.clear();
     m_expr_var_match_map.clear();
     m_wildcard_to_searched_basic_columns.clear();
@@ -56,6 +159,21 @@ auto QueryRunner::schema_init(int32_t schema_id) -> EvaluatedValue {
     return m_expression_value;
 }
 
+void QueryRunner::keep_schema_context() {
+    m_kept_schema_contexts.insert_or_assign(
+            m_schema,
+            SchemaContext{
+                    .expr = m_expr,
+                    .expression_value = m_expression_value,
+                    .expr_clp_query = m_expr_clp_query,
+                    .expr_var_match_map = m_expr_var_match_map,
+                    .wildcard_columns = m_wildcard_columns,
+                    .wildcard_to_searched_basic_columns = m_wildcard_to_searched_basic_columns,
+                    .wildcard_type_mask = m_wildcard_type_mask
+            }
+    );
+}
+
 void QueryRunner::clear_readers() {
     m_clp_string_readers.clear();
     m_var_string_readers.clear();
@@ -121,6 +239,252 @@ bool QueryRunner::filter(uint64_t cur_message) {
     return evaluate(m_expr.get(), m_schema);
 }
 
+void QueryRunner::filter_batch(uint64_t begin_message, std::vector<uint8_t>& selection) {
+    if (m_expression_value == EvaluatedValue::True) {
+        std::fill(selection.begin(), selection.end(), 1);
+        return;
+    }
+
+    std::vector<uint8_t> const active(selection.size(), 1);
+    evaluate_batch(m_expr.get(), begin_message, active, selection);
+}
+
+void QueryRunner::evaluate_batch(
+        Expression* expr,
+        uint64_t begin_message,
+        std::vector<uint8_t> const& active,
+        std::vector<uint8_t>& result
+) {
+    size_t const batch_size = active.size();
+    result.assign(batch_size, 0);
+
+    if (auto* filter_expr = dynamic_cast<FilterExpr*>(expr); nullptr != filter_expr) {
+        if (evaluate_filter_batch(filter_expr, begin_message, active, result)) {
+            for (size_t i = 0; i < batch_size; ++i) {
+                result[i] &= active[i];
+            }
+        } else {
+            bool const is_pure_wildcard = filter_expr->get_column()->is_pure_wildcard();
+            for (size_t i = 0; i < batch_size; ++i) {
+                if (0 == active[i]) {
+                    continue;
+                }
+                m_cur_message = begin_message + i;
+                m_extracted_unstructured_arrays.clear();
+                bool const matched = is_pure_wildcard
+                                             ? evaluate_wildcard_filter(filter_expr, m_schema)
+                                             : evaluate_filter(filter_expr, m_schema);
+                result[i] = matched ? 1 : 0;
+            }
+        }
+    } else if (dynamic_cast<AndExpr*>(expr)) {
+        // Each operand is only evaluated for the messages that matched all previous operands
+        result = active;
+        std::vector<uint8_t> operand_result(batch_size);
+        for (auto const& op : expr->get_op_list()) {
+            if (std::ranges::none_of(result, [](uint8_t selected) { return 0 != selected; })) {
+                break;
+            }
+            evaluate_batch(
+                    static_cast<Expression*>(op.get()),
+                    begin_message,
+                    result,
+                    operand_result
+            );
+            result.swap(operand_result);
+        }
+    } else if (dynamic_cast<OrExpr*>(expr)) {
+        // Each operand is only evaluated for the messages that didn't match any previous operand
+        std::vector<uint8_t> remaining = active;
+        std::vector<uint8_t> operand_result(batch_size);
+        for (auto const& op : expr->get_op_list()) {
+            if (std::ranges::none_of(remaining, [](uint8_t selected) { return 0 != selected; })) {
+                break;
+            }
+            evaluate_batch(
+                    static_cast<Expression*>(op.get()),
+                    begin_message,
+                    remaining,
+                    operand_result
+            );
+            for (size_t i = 0; i < batch_size; ++i) {
+                result[i] |= operand_result[i];
+                remaining[i] &= operand_result[i] ^ 1;
+            }
+        }
+    }
+
+    if (expr->is_inverted()) {
+        for (size_t i = 0; i < batch_size; ++i) {
+            result[i] = active[i] & (result[i] ^ 1);
+        }
+    }
+}
+
+bool QueryRunner::evaluate_filter_batch(
+        FilterExpr* expr,
+        uint64_t begin_message,
+        std::vector<uint8_t> const& active,
+        std::vector<uint8_t>& result
+) {
+    auto* column = expr->get_column().get();
+    if (column->is_pure_wildcard()) {
+        return false;
+    }
+
+    auto const op = expr->get_operation();
+    auto const& operand = expr->get_operand();
+    int32_t const column_id = column->get_column_id();
+    switch (column->get_literal_type()) {
+        case LiteralType::IntegerT: {
+            if (FilterOperation::EXISTS == op || FilterOperation::NEXISTS == op) {
+                std::fill(result.begin(), result.end(), 1);
+                return true;
+            }
+            int64_t op_value{};
+            if (false == operand->as_int(op_value, op)) {
+                return true;
+            }
+            for (BaseColumnReader* reader : m_basic_readers[column_id]) {
+                auto* int_reader = dynamic_cast<Int64ColumnReader*>(reader);
+                if (nullptr == int_reader) {
+                    // Earlier readers may have already matched some messages
+                    std::fill(result.begin(), result.end(), 0);
+                    return false;
+                }
+                evaluate_numeric_filter_batch(
+                        op,
+                        int_reader->get_values(),
+                        begin_message,
+                        op_value,
+                        result
+                );
+            }
+            return true;
+        }
+        case LiteralType::FloatT: {
+            if (FilterOperation::EXISTS == op || FilterOperation::NEXISTS == op) {
+                std::fill(result.begin(), result.end(), 1);
+                return true;
+            }
+            double op_value{};
+            if (false == operand->as_float(op_value, op)) {
+                return true;
+            }
+            for (BaseColumnReader* reader : m_basic_readers[column_id]) {
+                auto* float_reader = dynamic_cast<FloatColumnReader*>(reader);
+                if (nullptr == float_reader) {
+                    // Earlier readers may have already matched some messages
+                    std::fill(result.begin(), result.end(), 0);
+                    return false;
+                }
+                evaluate_numeric_filter_batch(
+                        op,
+                        float_reader->get_values(),
+                        begin_message,
+                        op_value,
+                        result
+                );
+            }
+            return true;
+        }
+        case LiteralType::BooleanT: {
+            if (FilterOperation::EXISTS == op || FilterOperation::NEXISTS == op) {
+                std::fill(result.begin(), result.end(), 1);
+                return true;
+            }
+            bool op_value{};
+            if (false == operand->as_bool(op_value, op)
+                || (FilterOperation::EQ != op && FilterOperation::NEQ != op))
+            {
+                return true;
+            }
+            // Booleans are stored as 0 or 1, so comparing against the encoded operand is
+            // equivalent to comparing the decoded values.
+            for (BaseColumnReader* reader : m_basic_readers[column_id]) {
+                auto* bool_reader = dynamic_cast<BooleanColumnReader*>(reader);
+                if (nullptr == bool_reader) {
+                    // Earlier readers may have already matched some messages
+                    std::fill(result.begin(), result.end(), 0);
+                    return false;
+                }
+                evaluate_numeric_filter_batch(
+                        op,
+                        bool_reader->get_values(),
+                        begin_message,
+                        static_cast<uint8_t>(op_value ? 1 : 0),
+                        result
+                );
+            }
+            return true;
+        }
+        case LiteralType::EpochDateT: {
+            if (FilterOperation::EXISTS == op || FilterOperation::NEXISTS == op) {
+                std::fill(result.begin(), result.end(), 1);
+                return true;
+            }
+            int64_t op_value{};
+            if (false == operand->as_int(op_value, op)) {
+                return true;
+            }
+            auto it = m_datestring_readers.find(column_id);
+            if (m_datestring_readers.end() == it) {
+                return false;
+            }
+            evaluate_numeric_filter_batch(
+                    op,
+                    it->second->get_encoded_times(),
+                    begin_message,
+                    op_value,
+                    result
+            );
+            return true;
+        }
+        case LiteralType::ClpStringT: {
+            if (FilterOperation::EXISTS == op || FilterOperation::NEXISTS == op) {
+                std::fill(result.begin(), result.end(), 1);
+                return true;
+            }
+            if (FilterOperation::EQ != op && FilterOperation::NEQ != op) {
+                return true;
+            }
+            static std::vector<ClpStringColumnReader*> const cNoReaders;
+            auto const it = m_clp_string_readers.find(column_id);
+            evaluate_clp_string_filter_batch(
+                    op,
+                    m_expr_clp_query.at(expr),
+                    m_clp_string_readers.end() == it ? cNoReaders : it->second,
+                    begin_message,
+                    active,
+                    result
+            );
+            return true;
+        }
+        case LiteralType::VarStringT: {
+            if (FilterOperation::EXISTS == op || FilterOperation::NEXISTS == op) {
+                std::fill(result.begin(), result.end(), 1);
+                return true;
+            }
+            if (FilterOperation::EQ != op && FilterOperation::NEQ != op) {
+                return true;
+            }
+            auto const* matching_vars = m_expr_var_match_map.at(expr);
+            bool const should_match = FilterOperation::EQ == op;
+            size_t const batch_size = result.size();
+            for (VariableStringColumnReader* reader : m_var_string_readers[column_id]) {
+                for (size_t i = 0; i < batch_size; ++i) {
+                    int64_t const id = reader->get_variable_id(begin_message + i);
+                    bool const matched = matching_vars->count(id) > 0;
+                    result[i] |= static_cast<uint8_t>(should_match == matched);
+                }
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
 bool QueryRunner::evaluate(Expression* expr, int32_t schema) {
     if (m_expression_value == EvaluatedValue::True) {
         return true;
@@ -444,6 +808,98 @@ bool QueryRunner::evaluate_clp_string_filter(
     return false;
 }
 
+void QueryRunner::evaluate_clp_string_filter_batch(
+        FilterOperation op,
+        Query const* q,
+        std::vector<ClpStringColumnReader*> const& readers,
+        uint64_t begin_message,
+        std::vector<uint8_t> const& active,
+        std::vector<uint8_t>& result
+) {
+    size_t const batch_size = result.size();
+    if (nullptr == q || q->search_string_matches_all()) {
+        // The outcome is the same for every message, even if the table has no readers for the
+        // column (see `evaluate_clp_string_filter`)
+        bool const matched = nullptr == q ? FilterOperation::NEQ == op : FilterOperation::EQ == op;
+        std::fill(result.begin(), result.end(), static_cast<uint8_t>(matched));
+        return;
+    }
+
+    bool const should_match = FilterOperation::EQ == op;
+    auto const wildcard_match = [&](ClpStringColumnReader* reader, uint64_t message) -> bool {
+        m_decoded_clp_string.clear();
+        reader->extract_string_value_into_buffer(message, m_decoded_clp_string);
+        return StringUtils::wildcard_match_unsafe(
+                m_decoded_clp_string,
+                q->get_search_string(),
+                !q->get_ignore_case()
+        );
+    };
+
+    if (false == q->contains_sub_queries()) {
+        for (ClpStringColumnReader* reader : readers) {
+            for (size_t i = 0; i < batch_size; ++i) {
+                if (0 == active[i] || 0 != result[i]) {
+                    continue;
+                }
+                bool const matched = wildcard_match(reader, begin_message + i);
+                result[i] = static_cast<uint8_t>(should_match == matched);
+            }
+        }
+        return;
+    }
+
+    auto const& subqueries_by_logtype = get_subqueries_by_logtype(q);
+    for (ClpStringColumnReader* reader : readers) {
+        // Consecutive messages often share a logtype, so remember the last lookup
+        int64_t prev_logtype_id{-1};
+        std::vector<SubQuery const*> const* subqueries{nullptr};
+        for (size_t i = 0; i < batch_size; ++i) {
+            if (0 == active[i] || 0 != result[i]) {
+                continue;
+            }
+
+            uint64_t const message = begin_message + i;
+            int64_t const logtype_id = reader->get_encoded_id(message);
+            if (logtype_id != prev_logtype_id) {
+                auto const it = subqueries_by_logtype.find(logtype_id);
+                subqueries = subqueries_by_logtype.end() == it ? nullptr : &it->second;
+                prev_logtype_id = logtype_id;
+            }
+
+            bool matched{false};
+            if (nullptr != subqueries) {
+                auto const vars = reader->get_encoded_vars(message);
+                for (auto const* subquery : *subqueries) {
+                    if (false == subquery->matches_vars(vars)) {
+                        continue;
+                    }
+                    if (subquery->wildcard_match_required()) {
+                        matched = wildcard_match(reader, message);
+                    } else {
+                        matched = true;
+                    }
+                    break;
+                }
+            }
+            result[i] = static_cast<uint8_t>(should_match == matched);
+        }
+    }
+}
+
+auto QueryRunner::get_subqueries_by_logtype(Query const* q)
+        -> std::unordered_map<int64_t, std::vector<SubQuery const*>> const& {
+    auto const [it, inserted] = m_query_to_subqueries_by_logtype.try_emplace(q);
+    if (inserted) {
+        for (auto const& subquery : q->get_sub_queries()) {
+            for (auto const* entry : subquery.get_possible_logtype_entries()) {
+                it->second[static_cast<int64_t>(entry->get_id())].push_back(&subquery);
+            }
+        }
+    }
+    return it->second;
+}
+
 bool QueryRunner::evaluate_var_string_filter(
         FilterOperation op,
         std::vector<VariableStringColumnReader*> const& readers,
@@ -1119,7 +1575,7 @@ EvaluatedValue QueryRunner::constant_propagate(std::shared_ptr<Expression> const
             auto& query_processing_result = m_string_query_map.at(filter_string);
             if (query_processing_result.has_value()) {
                 m_expr_clp_query[expr.get()] = &(query_processing_result.value());
-                return EvaluatedValue::Unknown;
+                return evaluate_filter_with_table_statistics(filter.get());
             } else {
                 m_expr_clp_query[expr.get()] = nullptr;
                 // If filter can not match then return it's guaranteed value based on
@@ -1151,16 +1607,129 @@ EvaluatedValue QueryRunner::constant_propagate(std::shared_ptr<Expression> const
                 // FIXME: throw
                 return EvaluatedValue::False;
             } else {
-                return EvaluatedValue::Unknown;
+                return evaluate_filter_with_table_statistics(filter.get());
             }
         } else {
-            return EvaluatedValue::Unknown;
+            return evaluate_filter_with_table_statistics(filter.get());
         }
     }
 
     return EvaluatedValue::Unknown;
 }
 
+auto QueryRunner::evaluate_filter_with_table_statistics(FilterExpr* filter) -> EvaluatedValue {
+    auto* column = filter->get_column().get();
+    if (column->is_pure_wildcard() || column->has_unresolved_tokens()) {
+        return EvaluatedValue::Unknown;
+    }
+
+    auto const* table_statistics = m_archive_reader->get_table_statistics(m_schema);
+    if (nullptr == table_statistics) {
+        return EvaluatedValue::Unknown;
+    }
+    auto const* column_statistics
+            = table_statistics->get_column_statistics(column->get_column_id());
+    if (nullptr == column_statistics) {
+        return EvaluatedValue::Unknown;
+    }
+
+    auto const op = filter->get_operation();
+    auto const& operand = filter->get_operand();
+    bool may_match{true};
+    switch (column->get_literal_type()) {
+        case LiteralType::IntegerT:
+        case LiteralType::EpochDateT: {
+            auto const* range = std::get_if<TableStatistics::IntegerRange>(column_statistics);
+            int64_t op_value{};
+            if (nullptr != range && operand->as_int(op_value, op)) {
+                may_match = range_may_contain_match(op, range->min, range->max, op_value);
+            }
+            break;
+        }
+        case LiteralType::FloatT: {
+            auto const* range = std::get_if<TableStatistics::FloatRange>(column_statistics);
+            double op_value{};
+            if (nullptr != range && operand->as_float(op_value, op)) {
+                may_match = range_may_contain_match(op, range->min, range->max, op_value);
+            }
+            break;
+        }
+        case LiteralType::ClpStringT: {
+            auto const* ids = std::get_if<TableStatistics::ClpStringIds>(column_statistics);
+            auto const* q = m_expr_clp_query.at(filter);
+            if (nullptr == ids || FilterOperation::EQ != op || nullptr == q
+                || q->search_string_matches_all() || false == q->contains_sub_queries())
+            {
+                break;
+            }
+
+            // A message can only match a subquery if it has one of the subquery's logtypes and
+            // contains each of the subquery's variables
+            auto const subquery_may_match = [&](SubQuery const& subquery) -> bool {
+                auto const& logtype_entries = subquery.get_possible_logtype_entries();
+                if (std::none_of(
+                            logtype_entries.begin(),
+                            logtype_entries.end(),
+                            [&](auto const* entry) {
+                                return ids->logtype_ids.possibly_contains(entry->get_id());
+                            }
+                    ))
+                {
+                    return false;
+                }
+                for (auto const& var : subquery.get_vars()) {
+                    if (var.is_precise_var()) {
+                        if (false == ids->encoded_vars.possibly_contains(var.get_precise_var())) {
+                            return false;
+                        }
+                        continue;
+                    }
+                    auto const& possible_vars = var.get_possible_dict_vars();
+                    if (std::none_of(
+                                possible_vars.begin(),
+                                possible_vars.end(),
+                                [&](auto possible_var) {
+                                    return ids->encoded_vars.possibly_contains(possible_var);
+                                }
+                        ))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            };
+            auto const& subqueries = q->get_sub_queries();
+            may_match = std::any_of(subqueries.begin(), subqueries.end(), subquery_may_match);
+            break;
+        }
+        case LiteralType::VarStringT: {
+            // Probing the filter for every matching variable isn't worth it for broad wildcard
+            // queries that match many variables
+            constexpr size_t cMaxNumMatchingVarsToProbe{1024};
+            auto const* ids = std::get_if<TableStatistics::VarStringIds>(column_statistics);
+            auto const* matching_vars = m_expr_var_match_map.at(filter);
+            if (nullptr == ids || FilterOperation::EQ != op
+                || matching_vars->size() > cMaxNumMatchingVarsToProbe)
+            {
+                break;
+            }
+            may_match = std::any_of(
+                    matching_vars->begin(),
+                    matching_vars->end(),
+                    [&](int64_t var_id) { return ids->var_ids.possibly_contains(var_id); }
+            );
+            break;
+        }
+        default:
+            break;
+    }
+
+    if (may_match) {
+        return EvaluatedValue::Unknown;
+    }
+    return filter->is_inverted() ? EvaluatedValue::True : EvaluatedValue::False;
+}
+
 bool QueryRunner::evaluate_epoch_date_filter(
         FilterOperation op,
         DateStringColumnReader* reader,
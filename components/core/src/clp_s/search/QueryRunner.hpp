@@ -22,6 +22,7 @@
 #include "../ReaderUtils.hpp"
 #include "../SchemaReader.hpp"
 #include "../SchemaTree.hpp"
+#include "../TableStatistics.hpp"
 #include "../TimestampDictionaryReader.hpp"
 #include "../Utils.hpp"
 #include "ast/ColumnDescriptor.hpp"
@@ -89,10 +90,19 @@ public:
      */
     auto schema_init(int32_t schema_id) -> EvaluatedValue;
 
+    /**
+     * Keeps the context initialized by the last call to `schema_init`, so that the next call to
+     * `schema_init` for the same schema restores it instead of initializing it again. Kept contexts
+     * are discarded by `global_init`.
+     */
+    void keep_schema_context();
+
 protected:
     // Methods inherited from FilterClass
     auto filter(uint64_t cur_message) -> bool override;
 
+    void filter_batch(uint64_t begin_message, std::vector<uint8_t>& selection) override;
+
     /**
      * Clears all column readers.
      */
@@ -113,6 +123,17 @@ private:
         Filter
     };
 
+    // The query processing context initialized by `schema_init` for a schema
+    struct SchemaContext {
+        std::shared_ptr<ast::Expression> expr;
+        EvaluatedValue expression_value{EvaluatedValue::Unknown};
+        std::unordered_map<ast::Expression*, Query*> expr_clp_query;
+        std::unordered_map<ast::Expression*, std::unordered_set<int64_t>*> expr_var_match_map;
+        std::vector<ast::ColumnDescriptor*> wildcard_columns;
+        std::map<ast::ColumnDescriptor*, std::set<int32_t>> wildcard_to_searched_basic_columns;
+        ast::literal_type_bitmask_t wildcard_type_mask{0};
+    };
+
     std::shared_ptr<ArchiveReader> m_archive_reader;
     std::shared_ptr<ast::Expression> m_expr;
     std::shared_ptr<SchemaMatch> m_match;
@@ -134,6 +155,9 @@ private:
     std::map<std::string, std::unordered_set<int64_t>> m_string_var_match_map;
     std::unordered_map<ast::Expression*, Query*> m_expr_clp_query;
     std::unordered_map<ast::Expression*, std::unordered_set<int64_t>*> m_expr_var_match_map;
+    std::unordered_map<Query const*, std::unordered_map<int64_t, std::vector<SubQuery const*>>>
+            m_query_to_subqueries_by_logtype;
+    std::string m_decoded_clp_string;
     std::unordered_map<int32_t, std::vector<ClpStringColumnReader*>> m_clp_string_readers;
     std::unordered_map<int32_t, std::vector<VariableStringColumnReader*>> m_var_string_readers;
     std::unordered_map<int32_t, DateStringColumnReader*> m_datestring_readers;
@@ -146,6 +170,7 @@ private:
     std::map<ast::ColumnDescriptor*, std::set<int32_t>> m_wildcard_to_searched_basic_columns;
     ast::literal_type_bitmask_t m_wildcard_type_mask{0};
     std::unordered_set<int32_t> m_metadata_columns;
+    std::unordered_map<int32_t, SchemaContext> m_kept_schema_contexts;
 
     std::stack<
             std::pair<ExpressionType, ast::OpList::iterator>,
@@ -173,6 +198,40 @@ private:
      */
     auto evaluate(ast::Expression* expr, int32_t schema) -> bool;
 
+    /**
+     * Evaluates an expression over a batch of messages. Only messages whose entry in `active` is
+     * non-zero are evaluated, which preserves the short-circuiting behaviour of `evaluate`; the
+     * result for every other message is zero.
+     * @param expr
+     * @param begin_message
+     * @param active
+     * @param result Returns 1 for every active message that matches the expression and 0 otherwise
+     */
+    void evaluate_batch(
+            ast::Expression* expr,
+            uint64_t begin_message,
+            std::vector<uint8_t> const& active,
+            std::vector<uint8_t>& result
+    );
+
+    /**
+     * Evaluates a filter expression over a batch of messages by operating directly on the values
+     * stored in the column readers. Only int, float, bool, epoch date, clp string, and var string
+     * filters on resolved columns are supported.
+     * @param expr
+     * @param begin_message
+     * @param active Messages whose entry is zero may be skipped
+     * @param result Returns 1 for every active message that matches the filter, ignoring inversion
+     * @return true if the filter was evaluated, false if it must be evaluated message by message
+     * (in which case every entry of `result` is zero)
+     */
+    auto evaluate_filter_batch(
+            ast::FilterExpr* expr,
+            uint64_t begin_message,
+            std::vector<uint8_t> const& active,
+            std::vector<uint8_t>& result
+    ) -> bool;
+
     /**
      * Evaluates a filter expression
      * @param expr
@@ -248,6 +307,35 @@ private:
             std::vector<ClpStringColumnReader*> const& readers
     ) const -> bool;
 
+    /**
+     * Evaluates a clp string filter expression over a batch of messages. Messages are matched
+     * against the query's subqueries using their encoded logtypes and variables; only messages
+     * that match a subquery requiring a wildcard match (or a query without subqueries) are
+     * decoded.
+     * @param op
+     * @param q
+     * @param readers
+     * @param begin_message
+     * @param active
+     * @param result Returns 1 for every active message that matches the filter
+     */
+    void evaluate_clp_string_filter_batch(
+            ast::FilterOperation op,
+            Query const* q,
+            std::vector<ClpStringColumnReader*> const& readers,
+            uint64_t begin_message,
+            std::vector<uint8_t> const& active,
+            std::vector<uint8_t>& result
+    );
+
+    /**
+     * @param q
+     * @return The query's subqueries indexed by each logtype they can match, in the order they
+     * appear in the query
+     */
+    auto get_subqueries_by_logtype(Query const* q)
+            -> std::unordered_map<int64_t, std::vector<SubQuery const*>> const&;
+
     /**
      * Evaluates a var string filter expression
      * @param op
@@ -411,6 +499,16 @@ private:
      */
     auto constant_propagate(std::shared_ptr<ast::Expression> const& expr) -> EvaluatedValue;
 
+    /**
+     * Uses the statistics recorded for the current schema's table to check whether a filter can
+     * match any message in the table, without reading the table.
+     * @param filter
+     * @return EvaluatedValue::False, or EvaluatedValue::True if the filter is inverted, when the
+     * statistics show that no message in the table can match the filter
+     * @return EvaluatedValue::Unknown otherwise
+     */
+    auto evaluate_filter_with_table_statistics(ast::FilterExpr* filter) -> EvaluatedValue;
+
     /**
      * Populates searched wildcard columns
      * @param expr
@@ -40,6 +40,12 @@ public:
 
     bool is_dict_var() const { return m_is_dict_var; }
 
+    encoded_variable_t get_precise_var() const { return m_precise_var; }
+
+    std::unordered_set<encoded_variable_t> const& get_possible_dict_vars() const {
+        return m_possible_dict_vars;
+    }
+
     VariableDictionaryEntry const* get_var_dict_entry() const { return m_var_dict_entry; }
 
     std::unordered_set<VariableDictionaryEntry const*> const&
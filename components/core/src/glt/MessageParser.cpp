@@ -1,5 +1,7 @@
 #include "MessageParser.hpp"
 
+#include <algorithm>
+
 #include "Defs.h"
 #include "TimestampPattern.hpp"
 
@@ -62,6 +64,8 @@ bool MessageParser::parse_next_message(
 
             if (m_line.empty()) {
                 if (m_buffered_msg.is_empty()) {
+                    // The next file may use different timestamp formats
+                    m_recent_ts_patterns.fill(nullptr);
                     break;
                 } else {
                     message.consume(m_buffered_msg);
@@ -109,8 +113,8 @@ bool MessageParser::parse_line(ParsedMessage& message) {
                            timestamp_end_pos
                    ))
     {
-        timestamp_pattern = TimestampPattern::search_known_ts_patterns(
-                m_line,
+        timestamp_pattern = search_ts_patterns(
+                timestamp_pattern,
                 timestamp,
                 timestamp_begin_pos,
                 timestamp_end_pos
@@ -163,4 +167,42 @@ bool MessageParser::parse_line(ParsedMessage& message) {
     m_line.clear();
     return message_completed;
 }
+
+TimestampPattern const* MessageParser::search_ts_patterns(
+        TimestampPattern const* pattern_to_skip,
+        epochtime_t& timestamp,
+        size_t& timestamp_begin_pos,
+        size_t& timestamp_end_pos
+) {
+    for (auto it = m_recent_ts_patterns.begin();
+         m_recent_ts_patterns.end() != it && nullptr != *it;
+         ++it)
+    {
+        auto const* pattern = *it;
+        if (pattern != pattern_to_skip
+            && pattern->parse_timestamp(m_line, timestamp, timestamp_begin_pos, timestamp_end_pos))
+        {
+            // Move the pattern to the front
+            std::rotate(m_recent_ts_patterns.begin(), it, it + 1);
+            return pattern;
+        }
+    }
+
+    auto const* pattern = TimestampPattern::search_known_ts_patterns(
+            m_line,
+            timestamp,
+            timestamp_begin_pos,
+            timestamp_end_pos
+    );
+    if (nullptr != pattern) {
+        // Evict the least recent pattern
+        std::rotate(
+                m_recent_ts_patterns.begin(),
+                m_recent_ts_patterns.end() - 1,
+                m_recent_ts_patterns.end()
+        );
+        m_recent_ts_patterns.front() = pattern;
+    }
+    return pattern;
+}
 }  // namespace glt
@@ -1,11 +1,15 @@
 #ifndef GLT_MESSAGEPARSER_HPP
 #define GLT_MESSAGEPARSER_HPP
 
+#include <array>
+#include <cstddef>
 #include <string>
 
+#include "Defs.h"
 #include "ErrorCode.hpp"
 #include "ParsedMessage.hpp"
 #include "ReaderInterface.hpp"
+#include "TimestampPattern.hpp"
 #include "TraceableException.hpp"
 
 namespace glt {
@@ -65,9 +69,32 @@ private:
      */
     bool parse_line(ParsedMessage& message);
 
+    /**
+     * Searches for a timestamp pattern which can parse the timestamp from the current line, trying
+     * the patterns that most recently parsed a line before all known patterns
+     * @param pattern_to_skip A pattern that has already failed to parse the line
+     * @param timestamp Parsed timestamp
+     * @param timestamp_begin_pos
+     * @param timestamp_end_pos
+     * @return pointer to the timestamp pattern if found, nullptr otherwise
+     */
+    TimestampPattern const* search_ts_patterns(
+            TimestampPattern const* pattern_to_skip,
+            epochtime_t& timestamp,
+            size_t& timestamp_begin_pos,
+            size_t& timestamp_end_pos
+    );
+
+    // Constants
+    static constexpr size_t cNumRecentTsPatterns = 4;
+
     // Variables
     std::string m_line;
     ParsedMessage m_buffered_msg;
+    // Known timestamp patterns that most recently parsed a line in the current file, from most to
+    // least recent. Files often interleave a few timestamp formats, so this avoids searching every
+    // known pattern whenever the format changes.
+    std::array<TimestampPattern const*, cNumRecentTsPatterns> m_recent_ts_patterns{};
 };
 }  // namespace glt
 
@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <memory>
 
+#include "../clp/TimestampPatternPrefilter.hpp"
 #include "Defs.h"
 #include "FileWriter.hpp"
 #include "TraceableException.hpp"
@@ -74,7 +75,8 @@ public:
 
     /**
      * Searches for a known timestamp pattern which can parse the timestamp from the given line, and
-     * if found, parses the timestamp
+     * if found, parses the timestamp. Patterns which can't match the layout of the line's leading
+     * bytes are skipped without being parsed.
      * @param line
      * @param timestamp Parsed timestamp
      * @param timestamp_begin_pos
@@ -150,6 +152,7 @@ public:
 private:
     // Variables
     static std::unique_ptr<TimestampPattern[]> m_known_ts_patterns;
+    static std::unique_ptr<clp::TimestampPatternPrefilter[]> m_known_ts_pattern_prefilters;
     static size_t m_known_ts_patterns_len;
 
     // The number of spaces before the timestamp in a message
@@ -0,0 +1,53 @@
+#ifndef TESTS_BENCHMARK_UTILS_HPP
+#define TESTS_BENCHMARK_UTILS_HPP
+
+#include <string_view>
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include "../src/clp/Stopwatch.hpp"
+
+/**
+ * Times an implementation against the baseline it replaces and reports both times using `WARN`.
+ *
+ * This helper uses `REQUIRE` to assert that both implementations return the same result.
+ *
+ * @tparam Implementation A callable that takes no arguments
+ * @tparam Baseline A callable that takes no arguments and returns the same type as `Implementation`
+ * @param implementation_name
+ * @param implementation
+ * @param baseline_name
+ * @param baseline
+ * @param workload A description of the work done by each callable (e.g., "1000 lines")
+ */
+template <typename Implementation, typename Baseline>
+void benchmark_against_baseline(
+        std::string_view implementation_name,
+        Implementation implementation,
+        std::string_view baseline_name,
+        Baseline baseline,
+        std::string_view workload
+) {
+    clp::Stopwatch implementation_stopwatch;
+    implementation_stopwatch.start();
+    auto const implementation_result = implementation();
+    implementation_stopwatch.stop();
+
+    clp::Stopwatch baseline_stopwatch;
+    baseline_stopwatch.start();
+    auto const baseline_result = baseline();
+    baseline_stopwatch.stop();
+
+    REQUIRE((baseline_result == implementation_result));
+    WARN(fmt::format(
+            "{} took {:.3f}s, {} took {:.3f}s for {}",
+            implementation_name,
+            implementation_stopwatch.get_time_taken_in_seconds(),
+            baseline_name,
+            baseline_stopwatch.get_time_taken_in_seconds(),
+            workload
+    ));
+}
+
+#endif  // TESTS_BENCHMARK_UTILS_HPP
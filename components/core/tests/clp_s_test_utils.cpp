@@ -1,6 +1,8 @@
 #include "clp_s_test_utils.hpp"
 
+#include <cstddef>
 #include <filesystem>
+#include <optional>
 #include <string>
 
 #include <catch2/catch.hpp>
@@ -14,7 +16,9 @@ void compress_archive(
         std::string const& archive_directory,
         bool single_file_archive,
         bool structurize_arrays,
-        clp_s::CommandLineArguments::FileType file_type
+        clp_s::CommandLineArguments::FileType file_type,
+        size_t num_threads,
+        std::optional<std::string> const& timestamp_key
 ) {
     constexpr auto cDefaultTargetEncodedSize{8ULL * 1024 * 1024 * 1024};  // 8 GiB
     constexpr auto cDefaultMaxDocumentSize{512ULL * 1024 * 1024};  // 512 MiB
@@ -38,6 +42,10 @@ void compress_archive(
     parser_option.structurize_arrays = structurize_arrays;
     parser_option.single_file_archive = single_file_archive;
     parser_option.input_file_type = file_type;
+    parser_option.num_threads = num_threads;
+    if (timestamp_key.has_value()) {
+        parser_option.timestamp_key = timestamp_key.value();
+    }
 
     clp_s::JsonParser parser{parser_option};
     if (clp_s::CommandLineArguments::FileType::Json == file_type) {
@@ -1,5 +1,7 @@
 #ifndef CLP_S_TEST_UTILS_HPP
 #define CLP_S_TEST_UTILS_HPP
+#include <cstddef>
+#include <optional>
 #include <string>
 
 #include "../src/clp_s/CommandLineArguments.hpp"
@@ -14,12 +16,16 @@
  * @param single_file_archive
  * @param structurize_arrays
  * @param file_type
+ * @param num_threads
+ * @param timestamp_key The key of the authoritative timestamp, if any
  */
 void compress_archive(
         std::string const& file_path,
         std::string const& archive_directory,
         bool single_file_archive,
         bool structurize_arrays,
-        clp_s::CommandLineArguments::FileType file_type
+        clp_s::CommandLineArguments::FileType file_type,
+        size_t num_threads,
+        std::optional<std::string> const& timestamp_key = std::nullopt
 );
 #endif  // CLP_S_TEST_UTILS_HPP
@@ -0,0 +1,144 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include "../src/clp/ArenaBackedStringMap.hpp"
+#include "benchmark_utils.hpp"
+
+using clp::ArenaBackedStringMap;
+using std::string;
+using std::string_view;
+using std::vector;
+
+namespace {
+/**
+ * Generates random values resembling high-cardinality variables (e.g., UUIDs and IP addresses)
+ * @param num_values
+ * @return The values, which may contain duplicates
+ */
+auto generate_values(size_t num_values) -> vector<string>;
+
+auto generate_values(size_t num_values) -> vector<string> {
+    std::mt19937_64 generator{0};
+    std::uniform_int_distribution<uint64_t> uuid_part_distribution;
+    std::uniform_int_distribution<int> ip_octet_distribution{0, 255};
+    std::uniform_int_distribution<int> uuid_or_ip_distribution{0, 1};
+
+    vector<string> values;
+    values.reserve(num_values);
+    for (size_t i = 0; i < num_values; ++i) {
+        if (0 == uuid_or_ip_distribution(generator)) {
+            auto const high = uuid_part_distribution(generator);
+            auto const low = uuid_part_distribution(generator);
+            values.emplace_back(fmt::format(
+                    "{:08x}-{:04x}-{:04x}-{:04x}-{:012x}",
+                    high >> 32,
+                    (high >> 16) & 0xFFFF,
+                    high & 0xFFFF,
+                    low >> 48,
+                    low & 0xFFFF'FFFF'FFFF
+            ));
+        } else {
+            values.emplace_back(fmt::format(
+                    "{}.{}.{}.{}",
+                    ip_octet_distribution(generator),
+                    ip_octet_distribution(generator),
+                    ip_octet_distribution(generator),
+                    ip_octet_distribution(generator)
+            ));
+        }
+    }
+    return values;
+}
+}  // namespace
+
+TEST_CASE("ArenaBackedStringMap", "[ArenaBackedStringMap]") {
+    ArenaBackedStringMap<uint64_t> map;
+    REQUIRE(map.empty());
+    REQUIRE(nullptr == map.find("value"));
+
+    SECTION("Empty keys") {
+        auto const [empty_value, is_inserted] = map.try_emplace("", 1);
+        REQUIRE(is_inserted);
+        REQUIRE(1 == *empty_value);
+        REQUIRE(nullptr != map.find(""));
+        REQUIRE(nullptr == map.find(string_view{"\0", 1}));
+        REQUIRE(1 == map.size());
+    }
+
+    SECTION("Keys are mapped to the first value inserted") {
+        REQUIRE(map.try_emplace("value", 1).second);
+        auto const [value, is_inserted] = map.try_emplace("value", 2);
+        REQUIRE(false == is_inserted);
+        REQUIRE(1 == *value);
+        REQUIRE(1 == *map.find(string{"value"}));
+        REQUIRE(nullptr == map.find("valu"));
+        REQUIRE(nullptr == map.find("values"));
+        REQUIRE(1 == map.size());
+        REQUIRE(5 == map.get_arena_size());
+    }
+
+    SECTION("The map grows") {
+        // Enough values to grow the table several times
+        auto const values = generate_values(20'000);
+        std::unordered_map<string, uint64_t> expected_map;
+        for (auto const& value : values) {
+            auto const [it, is_expected_inserted]
+                    = expected_map.try_emplace(value, expected_map.size());
+            auto const [map_value, is_inserted] = map.try_emplace(value, it->second);
+            REQUIRE(is_expected_inserted == is_inserted);
+            REQUIRE(it->second == *map_value);
+        }
+        REQUIRE(expected_map.size() == map.size());
+        for (auto const& [value, id] : expected_map) {
+            auto const* map_value = map.find(value);
+            REQUIRE(nullptr != map_value);
+            REQUIRE(id == *map_value);
+        }
+
+        map.clear();
+        REQUIRE(map.empty());
+        REQUIRE(0 == map.get_arena_size());
+        REQUIRE(nullptr == map.find(values.front()));
+        REQUIRE(map.try_emplace(values.front(), 0).second);
+    }
+}
+
+TEST_CASE("Benchmark ArenaBackedStringMap", "[.][ArenaBackedStringMap][benchmark]") {
+    constexpr size_t cNumValues{1'000'000};
+
+    auto const values = generate_values(cNumValues);
+
+    // Look up each value before inserting it, as a dictionary writer does
+    benchmark_against_baseline(
+            "ArenaBackedStringMap",
+            [&]() {
+                ArenaBackedStringMap<uint64_t> map;
+                for (auto const& value : values) {
+                    if (nullptr == map.find(value)) {
+                        map.try_emplace(value, map.size());
+                    }
+                }
+                return map.size();
+            },
+            // Baseline: a node-based map keyed by strings, as the dictionary writers used to use
+            "std::unordered_map",
+            [&]() {
+                std::unordered_map<string, uint64_t> map;
+                for (auto const& value : values) {
+                    if (map.end() == map.find(value)) {
+                        map[value] = map.size();
+                    }
+                }
+                return map.size();
+            },
+            fmt::format("{} values", cNumValues)
+    );
+}
@@ -0,0 +1,96 @@
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "../src/clp/DictionaryWildcardIndex.hpp"
+#include "../src/clp/string_utils/string_utils.hpp"
+
+using clp::DictionaryWildcardIndex;
+using clp::string_utils::wildcard_match_unsafe;
+
+TEST_CASE("DictionaryWildcardIndex_literal_prefix_and_suffix", "[DictionaryWildcardIndex]") {
+    std::string prefix;
+    std::string suffix;
+
+    DictionaryWildcardIndex::get_literal_prefix_and_suffix("user_12*", prefix, suffix);
+    REQUIRE(prefix == "user_12");
+    REQUIRE(suffix.empty());
+
+    DictionaryWildcardIndex::get_literal_prefix_and_suffix("*timeout", prefix, suffix);
+    REQUIRE(prefix.empty());
+    REQUIRE(suffix == "timeout");
+
+    DictionaryWildcardIndex::get_literal_prefix_and_suffix("ab?cd*ef", prefix, suffix);
+    REQUIRE(prefix == "ab");
+    REQUIRE(suffix == "ef");
+
+    DictionaryWildcardIndex::get_literal_prefix_and_suffix("*infix*", prefix, suffix);
+    REQUIRE(prefix.empty());
+    REQUIRE(suffix.empty());
+
+    // Escaped wildcards are literals
+    DictionaryWildcardIndex::get_literal_prefix_and_suffix(R"(a\*b*c\?)", prefix, suffix);
+    REQUIRE(prefix == "a*b");
+    REQUIRE(suffix == "c?");
+
+    // Strings without wildcards are entirely literal
+    DictionaryWildcardIndex::get_literal_prefix_and_suffix("abc", prefix, suffix);
+    REQUIRE(prefix == "abc");
+    REQUIRE(suffix == "abc");
+}
+
+TEST_CASE("DictionaryWildcardIndex_candidate_ids", "[DictionaryWildcardIndex]") {
+    std::vector<std::string> const values{
+            "user_12",
+            "user_123",
+            "user_2",
+            "connection timeout",
+            "read timeout",
+            "timeout exceeded",
+            "",
+            "user",
+            "us"
+    };
+    std::vector<std::string_view> const value_views{values.cbegin(), values.cend()};
+    DictionaryWildcardIndex const index{value_views};
+
+    auto get_matching_ids = [&](std::string_view wildcard_string) {
+        auto const candidate_ids = index.get_candidate_ids(wildcard_string);
+        REQUIRE(candidate_ids.has_value());
+        std::set<uint64_t> ids;
+        for (auto const id : candidate_ids.value()) {
+            if (wildcard_match_unsafe(values[id], wildcard_string, true)) {
+                ids.insert(id);
+            }
+        }
+        return ids;
+    };
+    auto get_expected_ids = [&](std::string_view wildcard_string) {
+        std::set<uint64_t> ids;
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (wildcard_match_unsafe(values[i], wildcard_string, true)) {
+                ids.insert(i);
+            }
+        }
+        return ids;
+    };
+
+    for (std::string_view const wildcard_string :
+         {"user_12*", "*timeout", "user*", "u*2", "*timeout*", "?ead timeout", "us", "x*"})
+    {
+        if ("*timeout*" == wildcard_string) {
+            REQUIRE_FALSE(index.get_candidate_ids(wildcard_string).has_value());
+            continue;
+        }
+        REQUIRE(get_matching_ids(wildcard_string) == get_expected_ids(wildcard_string));
+    }
+
+    REQUIRE(index.get_candidate_ids("user_12*").value().size() == 2);
+    REQUIRE(index.get_candidate_ids("*timeout").value().size() == 2);
+    REQUIRE(index.get_candidate_ids("x*").value().empty());
+}
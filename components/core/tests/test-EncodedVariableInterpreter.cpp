@@ -1,8 +1,14 @@
 #include <unistd.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
 #include <catch2/catch.hpp>
 
 #include "../src/clp/EncodedVariableInterpreter.hpp"
+#include "../src/clp/LogTypeDictionaryWriter.hpp"
+#include "../src/clp/ffi/ir_stream/encoding_methods.hpp"
 #include "../src/clp/ir/types.hpp"
 #include "../src/clp/streaming_archive/Constants.hpp"
 
@@ -421,6 +427,90 @@ TEST_CASE("EncodedVariableInterpreter", "[EncodedVariableInterpreter]") {
         REQUIRE(0 == unlink(cVarSegmentIndexPath.data()));
     }
 
+    SECTION("Test encoding concurrently") {
+        constexpr std::string_view cVarDictPath{"var.dict"};
+        constexpr std::string_view cVarSegmentIndexPath{"var.segindex"};
+        constexpr std::string_view cLogTypeDictPath{"logtype.dict"};
+        constexpr std::string_view cLogTypeSegmentIndexPath{"logtype.segindex"};
+        constexpr size_t cNumThreads{4};
+        constexpr size_t cNumMessages{2000};
+
+        clp::VariableDictionaryWriter var_dict_writer;
+        var_dict_writer.open(
+                std::string{cVarDictPath},
+                std::string{cVarSegmentIndexPath},
+                cVariableDictionaryIdMax
+        );
+        clp::LogTypeDictionaryWriter logtype_dict_writer;
+        logtype_dict_writer.open(
+                std::string{cLogTypeDictPath},
+                std::string{cLogTypeSegmentIndexPath},
+                clp::cLogtypeDictionaryIdMax
+        );
+
+        // Each thread encodes the same messages, in a different order, into the shared
+        // dictionaries
+        vector<vector<clp::variable_dictionary_id_t>> thread_var_ids(cNumThreads);
+        vector<vector<clp::logtype_dictionary_id_t>> thread_logtype_ids(cNumThreads);
+        auto encode_messages = [&](size_t thread_ix) {
+            clp::LogTypeDictionaryEntry logtype_dict_entry;
+            vector<encoded_variable_t> encoded_vars;
+            vector<clp::variable_dictionary_id_t> var_ids;
+            auto& logtype_ids = thread_logtype_ids[thread_ix];
+            logtype_ids.resize(cNumMessages);
+            auto& user_var_ids = thread_var_ids[thread_ix];
+            user_var_ids.resize(cNumMessages);
+            for (size_t i = 0; i < cNumMessages; ++i) {
+                auto const msg_ix = (i + thread_ix * cNumMessages / cNumThreads) % cNumMessages;
+                encoded_vars.clear();
+                var_ids.clear();
+                EncodedVariableInterpreter::encode_and_add_to_dictionary(
+                        "user" + to_string(msg_ix) + " logged in to host" + to_string(msg_ix % 7)
+                                + " with logtype " + string(msg_ix % 11, 'x'),
+                        logtype_dict_entry,
+                        var_dict_writer,
+                        encoded_vars,
+                        var_ids
+                );
+                logtype_dict_writer.add_entry(logtype_dict_entry, logtype_ids[msg_ix]);
+                // Catch2's assertions aren't thread-safe, so the IDs are validated below
+                user_var_ids[msg_ix] = var_ids.at(0);
+            }
+        };
+        vector<std::thread> threads;
+        for (size_t i = 0; i < cNumThreads; ++i) {
+            threads.emplace_back(encode_messages, i);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        var_dict_writer.close();
+        logtype_dict_writer.close();
+
+        // Every thread should've been assigned the same ID for each value
+        for (size_t i = 1; i < cNumThreads; ++i) {
+            REQUIRE(thread_logtype_ids[i] == thread_logtype_ids[0]);
+            REQUIRE(thread_var_ids[i] == thread_var_ids[0]);
+        }
+
+        clp::VariableDictionaryReader var_dict_reader;
+        var_dict_reader.open(std::string{cVarDictPath}, std::string{cVarSegmentIndexPath});
+        var_dict_reader.read_new_entries();
+        // cNumMessages user vars plus 7 host vars
+        REQUIRE(var_dict_reader.get_entries().size() == cNumMessages + 7);
+        auto const& user_var_ids = thread_var_ids[0];
+        for (size_t i = 0; i < cNumMessages; ++i) {
+            REQUIRE(var_dict_reader.get_value(user_var_ids[i]) == "user" + to_string(i));
+        }
+        var_dict_reader.close();
+
+        // Clean-up
+        REQUIRE(0 == unlink(cVarDictPath.data()));
+        REQUIRE(0 == unlink(cVarSegmentIndexPath.data()));
+        REQUIRE(0 == unlink(cLogTypeDictPath.data()));
+        REQUIRE(0 == unlink(cLogTypeSegmentIndexPath.data()));
+    }
+
     SECTION("Test encoding and decoding") {
         string msg;
 
@@ -568,6 +658,49 @@ TEST_CASE("EncodedVariableInterpreter", "[EncodedVariableInterpreter]") {
         ));
         REQUIRE(msg == decompressed_msg);
 
+        // Test converting into IR, which should match encoding the decompressed message as IR
+        string ir_logtype;
+        vector<clp::ir::four_byte_encoded_variable_t> ir_encoded_vars;
+        string ir_dict_vars;
+        vector<size_t> ir_dict_var_end_offsets;
+        REQUIRE(EncodedVariableInterpreter::convert_to_four_byte_ir_message(
+                logtype_dict_entry,
+                var_dict_reader,
+                encoded_vars,
+                ir_logtype,
+                ir_encoded_vars,
+                ir_dict_vars,
+                ir_dict_var_end_offsets
+        ));
+        vector<int8_t> converted_ir_buf;
+        REQUIRE(clp::ffi::ir_stream::four_byte_encoding::serialize_encoded_message(
+                ir_logtype,
+                ir_encoded_vars,
+                ir_dict_vars,
+                ir_dict_var_end_offsets,
+                converted_ir_buf
+        ));
+        string encoded_logtype;
+        vector<int8_t> encoded_ir_buf;
+        REQUIRE(clp::ffi::ir_stream::four_byte_encoding::serialize_message(
+                msg,
+                encoded_logtype,
+                encoded_ir_buf
+        ));
+        REQUIRE(encoded_logtype == ir_logtype);
+        REQUIRE(encoded_ir_buf == converted_ir_buf);
+
+        // Serializing with a missing dictionary variable should fail
+        ir_dict_var_end_offsets.pop_back();
+        REQUIRE(false
+                == clp::ffi::ir_stream::four_byte_encoding::serialize_encoded_message(
+                        ir_logtype,
+                        ir_encoded_vars,
+                        ir_dict_vars,
+                        ir_dict_var_end_offsets,
+                        converted_ir_buf
+                ));
+
         var_dict_reader.close();
 
         // Clean-up
@@ -0,0 +1,213 @@
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include "../src/clp/BufferedFileReader.hpp"
+#include "../src/clp/BufferReader.hpp"
+#include "../src/clp/Defs.h"
+#include "../src/clp/MessageParser.hpp"
+#include "../src/clp/ParsedMessage.hpp"
+#include "../src/clp/TimestampPattern.hpp"
+#include "benchmark_utils.hpp"
+#include "TestOutputCleaner.hpp"
+
+using clp::BufferedFileReader;
+using clp::BufferReader;
+using clp::epochtime_t;
+using clp::MessageParser;
+using clp::ParsedMessage;
+using clp::TimestampPattern;
+using std::string;
+using std::vector;
+
+constexpr std::string_view cTestMessageParserInputFile{"test-MessageParser-input.log"};
+// Same as BufferedFileReader's default buffer size, which the compressors use
+constexpr size_t cDefaultBufferSize{16 * BufferedFileReader::cMinBufferSize};
+
+namespace {
+struct Message {
+    string content;
+    epochtime_t timestamp;
+    size_t orig_num_bytes;
+    string ts_pattern_format;
+
+    auto operator==(Message const& rhs) const -> bool = default;
+};
+
+/**
+ * Generates log content containing single-line messages with and without timestamps, multiline
+ * messages, and a last line without a line break
+ * @param num_messages
+ * @return The content
+ */
+auto generate_content(size_t num_messages) -> string;
+
+/**
+ * Writes the given content to the test input file
+ * @param content
+ */
+void write_input_file(string const& content);
+
+/**
+ * @param message
+ * @return A copy of the given parsed message
+ */
+auto copy_message(ParsedMessage const& message) -> Message;
+
+/**
+ * Parses the given content using a reader
+ * @param content
+ * @return The parsed messages
+ */
+auto parse_with_reader(string const& content) -> vector<Message>;
+
+/**
+ * Parses the given content in place, in chunks of the given size
+ * @param content
+ * @param chunk_size
+ * @return The parsed messages
+ */
+auto parse_in_place(string const& content, size_t chunk_size) -> vector<Message>;
+
+/**
+ * Parses the test input file using a reader
+ * @param buffer_size The reader's buffer size
+ * @return The parsed messages
+ */
+auto parse_file_with_reader(size_t buffer_size) -> vector<Message>;
+
+auto generate_content(size_t num_messages) -> string {
+    string content{"Message without a timestamp before the first timestamp\n"};
+    for (size_t i = 0; i < num_messages; ++i) {
+        content += fmt::format(
+                "2015-02-01T01:02:{:02}.{:03} INFO Task {} finished in {}ms\n",
+                i % 60,
+                i % 1000,
+                i,
+                i * 3
+        );
+        if (0 == i % 5) {
+            content += fmt::format("\tat com.example.Task.run(Task.java:{})\n", i);
+            content += "\tat java.lang.Thread.run(Thread.java:750)\n";
+        }
+        if (0 == i % 7) {
+            content += fmt::format("[{}/Feb/2015:01:02:03 GET /index.html\n", (i % 28) + 1);
+        }
+    }
+    content += "2015-02-01 01:02:03,456 Last message without a line break";
+    return content;
+}
+
+void write_input_file(string const& content) {
+    std::ofstream file{string{cTestMessageParserInputFile}, std::ios::binary};
+    file << content;
+}
+
+auto copy_message(ParsedMessage const& message) -> Message {
+    auto const* ts_pattern = message.get_ts_patt();
+    return {message.get_content(),
+            message.get_ts(),
+            message.get_orig_num_bytes(),
+            nullptr == ts_pattern ? string{} : ts_pattern->get_format()};
+}
+
+auto parse_with_reader(string const& content) -> vector<Message> {
+    MessageParser message_parser;
+    ParsedMessage message;
+    BufferReader reader{content.data(), content.size()};
+    vector<Message> messages;
+    while (message_parser.parse_next_message(true, reader, message)) {
+        messages.emplace_back(copy_message(message));
+    }
+    return messages;
+}
+
+auto parse_in_place(string const& content, size_t chunk_size) -> vector<Message> {
+    MessageParser message_parser;
+    ParsedMessage message;
+    vector<Message> messages;
+    for (size_t chunk_begin_pos = 0; chunk_begin_pos < content.size();
+         chunk_begin_pos += chunk_size)
+    {
+        auto const chunk_length = std::min(chunk_size, content.size() - chunk_begin_pos);
+        bool const is_last_chunk = chunk_begin_pos + chunk_length == content.size();
+        size_t buf_pos{0};
+        while (message_parser.parse_next_message(
+                is_last_chunk,
+                chunk_length,
+                content.data() + chunk_begin_pos,
+                buf_pos,
+                message
+        ))
+        {
+            messages.emplace_back(copy_message(message));
+        }
+        REQUIRE(chunk_length == buf_pos);
+    }
+    return messages;
+}
+
+auto parse_file_with_reader(size_t buffer_size) -> vector<Message> {
+    MessageParser message_parser;
+    ParsedMessage message;
+    BufferedFileReader reader{buffer_size};
+    reader.open(string{cTestMessageParserInputFile});
+    vector<Message> messages;
+    while (message_parser.parse_next_message(true, reader, message)) {
+        messages.emplace_back(copy_message(message));
+    }
+    return messages;
+}
+}  // namespace
+
+TEST_CASE("Parse messages in place", "[MessageParser]") {
+    TimestampPattern::init();
+
+    auto const content = generate_content(100);
+    auto const expected_messages = parse_with_reader(content);
+    REQUIRE(false == expected_messages.empty());
+    REQUIRE(expected_messages.back().content == " Last message without a line break");
+
+    // Chunk boundaries shouldn't affect how messages are parsed, whether they're in the middle of a
+    // line or a multiline message
+    vector<size_t> const chunk_sizes{1, 7, 64, 4096, content.size()};
+    for (auto const chunk_size : chunk_sizes) {
+        INFO(fmt::format("chunk_size: {}", chunk_size));
+        REQUIRE(expected_messages == parse_in_place(content, chunk_size));
+    }
+}
+
+TEST_CASE("Parse messages from a file", "[MessageParser]") {
+    TestOutputCleaner const test_cleanup{{string{cTestMessageParserInputFile}}};
+    TimestampPattern::init();
+
+    // Several times the smallest buffer, so lines and messages span refills of the buffer
+    auto const content = generate_content(1000);
+    write_input_file(content);
+    auto const expected_messages = parse_with_reader(content);
+
+    auto const buffer_size = GENERATE(BufferedFileReader::cMinBufferSize, cDefaultBufferSize);
+    INFO(fmt::format("buffer_size: {}", buffer_size));
+    REQUIRE(expected_messages == parse_file_with_reader(buffer_size));
+}
+
+TEST_CASE("Benchmark parsing messages in place", "[.][MessageParser][benchmark]") {
+    TimestampPattern::init();
+
+    auto const content = generate_content(200'000);
+
+    benchmark_against_baseline(
+            "Parsing in place",
+            [&]() { return parse_in_place(content, cDefaultBufferSize).size(); },
+            // Baseline: copy each line out of a reader before parsing it
+            "parsing from a reader",
+            [&]() { return parse_with_reader(content).size(); },
+            fmt::format("{} bytes", content.size())
+    );
+}
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <thread>
@@ -144,6 +145,36 @@ TEST_CASE("network_reader_with_offset_and_seek", "[NetworkReader]") {
     }
 }
 
+TEST_CASE("network_reader_with_byte_range", "[NetworkReader]") {
+    constexpr size_t cBeginOffset{319};
+    constexpr size_t cEndOffset{1023};
+    clp::FileReader ref_reader{get_test_input_local_path()};
+    ref_reader.seek_from_begin(cBeginOffset);
+    std::vector<char> expected(cEndOffset - cBeginOffset);
+    ref_reader.read_exact_length(expected.data(), expected.size(), false);
+
+    // Only the bytes in the range should be downloaded, including when it starts at the beginning
+    for (auto const begin_offset : {size_t{0}, cBeginOffset}) {
+        clp::CurlGlobalInstance const curl_global_instance;
+        clp::NetworkReader reader{
+                get_test_input_remote_url(),
+                begin_offset,
+                false,
+                clp::CurlDownloadHandler::cDefaultOverallTimeout,
+                clp::CurlDownloadHandler::cDefaultConnectionTimeout,
+                clp::NetworkReader::cDefaultBufferPoolSize,
+                clp::NetworkReader::cDefaultBufferSize,
+                std::nullopt,
+                cEndOffset
+        };
+        reader.seek_from_begin(cBeginOffset);
+        auto const actual{get_content(reader)};
+        REQUIRE(assert_curl_error_code(CURLE_OK, reader));
+        REQUIRE((reader.get_pos() == cEndOffset));
+        REQUIRE((actual == expected));
+    }
+}
+
 TEST_CASE("network_reader_destruct", "[NetworkReader]") {
     // We sleep to fill out all the buffers, and then we delete the reader. The destructor will try
     // to abort the underlying download and then destroy the instance. So should ensure destructor
@@ -1,10 +1,131 @@
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
 #include <catch2/catch.hpp>
+#include <fmt/format.h>
 
 #include "../src/clp/TimestampPattern.hpp"
+#include "../src/clp/TimestampPatternPrefilter.hpp"
+#include "benchmark_utils.hpp"
 
 using clp::epochtime_t;
 using clp::TimestampPattern;
+using clp::TimestampPatternPrefilter;
 using std::string;
+using std::vector;
+
+namespace {
+/**
+ * @return The known timestamp patterns, in the order they're searched by
+ * `TimestampPattern::search_known_ts_patterns`
+ */
+auto get_known_ts_patterns() -> vector<TimestampPattern>;
+
+/**
+ * @param patterns
+ * @return Lines containing a timestamp in each of the given patterns, as well as lines without a
+ * timestamp
+ */
+auto generate_lines(vector<TimestampPattern> const& patterns) -> vector<string>;
+
+/**
+ * Searches for a pattern which can parse the timestamp from the given line by parsing the line with
+ * each of the given patterns in turn
+ * @param patterns
+ * @param line
+ * @param timestamp
+ * @param timestamp_begin_pos
+ * @param timestamp_end_pos
+ * @return pointer to the timestamp pattern if found, nullptr otherwise
+ */
+auto search_ts_patterns_linearly(
+        vector<TimestampPattern> const& patterns,
+        string const& line,
+        epochtime_t& timestamp,
+        size_t& timestamp_begin_pos,
+        size_t& timestamp_end_pos
+) -> TimestampPattern const*;
+
+auto get_known_ts_patterns() -> vector<TimestampPattern> {
+    return {
+            {0, "%Y-%m-%dT%H:%M:%S.%3"},
+            {0, "%Y-%m-%dT%H:%M:%S,%3"},
+            {0, "%Y-%m-%d %H:%M:%S.%3"},
+            {0, "%Y-%m-%d %H:%M:%S,%3"},
+            {0, "%Y/%m/%dT%H:%M:%S.%3"},
+            {0, "%Y/%m/%dT%H:%M:%S,%3"},
+            {0, "%Y/%m/%d %H:%M:%S.%3"},
+            {0, "%Y/%m/%d %H:%M:%S,%3"},
+            {0, "[%Y-%m-%d %H:%M:%S,%3]"},
+            {2, "%Y-%m-%d %H:%M:%S,%3"},
+            {0, "<<<%Y-%m-%d %H:%M:%S:%3"},
+            {0, "%d %b %Y %H:%M:%S,%3"},
+            {0, "%Y-%m-%dT%H:%M:%S"},
+            {0, "%Y-%m-%d %H:%M:%S"},
+            {0, "%Y/%m/%dT%H:%M:%S"},
+            {0, "%Y/%m/%d %H:%M:%S"},
+            {0, "[%Y-%m-%dT%H:%M:%S"},
+            {0, "[%Y%m%d-%H:%M:%S]"},
+            {1, "%Y-%m-%d  %H:%M:%S"},
+            {0, "%y/%m/%d %H:%M:%S"},
+            {0, "%y%m%d %k:%M:%S"},
+            {0, "%b %d, %Y %l:%M:%S %p"},
+            {0, "%B %d, %Y %H:%M"},
+            {1, "[%d/%b/%Y:%H:%M:%S"},
+            {3, "[%d/%b/%Y:%H:%M:%S"},
+            {3, "[%d/%m/%Y:%H:%M:%S"},
+            {6, "%Y-%m-%d %H:%M:%S"},
+            {1, "%Y-%m-%d %H:%M:%S"},
+            {4, "%a %b %e %H:%M:%S %Y"},
+            {0, "%a %b %e %H:%M:%S %Y"},
+            {0, "%b %d %H:%M:%S"},
+            {0, "%m-%d %H:%M:%S.%3"},
+            {0, "%#3"}
+    };
+}
+
+auto generate_lines(vector<TimestampPattern> const& patterns) -> vector<string> {
+    vector<string> lines{
+            "",
+            " ",
+            "content without a timestamp",
+            "INFO 12 tasks completed in 3.5s",
+            "2015-02-01 is not a complete timestamp",
+            "[ERROR] 2015/02/01: request failed",
+            "Feb 31, 2015 1:02:03 XM content after",
+            "localhost - - [01/Fab/2016:15:50:17 content after"
+    };
+    // Timestamps with single-digit days, hours, and minutes (to exercise space-padded fields) as
+    // well as two-digit ones
+    vector<epochtime_t> const timestamps{1'422'752'523'004, 1'451'663'417'085, 1'700'000'000'120};
+    for (auto const& pattern : patterns) {
+        for (auto const timestamp : timestamps) {
+            string line{"host0 host1 host2 host3 host4 host5 content after"};
+            pattern.insert_formatted_timestamp(timestamp, line);
+            lines.emplace_back(std::move(line));
+        }
+    }
+    return lines;
+}
+
+auto search_ts_patterns_linearly(
+        vector<TimestampPattern> const& patterns,
+        string const& line,
+        epochtime_t& timestamp,
+        size_t& timestamp_begin_pos,
+        size_t& timestamp_end_pos
+) -> TimestampPattern const* {
+    for (auto const& pattern : patterns) {
+        if (pattern.parse_timestamp(line, timestamp, timestamp_begin_pos, timestamp_end_pos)) {
+            return &pattern;
+        }
+    }
+    return nullptr;
+}
+}  // namespace
 
 TEST_CASE("Test known timestamp patterns", "[KnownTimestampPatterns]") {
     TimestampPattern::init();
@@ -549,3 +670,136 @@ TEST_CASE("Test known timestamp patterns", "[KnownTimestampPatterns]") {
     specific_pattern.insert_formatted_timestamp(timestamp, content);
     REQUIRE(line == content);
 }
+
+TEST_CASE("Test timestamp pattern prefilter", "[TimestampPatternPrefilter]") {
+    TimestampPattern::init();
+
+    auto const patterns = get_known_ts_patterns();
+    auto const lines = generate_lines(patterns);
+
+    epochtime_t timestamp;
+    size_t timestamp_begin_pos;
+    size_t timestamp_end_pos;
+
+    // The prefilter mustn't rule out a pattern which can parse a timestamp from the line
+    for (auto const& pattern : patterns) {
+        TimestampPatternPrefilter const prefilter{pattern.get_format()};
+        for (auto const& line : lines) {
+            if (false
+                == pattern.parse_timestamp(line, timestamp, timestamp_begin_pos, timestamp_end_pos))
+            {
+                continue;
+            }
+            auto const fingerprint = TimestampPatternPrefilter::compute_fingerprint(
+                    std::string_view{line}.substr(timestamp_begin_pos)
+            );
+            INFO(fmt::format("format: {}, line: {}", pattern.get_format(), line));
+            REQUIRE(prefilter.may_match(fingerprint));
+        }
+    }
+
+    // The prefilter should rule out patterns whose layout doesn't match the line
+    TimestampPatternPrefilter const prefilter{"%Y-%m-%d %H:%M:%S"};
+    REQUIRE(prefilter.may_match(
+            TimestampPatternPrefilter::compute_fingerprint("2015-02-01 01:02:03 content")
+    ));
+    REQUIRE(false
+            == prefilter.may_match(
+                    TimestampPatternPrefilter::compute_fingerprint("2015/02/01 01:02:03 content")
+            ));
+    REQUIRE(false
+            == prefilter.may_match(TimestampPatternPrefilter::compute_fingerprint("2015-02-01")));
+    REQUIRE(false
+            == prefilter.may_match(TimestampPatternPrefilter::compute_fingerprint("content")));
+
+    // Searching the known patterns should find the same pattern as parsing the line with every
+    // pattern in turn
+    for (auto const& line : lines) {
+        epochtime_t expected_timestamp{0};
+        size_t expected_timestamp_begin_pos{0};
+        size_t expected_timestamp_end_pos{0};
+        auto const* expected_pattern = search_ts_patterns_linearly(
+                patterns,
+                line,
+                expected_timestamp,
+                expected_timestamp_begin_pos,
+                expected_timestamp_end_pos
+        );
+        auto const* pattern = TimestampPattern::search_known_ts_patterns(
+                line,
+                timestamp,
+                timestamp_begin_pos,
+                timestamp_end_pos
+        );
+        INFO(fmt::format("line: {}", line));
+        if (nullptr == expected_pattern) {
+            REQUIRE(nullptr == pattern);
+            continue;
+        }
+        REQUIRE(nullptr != pattern);
+        REQUIRE(*expected_pattern == *pattern);
+        REQUIRE(expected_timestamp == timestamp);
+        REQUIRE(expected_timestamp_begin_pos == timestamp_begin_pos);
+        REQUIRE(expected_timestamp_end_pos == timestamp_end_pos);
+    }
+}
+
+TEST_CASE(
+        "Benchmark searching known timestamp patterns",
+        "[.][TimestampPatternPrefilter][benchmark]"
+) {
+    constexpr size_t cNumRounds{200};
+
+    TimestampPattern::init();
+
+    auto const patterns = get_known_ts_patterns();
+    auto const lines = generate_lines(patterns);
+
+    epochtime_t timestamp;
+    size_t timestamp_begin_pos;
+    size_t timestamp_end_pos;
+
+    benchmark_against_baseline(
+            "Prefiltered search",
+            [&]() {
+                size_t num_matches{0};
+                for (size_t i = 0; i < cNumRounds; ++i) {
+                    for (auto const& line : lines) {
+                        if (nullptr
+                            != TimestampPattern::search_known_ts_patterns(
+                                    line,
+                                    timestamp,
+                                    timestamp_begin_pos,
+                                    timestamp_end_pos
+                            ))
+                        {
+                            ++num_matches;
+                        }
+                    }
+                }
+                return num_matches;
+            },
+            // Baseline: parse each line with every pattern in turn, as the search used to
+            "linear search",
+            [&]() {
+                size_t num_matches{0};
+                for (size_t i = 0; i < cNumRounds; ++i) {
+                    for (auto const& line : lines) {
+                        if (nullptr
+                            != search_ts_patterns_linearly(
+                                    patterns,
+                                    line,
+                                    timestamp,
+                                    timestamp_begin_pos,
+                                    timestamp_end_pos
+                            ))
+                        {
+                            ++num_matches;
+                        }
+                    }
+                }
+                return num_matches;
+            },
+            fmt::format("{} lines", cNumRounds * lines.size())
+    );
+}
@@ -0,0 +1,200 @@
+#include <sys/wait.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include "../src/clp/clp/run.hpp"
+#include "TestOutputCleaner.hpp"
+
+constexpr std::string_view cTestEndToEndExpectedDirectory{"test-clp-end-to-end-expected"};
+constexpr std::string_view cTestEndToEndInputDirectory{"test-clp-end-to-end-input"};
+constexpr std::string_view cTestEndToEndArchiveDirectoryPrefix{"test-clp-end-to-end-archive-"};
+constexpr std::string_view cTestEndToEndOutputDirectoryPrefix{"test-clp-end-to-end-out-"};
+constexpr std::string_view cTestEndToEndTarredFile{"tarred.log"};
+// Small enough that the large input file is split several times
+constexpr size_t cTestEndToEndTargetEncodedFileSize{8 * 1024};
+
+using std::string;
+using std::vector;
+
+namespace {
+/**
+ * Writes the expected output of decompression, then copies it into the input directory, except for
+ * one file which is added as a gzipped tar archive instead.
+ */
+void write_input_files();
+
+/**
+ * @param num_threads
+ * @return The directory containing the archives
+ */
+auto compress(size_t num_threads) -> string;
+
+/**
+ * @param archives_dir
+ * @param num_threads The number of threads the archives were compressed with
+ * @return The directory containing the decompressed files
+ */
+auto decompress(string const& archives_dir, size_t num_threads) -> string;
+
+/**
+ * Compares two directories recursively
+ * @param expected_dir
+ * @param actual_dir
+ */
+void compare(string const& expected_dir, string const& actual_dir);
+
+void write_input_files() {
+    std::filesystem::path const expected_dir{cTestEndToEndExpectedDirectory};
+    std::filesystem::create_directory(expected_dir);
+
+    // Several small files so that every worker has a file to encode
+    constexpr size_t cNumSmallFiles{8};
+    for (size_t i = 0; i < cNumSmallFiles; ++i) {
+        std::ofstream file{expected_dir / fmt::format("small-{}.log", i)};
+        for (size_t j = 0; j < 100; ++j) {
+            file << fmt::format(
+                    "2024-01-{:02} 00:00:{:02},000 INFO Task {} finished in {} ms\n",
+                    i + 1,
+                    j % 60,
+                    j,
+                    j * 1.5
+            );
+        }
+    }
+
+    // A file with multi-line messages and messages without timestamps
+    {
+        std::ofstream file{expected_dir / "multiline.log"};
+        for (size_t i = 0; i < 100; ++i) {
+            file << fmt::format("2024-02-01 12:00:{:02},000 ERROR Request {} failed\n", i % 60, i);
+            file << fmt::format("\tat com.example.Handler.handle(Handler.java:{})\n", i);
+            file << "no timestamp here\n";
+        }
+    }
+
+    // A file large enough to be split into several encoded files
+    {
+        std::ofstream file{expected_dir / "large.log"};
+        for (size_t i = 0; i < 20'000; ++i) {
+            file << fmt::format(
+                    "2024-03-01 08:{:02}:{:02},{:03} WARN Node node-{} reported {} free blocks, "
+                    "id=0x{:x}\n",
+                    (i / 60) % 60,
+                    i % 60,
+                    i % 1000,
+                    i % 32,
+                    i * 7,
+                    i * 31
+            );
+        }
+    }
+
+    // A file that's only reachable through a non-text input
+    {
+        std::ofstream file{expected_dir / cTestEndToEndTarredFile};
+        for (size_t i = 0; i < 500; ++i) {
+            file << fmt::format("2024-04-01 00:00:00,{:03} DEBUG Tarred message {}\n", i, i);
+        }
+    }
+
+    std::filesystem::path const input_dir{cTestEndToEndInputDirectory};
+    std::filesystem::create_directory(input_dir);
+    for (auto const& entry : std::filesystem::directory_iterator(expected_dir)) {
+        if (cTestEndToEndTarredFile == entry.path().filename().string()) {
+            continue;
+        }
+        std::filesystem::copy_file(entry.path(), input_dir / entry.path().filename());
+    }
+
+    // Silence the checks below since our use of `std::system` is safe in the context of testing.
+    // NOLINTBEGIN(cert-env33-c,concurrency-mt-unsafe)
+    int result{std::system("command -v tar >/dev/null 2>&1")};
+    REQUIRE((0 == result));
+    auto const command = fmt::format(
+            "tar --create --gzip --file {}/{}.tar.gz --directory {} {}",
+            cTestEndToEndInputDirectory,
+            cTestEndToEndTarredFile,
+            cTestEndToEndExpectedDirectory,
+            cTestEndToEndTarredFile
+    );
+    result = std::system(command.c_str());
+    // NOLINTEND(cert-env33-c,concurrency-mt-unsafe)
+    REQUIRE((true == WIFEXITED(result)));
+    REQUIRE((0 == WEXITSTATUS(result)));
+}
+
+auto compress(size_t num_threads) -> string {
+    auto const archives_dir = fmt::format("{}{}", cTestEndToEndArchiveDirectoryPrefix, num_threads);
+    auto const num_threads_str = std::to_string(num_threads);
+    auto const target_encoded_file_size_str = std::to_string(cTestEndToEndTargetEncodedFileSize);
+    string const input_dir{cTestEndToEndInputDirectory};
+    vector<char const*> argv{
+            "clp",
+            "c",
+            "--num-threads",
+            num_threads_str.c_str(),
+            "--target-encoded-file-size",
+            target_encoded_file_size_str.c_str(),
+            "--remove-path-prefix",
+            input_dir.c_str(),
+            archives_dir.c_str(),
+            input_dir.c_str(),
+            nullptr
+    };
+    REQUIRE(0 == clp::clp::run(static_cast<int>(argv.size() - 1), argv.data()));
+    return archives_dir;
+}
+
+auto decompress(string const& archives_dir, size_t num_threads) -> string {
+    auto const output_dir = fmt::format("{}{}", cTestEndToEndOutputDirectoryPrefix, num_threads);
+    vector<char const*> argv{"clp", "x", archives_dir.c_str(), output_dir.c_str(), nullptr};
+    REQUIRE(0 == clp::clp::run(static_cast<int>(argv.size() - 1), argv.data()));
+    REQUIRE(std::filesystem::is_directory(output_dir));
+    return output_dir;
+}
+
+// Silence the checks below since our use of `std::system` is safe in the context of testing.
+// NOLINTBEGIN(cert-env33-c,concurrency-mt-unsafe)
+void compare(string const& expected_dir, string const& actual_dir) {
+    int result{std::system("command -v diff >/dev/null 2>&1")};
+    REQUIRE((0 == result));
+    auto const command
+            = fmt::format("diff --recursive {} {} > /dev/null", expected_dir, actual_dir);
+    result = std::system(command.c_str());
+    REQUIRE((true == WIFEXITED(result)));
+    REQUIRE((0 == WEXITSTATUS(result)));
+}
+// NOLINTEND(cert-env33-c,concurrency-mt-unsafe)
+}  // namespace
+
+TEST_CASE("clp-end-to-end-num-threads", "[clp][end_to_end]") {
+    constexpr size_t cParallelNumThreads{4};
+    TestOutputCleaner const test_cleanup{
+            {string{cTestEndToEndExpectedDirectory},
+             string{cTestEndToEndInputDirectory},
+             fmt::format("{}{}", cTestEndToEndArchiveDirectoryPrefix, 1),
+             fmt::format("{}{}", cTestEndToEndArchiveDirectoryPrefix, cParallelNumThreads),
+             fmt::format("{}{}", cTestEndToEndOutputDirectoryPrefix, 1),
+             fmt::format("{}{}", cTestEndToEndOutputDirectoryPrefix, cParallelNumThreads)}
+    };
+
+    write_input_files();
+
+    auto const sequential_output_dir = decompress(compress(1), 1);
+    auto const parallel_output_dir
+            = decompress(compress(cParallelNumThreads), cParallelNumThreads);
+
+    string const expected_dir{cTestEndToEndExpectedDirectory};
+    compare(expected_dir, sequential_output_dir);
+    compare(expected_dir, parallel_output_dir);
+    compare(sequential_output_dir, parallel_output_dir);
+}
@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "../src/clp/ErrorCode.hpp"
+#include "../src/clp/ReaderInterface.hpp"
+#include "../src/clp_s/ByteRangeReader.hpp"
+
+namespace {
+constexpr size_t cObjectSize{64 * 1024};
+constexpr size_t cMaxCoalescedGap{1024};
+
+/**
+ * Stands in for an HTTP server that serves byte ranges of an object, recording every range
+ * requested.
+ */
+class RangeServer {
+public:
+    /**
+     * A reader for a range of the served object, behaving like a `clp::NetworkReader` whose
+     * download started at the beginning of the range.
+     */
+    class RangeReader : public clp::ReaderInterface {
+    public:
+        RangeReader(std::string_view object, clp_s::ByteRange range)
+                : m_object{object},
+                  m_pos{range.begin_offset},
+                  m_end_offset{range.end_offset} {}
+
+        auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+                -> clp::ErrorCode override {
+            num_bytes_read = std::min(num_bytes_to_read, m_end_offset - m_pos);
+            if (0 == num_bytes_read) {
+                return clp::ErrorCode_EndOfFile;
+            }
+            std::copy_n(m_object.begin() + m_pos, num_bytes_read, buf);
+            m_pos += num_bytes_read;
+            return clp::ErrorCode_Success;
+        }
+
+        auto try_seek_from_begin(size_t pos) -> clp::ErrorCode override {
+            if (pos < m_pos) {
+                return clp::ErrorCode_Unsupported;
+            }
+            if (pos > m_end_offset) {
+                return clp::ErrorCode_OutOfBounds;
+            }
+            m_pos = pos;
+            return clp::ErrorCode_Success;
+        }
+
+        auto try_get_pos(size_t& pos) -> clp::ErrorCode override {
+            pos = m_pos;
+            return clp::ErrorCode_Success;
+        }
+
+    private:
+        std::string_view m_object;
+        size_t m_pos;
+        size_t m_end_offset;
+    };
+
+    RangeServer() {
+        m_object.reserve(cObjectSize);
+        for (size_t i{0}; i < cObjectSize; ++i) {
+            m_object.push_back(static_cast<char>('a' + i % 26));
+        }
+    }
+
+    [[nodiscard]] auto get_object() const -> std::string_view { return m_object; }
+
+    [[nodiscard]] auto get_requested_ranges() const -> std::vector<clp_s::ByteRange> const& {
+        return m_requested_ranges;
+    }
+
+    /**
+     * @return A factory creating readers that download ranges of the object from this server.
+     */
+    [[nodiscard]] auto get_range_reader_factory() -> clp_s::ByteRangeReader::RangeReaderFactory {
+        return [this](clp_s::ByteRange range) -> std::shared_ptr<clp::ReaderInterface> {
+            m_requested_ranges.push_back(range);
+            return std::make_shared<RangeReader>(m_object, range);
+        };
+    }
+
+private:
+    std::string m_object;
+    std::vector<clp_s::ByteRange> m_requested_ranges;
+};
+
+/**
+ * Reads a range of the object through the given reader.
+ * @param reader
+ * @param range
+ * @return The bytes read.
+ */
+auto read_range(clp_s::ByteRangeReader& reader, clp_s::ByteRange range) -> std::string;
+
+/**
+ * @param lhs
+ * @param rhs
+ * @return Whether the given lists of ranges are equal.
+ */
+auto ranges_equal(
+        std::vector<clp_s::ByteRange> const& lhs,
+        std::vector<clp_s::ByteRange> const& rhs
+) -> bool;
+
+auto read_range(clp_s::ByteRangeReader& reader, clp_s::ByteRange range) -> std::string {
+    REQUIRE((clp::ErrorCode_Success == reader.try_seek_from_begin(range.begin_offset)));
+    std::string buf(range.end_offset - range.begin_offset, '\0');
+    REQUIRE((clp::ErrorCode_Success == reader.try_read_exact_length(buf.data(), buf.size())));
+    return buf;
+}
+
+auto ranges_equal(
+        std::vector<clp_s::ByteRange> const& lhs,
+        std::vector<clp_s::ByteRange> const& rhs
+) -> bool {
+    return std::equal(
+            lhs.begin(),
+            lhs.end(),
+            rhs.begin(),
+            rhs.end(),
+            [](clp_s::ByteRange const& a, clp_s::ByteRange const& b) {
+                return a.begin_offset == b.begin_offset && a.end_offset == b.end_offset;
+            }
+    );
+}
+}  // namespace
+
+TEST_CASE("byte_range_reader_planned_reads", "[clp-s][ByteRangeReader]") {
+    RangeServer server;
+    clp_s::ByteRangeReader reader{
+            server.get_range_reader_factory(),
+            cObjectSize,
+            cMaxCoalescedGap
+    };
+
+    // The first two ranges are close enough to be coalesced, but the third isn't
+    std::vector<clp_s::ByteRange> const ranges{{100, 200}, {700, 900}, {20'000, 30'000}};
+    reader.plan_reads(ranges);
+    REQUIRE(ranges_equal(reader.get_planned_ranges(), {{100, 900}, {20'000, 30'000}}));
+    REQUIRE((0 == reader.get_num_ranges_fetched()));
+
+    for (auto const& range : ranges) {
+        auto const expected = server.get_object().substr(
+                range.begin_offset,
+                range.end_offset - range.begin_offset
+        );
+        REQUIRE((read_range(reader, range) == expected));
+    }
+    REQUIRE(ranges_equal(server.get_requested_ranges(), {{100, 900}, {20'000, 30'000}}));
+    REQUIRE((2 == reader.get_num_ranges_fetched()));
+    REQUIRE((800 + 10'000 == reader.get_num_bytes_fetched()));
+}
+
+TEST_CASE("byte_range_reader_unplanned_reads", "[clp-s][ByteRangeReader]") {
+    RangeServer server;
+    clp_s::ByteRangeReader reader{
+            server.get_range_reader_factory(),
+            cObjectSize,
+            cMaxCoalescedGap
+    };
+
+    // Unplanned reads fetch the rest of the object, so reading a little further doesn't issue
+    // another request, but skipping more than the coalesced gap does
+    REQUIRE((read_range(reader, {10, 20}) == server.get_object().substr(10, 10)));
+    REQUIRE((read_range(reader, {20 + cMaxCoalescedGap, 40 + cMaxCoalescedGap})
+             == server.get_object().substr(20 + cMaxCoalescedGap, 20)));
+    REQUIRE((read_range(reader, {50'000, 50'010}) == server.get_object().substr(50'000, 10)));
+    REQUIRE(ranges_equal(server.get_requested_ranges(), {{10, cObjectSize}, {50'000, cObjectSize}})
+    );
+
+    // Seeking backwards fetches the range again
+    REQUIRE((read_range(reader, {0, 10}) == server.get_object().substr(0, 10)));
+    REQUIRE((3 == reader.get_num_ranges_fetched()));
+
+    // Reading stops at the end of the object
+    REQUIRE((clp::ErrorCode_Success == reader.try_seek_from_begin(cObjectSize)));
+    char c{};
+    size_t num_bytes_read{};
+    REQUIRE((clp::ErrorCode_EndOfFile == reader.try_read(&c, 1, num_bytes_read)));
+    REQUIRE((clp::ErrorCode_OutOfBounds == reader.try_seek_from_begin(cObjectSize + 1)));
+    REQUIRE((3 == reader.get_num_ranges_fetched()));
+}
+
+TEST_CASE("byte_range_reader_reads_across_ranges", "[clp-s][ByteRangeReader]") {
+    RangeServer server;
+    clp_s::ByteRangeReader reader{
+            server.get_range_reader_factory(),
+            cObjectSize,
+            cMaxCoalescedGap
+    };
+
+    // A read spanning the end of a planned range continues with the rest of the object
+    reader.plan_reads({{0, 100}});
+    REQUIRE((read_range(reader, {50, 150}) == server.get_object().substr(50, 100)));
+    REQUIRE(ranges_equal(server.get_requested_ranges(), {{50, 100}, {100, cObjectSize}}));
+}
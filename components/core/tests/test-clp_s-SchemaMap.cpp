@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include "../src/clp/Stopwatch.hpp"
+#include "../src/clp_s/Schema.hpp"
+#include "../src/clp_s/SchemaMap.hpp"
+#include "../src/clp_s/SchemaTree.hpp"
+
+using clp_s::Schema;
+using clp_s::SchemaMap;
+
+namespace {
+/**
+ * Generates schemas resembling those of heterogeneous JSON logs: each schema has a few common
+ * ordered nodes, some nodes specific to it, and sometimes an unordered object.
+ * @param num_schemas
+ * @param generator
+ * @return The generated schemas
+ */
+auto generate_schemas(size_t num_schemas, std::mt19937& generator) -> std::vector<Schema>;
+
+auto generate_schemas(size_t num_schemas, std::mt19937& generator) -> std::vector<Schema> {
+    constexpr int32_t cNumCommonNodes{8};
+    constexpr int32_t cMaxNumSpecificNodes{24};
+    std::uniform_int_distribution<int32_t> num_specific_nodes_distribution{1, cMaxNumSpecificNodes};
+    std::uniform_int_distribution<int32_t> node_id_distribution{cNumCommonNodes, 1'000'000};
+
+    std::vector<Schema> schemas(num_schemas);
+    for (size_t i = 0; i < num_schemas; ++i) {
+        auto& schema = schemas[i];
+        for (int32_t node_id = 0; node_id < cNumCommonNodes; ++node_id) {
+            schema.insert_ordered(node_id);
+        }
+        // Use the index as a node so that every schema is distinct
+        schema.insert_ordered(cNumCommonNodes + 1'000'000 + static_cast<int32_t>(i));
+        auto const num_specific_nodes = num_specific_nodes_distribution(generator);
+        for (int32_t j = 0; j < num_specific_nodes; ++j) {
+            auto const node_id = node_id_distribution(generator);
+            if (std::find(schema.cbegin(), schema.cend(), node_id) == schema.cend()) {
+                schema.insert_ordered(node_id);
+            }
+        }
+        if (0 == i % 4) {
+            auto const start = schema.start_unordered_object(clp_s::NodeType::StructuredArray);
+            schema.insert_unordered(node_id_distribution(generator));
+            schema.insert_unordered(node_id_distribution(generator));
+            schema.end_unordered_object(start);
+        }
+    }
+    return schemas;
+}
+}  // namespace
+
+TEST_CASE("clp_s_SchemaMap_add_schema", "[clp_s][SchemaMap]") {
+    SchemaMap schema_map;
+
+    // The ordered region doesn't depend on insertion order
+    Schema schema1;
+    schema1.insert_ordered(3);
+    schema1.insert_ordered(1);
+    schema1.insert_ordered(2);
+    Schema schema2;
+    schema2.insert_ordered(1);
+    schema2.insert_ordered(2);
+    schema2.insert_ordered(3);
+    REQUIRE(schema1.get_hash() == schema2.get_hash());
+    REQUIRE(0 == schema_map.add_schema(schema1));
+    REQUIRE(0 == schema_map.add_schema(schema2));
+
+    // The unordered region does
+    Schema schema3 = schema1;
+    schema3.insert_unordered(4);
+    schema3.insert_unordered(5);
+    Schema schema4 = schema1;
+    schema4.insert_unordered(5);
+    schema4.insert_unordered(4);
+    REQUIRE(1 == schema_map.add_schema(schema3));
+    REQUIRE(2 == schema_map.add_schema(schema4));
+    REQUIRE(1 == schema_map.add_schema(schema3));
+
+    // Unordered objects are hashed with their final length
+    Schema schema5 = schema1;
+    auto const start = schema5.start_unordered_object(clp_s::NodeType::StructuredArray);
+    schema5.insert_unordered(4);
+    schema5.end_unordered_object(start);
+    Schema schema6 = schema5;
+    schema6.resize(schema6.size());
+    REQUIRE(schema5.get_hash() == schema6.get_hash());
+    REQUIRE(3 == schema_map.add_schema(schema5));
+    REQUIRE(3 == schema_map.add_schema(schema6));
+
+    // Schemas with the same nodes but a different number of ordered nodes are distinct
+    Schema schema7;
+    schema7.insert_ordered(1);
+    schema7.insert_ordered(2);
+    schema7.insert_unordered(3);
+    REQUIRE(4 == schema_map.add_schema(schema7));
+
+    // A cleared schema can be reused
+    schema7.clear();
+    schema7.insert_ordered(2);
+    schema7.insert_ordered(3);
+    schema7.insert_ordered(1);
+    REQUIRE(0 == schema_map.add_schema(schema7));
+}
+
+TEST_CASE("clp_s_SchemaMap_benchmark", "[.][clp_s][SchemaMap][benchmark]") {
+    constexpr size_t cNumRecords{1'000'000};
+    constexpr size_t cMeanRunLength{8};
+
+    std::mt19937 generator{42};
+    for (size_t const num_schemas : {16UL, 1024UL, 16'384UL}) {
+        auto const schemas = generate_schemas(num_schemas, generator);
+
+        // Records from the same source tend to arrive in runs sharing a schema
+        std::vector<size_t> record_schemas;
+        record_schemas.reserve(cNumRecords);
+        std::uniform_int_distribution<size_t> schema_distribution{0, num_schemas - 1};
+        std::geometric_distribution<size_t> run_length_distribution{1.0 / cMeanRunLength};
+        while (record_schemas.size() < cNumRecords) {
+            auto const schema_ix = schema_distribution(generator);
+            auto const run_length = 1 + run_length_distribution(generator);
+            for (size_t i = 0; i < run_length && record_schemas.size() < cNumRecords; ++i) {
+                record_schemas.push_back(schema_ix);
+            }
+        }
+
+        SchemaMap schema_map;
+        clp::Stopwatch schema_map_stopwatch;
+        schema_map_stopwatch.start();
+        for (auto const schema_ix : record_schemas) {
+            schema_map.add_schema(schemas[schema_ix]);
+        }
+        schema_map_stopwatch.stop();
+
+        // Baseline: an ordered map keyed by the schema, as the schema map used to be
+        std::map<Schema, int32_t> ordered_schema_map;
+        int32_t next_schema_id{0};
+        clp::Stopwatch ordered_map_stopwatch;
+        ordered_map_stopwatch.start();
+        for (auto const schema_ix : record_schemas) {
+            auto const [it, inserted]
+                    = ordered_schema_map.try_emplace(schemas[schema_ix], next_schema_id);
+            if (inserted) {
+                ++next_schema_id;
+            }
+        }
+        ordered_map_stopwatch.stop();
+
+        REQUIRE(std::distance(schema_map.schema_map_begin(), schema_map.schema_map_end())
+                == static_cast<std::ptrdiff_t>(ordered_schema_map.size()));
+        WARN(fmt::format(
+                "{} schemas: SchemaMap took {:.3f}s, std::map took {:.3f}s for {} records",
+                num_schemas,
+                schema_map_stopwatch.get_time_taken_in_seconds(),
+                ordered_map_stopwatch.get_time_taken_in_seconds(),
+                cNumRecords
+        ));
+    }
+}
@@ -0,0 +1,177 @@
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <variant>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "../src/clp_s/BloomFilter.hpp"
+#include "../src/clp_s/ErrorCode.hpp"
+#include "../src/clp_s/TableStatistics.hpp"
+#include "../src/clp_s/ZstdCompressor.hpp"
+#include "../src/clp_s/ZstdDecompressor.hpp"
+
+using clp_s::BloomFilter;
+using clp_s::ErrorCodeSuccess;
+using clp_s::TableStatistics;
+
+namespace {
+/**
+ * @param values
+ * @param num_repetitions
+ * @return A vector containing the given values repeated the given number of times
+ */
+auto repeat(std::vector<uint64_t> const& values, size_t num_repetitions) -> std::vector<uint64_t>;
+
+auto repeat(std::vector<uint64_t> const& values, size_t num_repetitions) -> std::vector<uint64_t> {
+    std::vector<uint64_t> repeated_values;
+    repeated_values.reserve(values.size() * num_repetitions);
+    for (size_t i = 0; i < num_repetitions; ++i) {
+        repeated_values.insert(repeated_values.end(), values.begin(), values.end());
+    }
+    return repeated_values;
+}
+}  // namespace
+
+TEST_CASE("clp_s_BloomFilter_membership", "[clp_s][TableStatistics]") {
+    constexpr uint64_t cNumValues{10'000};
+    BloomFilter filter{cNumValues};
+    for (uint64_t i = 0; i < cNumValues; ++i) {
+        filter.add(i * 2);
+    }
+
+    // Added values must always be found
+    for (uint64_t i = 0; i < cNumValues; ++i) {
+        REQUIRE(filter.possibly_contains(i * 2));
+    }
+
+    // Most values that weren't added shouldn't be found
+    uint64_t num_false_positives{0};
+    for (uint64_t i = 0; i < cNumValues; ++i) {
+        if (filter.possibly_contains(i * 2 + 1)) {
+            ++num_false_positives;
+        }
+    }
+    REQUIRE(num_false_positives < cNumValues / 20);
+
+    BloomFilter const empty_filter;
+    REQUIRE_FALSE(empty_filter.possibly_contains(0));
+
+    BloomFilter undersized_filter{0};
+    undersized_filter.add(42);
+    REQUIRE(undersized_filter.possibly_contains(42));
+}
+
+TEST_CASE("clp_s_TableStatistics_columns", "[clp_s][TableStatistics]") {
+    TableStatistics statistics;
+    statistics.add_integer_column(0, std::vector<int64_t>{5, -3, 12});
+    statistics.add_float_column(1, std::vector<double>{1.5, -2.25});
+    statistics.add_float_column(2, std::vector<double>{std::numeric_limits<double>::quiet_NaN()});
+    // Bloom filters are only recorded for columns with enough repeated values
+    statistics.add_clp_string_column(3, repeat({7, 7, 9}, 32), repeat({100, 200}, 32));
+    statistics.add_var_string_column(4, {1, 2, 3});
+    statistics.add_integer_column(5, std::vector<int64_t>{});
+
+    // Occurrences of the same column are merged when they're ranges
+    statistics.add_integer_column(0, std::vector<int64_t>{20});
+    statistics.add_var_string_column(4, {4});
+
+    auto const* integer_statistics = statistics.get_column_statistics(0);
+    REQUIRE(nullptr != integer_statistics);
+    auto const& integer_range = std::get<TableStatistics::IntegerRange>(*integer_statistics);
+    REQUIRE(-3 == integer_range.min);
+    REQUIRE(20 == integer_range.max);
+
+    auto const* float_statistics = statistics.get_column_statistics(1);
+    REQUIRE(nullptr != float_statistics);
+    auto const& float_range = std::get<TableStatistics::FloatRange>(*float_statistics);
+    REQUIRE(-2.25 == float_range.min);
+    REQUIRE(1.5 == float_range.max);
+
+    REQUIRE(nullptr == statistics.get_column_statistics(2));
+
+    auto const* clp_string_statistics = statistics.get_column_statistics(3);
+    REQUIRE(nullptr != clp_string_statistics);
+    auto const& clp_string_ids = std::get<TableStatistics::ClpStringIds>(*clp_string_statistics);
+    REQUIRE(clp_string_ids.logtype_ids.possibly_contains(7));
+    REQUIRE(clp_string_ids.logtype_ids.possibly_contains(9));
+    REQUIRE(clp_string_ids.encoded_vars.possibly_contains(100));
+    REQUIRE(clp_string_ids.encoded_vars.possibly_contains(200));
+
+    REQUIRE(nullptr == statistics.get_column_statistics(4));
+    REQUIRE(nullptr == statistics.get_column_statistics(5));
+    REQUIRE(nullptr == statistics.get_column_statistics(6));
+}
+
+TEST_CASE("clp_s_TableStatistics_serialization", "[clp_s][TableStatistics]") {
+    TableStatistics statistics;
+    statistics.add_integer_column(0, std::vector<int64_t>{-7, 7});
+    statistics.add_float_column(1, std::vector<double>{0.5});
+    statistics.add_clp_string_column(2, repeat({3}, 32), {});
+    statistics.add_var_string_column(3, repeat({11, 12}, 16));
+    statistics.add_float_column(4, std::vector<double>{std::numeric_limits<double>::quiet_NaN()});
+
+    std::vector<char> compressed_buf;
+    clp_s::ZstdCompressor compressor;
+    compressor.open(compressed_buf);
+    statistics.write(compressor);
+    compressor.close();
+
+    clp_s::ZstdDecompressor decompressor;
+    decompressor.open(compressed_buf.data(), compressed_buf.size());
+    TableStatistics read_statistics;
+    REQUIRE(ErrorCodeSuccess == read_statistics.try_read(decompressor));
+    decompressor.close();
+
+    auto const* integer_statistics = read_statistics.get_column_statistics(0);
+    REQUIRE(nullptr != integer_statistics);
+    auto const& integer_range = std::get<TableStatistics::IntegerRange>(*integer_statistics);
+    REQUIRE(-7 == integer_range.min);
+    REQUIRE(7 == integer_range.max);
+
+    auto const* float_statistics = read_statistics.get_column_statistics(1);
+    REQUIRE(nullptr != float_statistics);
+    REQUIRE(0.5 == std::get<TableStatistics::FloatRange>(*float_statistics).max);
+
+    auto const* clp_string_statistics = read_statistics.get_column_statistics(2);
+    REQUIRE(nullptr != clp_string_statistics);
+    auto const& clp_string_ids = std::get<TableStatistics::ClpStringIds>(*clp_string_statistics);
+    REQUIRE(clp_string_ids.logtype_ids.possibly_contains(3));
+    REQUIRE_FALSE(clp_string_ids.encoded_vars.possibly_contains(3));
+
+    auto const* var_string_statistics = read_statistics.get_column_statistics(3);
+    REQUIRE(nullptr != var_string_statistics);
+    auto const& var_string_ids = std::get<TableStatistics::VarStringIds>(*var_string_statistics);
+    REQUIRE(var_string_ids.var_ids.possibly_contains(11));
+    REQUIRE(var_string_ids.var_ids.possibly_contains(12));
+
+    REQUIRE(nullptr == read_statistics.get_column_statistics(4));
+}
+
+TEST_CASE("clp_s_TableStatistics_size_cap", "[clp_s][TableStatistics]") {
+    constexpr size_t cNumValues{10'000};
+    std::vector<uint64_t> distinct_values(cNumValues);
+    for (size_t i = 0; i < cNumValues; ++i) {
+        distinct_values[i] = i;
+    }
+    std::vector<uint64_t> repeated_values(cNumValues);
+    for (size_t i = 0; i < cNumValues; ++i) {
+        repeated_values[i] = i % 100;
+    }
+
+    TableStatistics statistics;
+    // Columns where most values are distinct would need filters that take a sizeable fraction of
+    // the column's size
+    statistics.add_clp_string_column(0, repeated_values, distinct_values);
+    statistics.add_var_string_column(1, distinct_values);
+    statistics.add_clp_string_column(2, repeated_values, repeated_values);
+    statistics.add_var_string_column(3, repeated_values);
+
+    REQUIRE(nullptr == statistics.get_column_statistics(0));
+    REQUIRE(nullptr == statistics.get_column_statistics(1));
+    REQUIRE(nullptr != statistics.get_column_statistics(2));
+    REQUIRE(nullptr != statistics.get_column_statistics(3));
+    REQUIRE(statistics.get_size_in_bytes() * TableStatistics::cMaxBloomFilterSizeRatio
+            <= 3 * cNumValues * sizeof(uint64_t));
+}
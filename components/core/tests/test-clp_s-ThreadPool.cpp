@@ -0,0 +1,66 @@
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <stdexcept>
+
+#include <catch2/catch.hpp>
+
+#include "../src/clp_s/ThreadPool.hpp"
+
+TEST_CASE("clp-s-TaskGroup-wait", "[clp-s][ThreadPool]") {
+    constexpr size_t cNumThreads{4};
+    constexpr size_t cNumTasks{100};
+
+    clp_s::ThreadPool thread_pool{cNumThreads};
+
+    // A task from another group that keeps running until it's released
+    std::promise<void> release_blocked_task;
+    auto blocked_task_released = release_blocked_task.get_future().share();
+    std::atomic<bool> has_blocked_task_finished{false};
+    clp_s::TaskGroup blocked_group{thread_pool};
+    blocked_group.submit([&](size_t) {
+        blocked_task_released.wait();
+        has_blocked_task_finished = true;
+    });
+
+    std::atomic<size_t> num_finished_tasks{0};
+    clp_s::TaskGroup group{thread_pool};
+    for (size_t i = 0; i < cNumTasks; ++i) {
+        group.submit([&](size_t) { ++num_finished_tasks; });
+    }
+
+    // Waiting on a group only waits for its own tasks
+    group.wait();
+    REQUIRE(cNumTasks == num_finished_tasks.load());
+    REQUIRE(false == has_blocked_task_finished.load());
+
+    release_blocked_task.set_value();
+    blocked_group.wait();
+    REQUIRE(has_blocked_task_finished.load());
+}
+
+TEST_CASE("clp-s-TaskGroup-exception", "[clp-s][ThreadPool]") {
+    // A single thread runs the tasks in submission order
+    clp_s::ThreadPool thread_pool{1};
+    clp_s::TaskGroup failing_group{thread_pool};
+    clp_s::TaskGroup other_group{thread_pool};
+
+    std::atomic<size_t> num_tasks_run_after_failure{0};
+    std::atomic<size_t> num_other_tasks_run{0};
+    failing_group.submit([](size_t) { throw std::runtime_error{"task failed"}; });
+    failing_group.submit([&](size_t) { ++num_tasks_run_after_failure; });
+    other_group.submit([&](size_t) { ++num_other_tasks_run; });
+
+    // The group's remaining tasks are skipped and its first exception is rethrown
+    REQUIRE_THROWS_WITH(failing_group.wait(), "task failed");
+    REQUIRE(0 == num_tasks_run_after_failure.load());
+
+    // Other groups sharing the pool are unaffected
+    REQUIRE_NOTHROW(other_group.wait());
+    REQUIRE(1 == num_other_tasks_run.load());
+
+    // The exception is only rethrown once, after which the group runs tasks again
+    failing_group.submit([&](size_t) { ++num_tasks_run_after_failure; });
+    REQUIRE_NOTHROW(failing_group.wait());
+    REQUIRE(1 == num_tasks_run_after_failure.load());
+}
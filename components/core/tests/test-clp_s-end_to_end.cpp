@@ -1,9 +1,15 @@
 #include <sys/wait.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <filesystem>
+#include <fstream>
+#include <map>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include <catch2/catch.hpp>
 #include <fmt/format.h>
@@ -17,6 +23,7 @@
 constexpr std::string_view cTestEndToEndArchiveDirectory{"test-end-to-end-archive"};
 constexpr std::string_view cTestEndToEndOutputDirectory{"test-end-to-end-out"};
 constexpr std::string_view cTestEndToEndOutputSortedJson{"test-end-to-end_sorted.jsonl"};
+constexpr std::string_view cTestEndToEndOutputOrderedJson{"test-end-to-end_ordered.jsonl"};
 constexpr std::string_view cTestEndToEndInputFileDirectory{"test_log_files"};
 constexpr std::string_view cTestEndToEndInputFile{"test_no_floats_sorted.jsonl"};
 
@@ -24,7 +31,19 @@ namespace {
 auto get_test_input_path_relative_to_tests_dir() -> std::filesystem::path;
 auto get_test_input_local_path() -> std::string;
 auto extract() -> std::filesystem::path;
+auto extract_ordered(
+        size_t ordered_memory_budget,
+        size_t target_ordered_chunk_size,
+        size_t num_threads
+) -> std::filesystem::path;
+auto extract_log_event_range(int64_t begin_log_event_idx, int64_t end_log_event_idx)
+        -> std::filesystem::path;
 void compare(std::filesystem::path const& extracted_json_path);
+void compare_log_event_range(
+        std::filesystem::path const& extracted_json_path,
+        int64_t begin_log_event_idx,
+        int64_t end_log_event_idx
+);
 
 auto get_test_input_path_relative_to_tests_dir() -> std::filesystem::path {
     return std::filesystem::path{cTestEndToEndInputFileDirectory} / cTestEndToEndInputFile;
@@ -62,6 +81,104 @@ auto extract() -> std::filesystem::path {
     return extracted_json_path;
 }
 
+auto extract_ordered(
+        size_t ordered_memory_budget,
+        size_t target_ordered_chunk_size,
+        size_t num_threads
+) -> std::filesystem::path {
+    std::filesystem::create_directory(cTestEndToEndOutputDirectory);
+    REQUIRE(std::filesystem::is_directory(cTestEndToEndOutputDirectory));
+
+    clp_s::JsonConstructorOption constructor_option{};
+    constructor_option.output_dir = cTestEndToEndOutputDirectory;
+    constructor_option.ordered = true;
+    constructor_option.target_ordered_chunk_size = target_ordered_chunk_size;
+    constructor_option.ordered_memory_budget = ordered_memory_budget;
+    constructor_option.num_threads = num_threads;
+    for (auto const& entry : std::filesystem::directory_iterator(cTestEndToEndArchiveDirectory)) {
+        constructor_option.archive_path = clp_s::Path{
+                .source{clp_s::InputSource::Filesystem},
+                .path{entry.path().string()}
+        };
+        clp_s::JsonConstructor constructor{constructor_option};
+        constructor.store();
+    }
+
+    // Chunks are named "<archive-id>_<begin-idx>_<end-idx>.jsonl". No spill or temporary files
+    // should remain.
+    std::map<int64_t, std::pair<int64_t, std::filesystem::path>> chunks;
+    for (auto const& entry : std::filesystem::directory_iterator(cTestEndToEndOutputDirectory)) {
+        auto const& path = entry.path();
+        REQUIRE((".jsonl" == path.extension()));
+        auto const stem = path.stem().string();
+        auto const end_idx_pos = stem.rfind('_');
+        auto const begin_idx_pos = stem.rfind('_', end_idx_pos - 1);
+        REQUIRE((std::string::npos != end_idx_pos && std::string::npos != begin_idx_pos));
+        auto const begin_idx
+                = std::stoll(stem.substr(begin_idx_pos + 1, end_idx_pos - begin_idx_pos - 1));
+        auto const end_idx = std::stoll(stem.substr(end_idx_pos + 1));
+        chunks.emplace(begin_idx, std::make_pair(end_idx, path));
+    }
+    REQUIRE((false == chunks.empty()));
+    if (0 == target_ordered_chunk_size) {
+        REQUIRE((1 == chunks.size()));
+    }
+
+    // The chunks must cover consecutive ranges of log events
+    std::ofstream extracted_json{std::string{cTestEndToEndOutputOrderedJson}, std::ios::binary};
+    auto expected_begin_idx = chunks.begin()->first;
+    for (auto const& [begin_idx, chunk] : chunks) {
+        auto const& [end_idx, path] = chunk;
+        REQUIRE((expected_begin_idx == begin_idx));
+        REQUIRE((begin_idx < end_idx));
+        expected_begin_idx = end_idx;
+
+        // Chunks are cut in a single pass over the merged records regardless of the number of
+        // threads, so only the last chunk may be smaller than the target size
+        if (begin_idx != chunks.rbegin()->first) {
+            REQUIRE((std::filesystem::file_size(path) >= target_ordered_chunk_size));
+        }
+
+        std::ifstream chunk_json{path, std::ios::binary};
+        extracted_json << chunk_json.rdbuf();
+    }
+    extracted_json.close();
+
+    return std::filesystem::path{cTestEndToEndOutputOrderedJson};
+}
+
+auto extract_log_event_range(int64_t begin_log_event_idx, int64_t end_log_event_idx)
+        -> std::filesystem::path {
+    std::filesystem::create_directory(cTestEndToEndOutputDirectory);
+    REQUIRE(std::filesystem::is_directory(cTestEndToEndOutputDirectory));
+
+    clp_s::JsonConstructorOption constructor_option{};
+    constructor_option.output_dir = cTestEndToEndOutputDirectory;
+    constructor_option.log_event_idx_range = {begin_log_event_idx, end_log_event_idx};
+    std::vector<std::filesystem::path> extracted_json_paths;
+    for (auto const& entry : std::filesystem::directory_iterator(cTestEndToEndArchiveDirectory)) {
+        constructor_option.archive_path = clp_s::Path{
+                .source{clp_s::InputSource::Filesystem},
+                .path{entry.path().string()}
+        };
+        clp_s::JsonConstructor constructor{constructor_option};
+        constructor.store();
+        extracted_json_paths.emplace_back(
+                std::filesystem::path{cTestEndToEndOutputDirectory}
+                / fmt::format(
+                        "{}_{}_{}.jsonl",
+                        entry.path().filename().string(),
+                        begin_log_event_idx,
+                        end_log_event_idx
+                )
+        );
+    }
+    REQUIRE((1 == extracted_json_paths.size()));
+    REQUIRE(std::filesystem::exists(extracted_json_paths.front()));
+
+    return extracted_json_paths.front();
+}
+
 // Silence the checks below since our use of `std::system` is safe in the context of testing.
 // NOLINTBEGIN(cert-env33-c,concurrency-mt-unsafe)
 void compare(std::filesystem::path const& extracted_json_path) {
@@ -89,12 +206,32 @@ void compare(std::filesystem::path const& extracted_json_path) {
     REQUIRE((0 == WEXITSTATUS(result)));
 }
 
+void compare_log_event_range(
+        std::filesystem::path const& extracted_json_path,
+        int64_t begin_log_event_idx,
+        int64_t end_log_event_idx
+) {
+    // Log event indices follow the order of the input's lines, starting at zero
+    auto const command = fmt::format(
+            "jq --sort-keys --compact-output '.' {} | diff --unified <(sed -n '{},{}p' {}) - "
+            "> /dev/null",
+            extracted_json_path.string(),
+            begin_log_event_idx + 1,
+            end_log_event_idx,
+            get_test_input_local_path()
+    );
+    auto const result = std::system(fmt::format("bash -c \"{}\"", command).c_str());
+    REQUIRE((true == WIFEXITED(result)));
+    REQUIRE((0 == WEXITSTATUS(result)));
+}
+
 // NOLINTEND(cert-env33-c,concurrency-mt-unsafe)
 }  // namespace
 
 TEST_CASE("clp-s-compress-extract-no-floats", "[clp-s][end-to-end]") {
     auto structurize_arrays = GENERATE(true, false);
     auto single_file_archive = GENERATE(true, false);
+    auto num_threads = GENERATE(size_t{1}, size_t{4});
 
     TestOutputCleaner const test_cleanup{
             {std::string{cTestEndToEndArchiveDirectory},
@@ -107,10 +244,63 @@ TEST_CASE("clp-s-compress-extract-no-floats", "[clp-s][end-to-end]") {
             std::string{cTestEndToEndArchiveDirectory},
             single_file_archive,
             structurize_arrays,
-            clp_s::CommandLineArguments::FileType::Json
+            clp_s::CommandLineArguments::FileType::Json,
+            num_threads
     ));
 
     auto extracted_json_path = extract();
 
     compare(extracted_json_path);
 }
+
+TEST_CASE("clp-s-compress-extract-ordered", "[clp-s][end-to-end]") {
+    // A budget of one byte forces every table to be spilled
+    auto ordered_memory_budget = GENERATE(size_t{0}, size_t{1});
+    auto target_ordered_chunk_size = GENERATE(size_t{0}, size_t{512});
+    auto num_threads = GENERATE(size_t{1}, size_t{4});
+    auto single_file_archive = GENERATE(true, false);
+
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestEndToEndArchiveDirectory},
+             std::string{cTestEndToEndOutputDirectory},
+             std::string{cTestEndToEndOutputSortedJson},
+             std::string{cTestEndToEndOutputOrderedJson}}
+    };
+
+    REQUIRE_NOTHROW(compress_archive(
+            get_test_input_local_path(),
+            std::string{cTestEndToEndArchiveDirectory},
+            single_file_archive,
+            false,
+            clp_s::CommandLineArguments::FileType::Json,
+            1
+    ));
+
+    auto extracted_json_path
+            = extract_ordered(ordered_memory_budget, target_ordered_chunk_size, num_threads);
+
+    compare(extracted_json_path);
+}
+
+TEST_CASE("clp-s-compress-extract-log-event-range", "[clp-s][end-to-end]") {
+    constexpr int64_t cBeginLogEventIdx{1};
+    constexpr int64_t cEndLogEventIdx{3};
+    auto single_file_archive = GENERATE(true, false);
+
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestEndToEndArchiveDirectory}, std::string{cTestEndToEndOutputDirectory}}
+    };
+
+    REQUIRE_NOTHROW(compress_archive(
+            get_test_input_local_path(),
+            std::string{cTestEndToEndArchiveDirectory},
+            single_file_archive,
+            false,
+            clp_s::CommandLineArguments::FileType::Json,
+            1
+    ));
+
+    auto extracted_json_path = extract_log_event_range(cBeginLogEventIdx, cEndLogEventIdx);
+
+    compare_log_event_range(extracted_json_path, cBeginLogEventIdx, cEndLogEventIdx);
+}
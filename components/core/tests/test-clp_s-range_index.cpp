@@ -183,7 +183,8 @@ TEST_CASE("clp-s-range-index", "[clp-s][range-index]") {
             std::string{cTestRangeIndexArchiveDirectory},
             single_file_archive,
             false,
-            input_file_type
+            input_file_type,
+            1
     ));
     check_archive_metadata(from_ir);
 }
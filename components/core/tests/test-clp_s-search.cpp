@@ -1,11 +1,19 @@
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <filesystem>
+#include <fstream>
+#include <functional>
 #include <memory>
+#include <optional>
+#include <queue>
 #include <set>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -13,20 +21,31 @@
 #include <fmt/format.h>
 #include <nlohmann/json.hpp>
 
+#include "../src/clp_s/archive_constants.hpp"
+#include "../src/clp_s/archive_search.hpp"
+#include "../src/clp_s/ArchiveMetadataCache.hpp"
 #include "../src/clp_s/ArchiveReader.hpp"
 #include "../src/clp_s/CommandLineArguments.hpp"
+#include "../src/clp_s/Defs.hpp"
+#include "../src/clp_s/ErrorCode.hpp"
 #include "../src/clp_s/InputConfig.hpp"
+#include "../src/clp_s/search/ast/BooleanLiteral.hpp"
+#include "../src/clp_s/search/ast/ColumnDescriptor.hpp"
 #include "../src/clp_s/search/ast/ConvertToExists.hpp"
 #include "../src/clp_s/search/ast/EmptyExpr.hpp"
 #include "../src/clp_s/search/ast/Expression.hpp"
+#include "../src/clp_s/search/ast/FilterExpr.hpp"
+#include "../src/clp_s/search/ast/FilterOperation.hpp"
+#include "../src/clp_s/search/ast/Integral.hpp"
+#include "../src/clp_s/search/ast/Literal.hpp"
 #include "../src/clp_s/search/ast/NarrowTypes.hpp"
 #include "../src/clp_s/search/ast/OrOfAndForm.hpp"
-#include "../src/clp_s/search/EvaluateTimestampIndex.hpp"
+#include "../src/clp_s/search/ast/StringLiteral.hpp"
 #include "../src/clp_s/search/kql/kql.hpp"
-#include "../src/clp_s/search/Output.hpp"
 #include "../src/clp_s/search/OutputHandler.hpp"
-#include "../src/clp_s/search/Projection.hpp"
+#include "../src/clp_s/search/QueryRunner.hpp"
 #include "../src/clp_s/search/SchemaMatch.hpp"
+#include "../src/clp_s/ThreadPool.hpp"
 #include "../src/clp_s/Utils.hpp"
 #include "clp_s_test_utils.hpp"
 #include "TestOutputCleaner.hpp"
@@ -35,12 +54,272 @@ constexpr std::string_view cTestSearchArchiveDirectory{"test-clp-s-search-archiv
 constexpr std::string_view cTestInputFileDirectory{"test_log_files"};
 constexpr std::string_view cTestSearchInputFile{"test_search.jsonl"};
 constexpr std::string_view cTestIdxKey{"idx"};
+constexpr std::string_view cTestLatestResultsInputFile{"test-clp-s-search-latest-results.jsonl"};
+constexpr std::string_view cTestTimestampKey{"ts"};
+constexpr std::string_view cTestBatchFilterInputFile{"test-clp-s-search-batch-filter.jsonl"};
 
 namespace {
+/**
+ * Output handler that only counts matching log events, like the handler used by `clp-s s --count`,
+ * and counts the number of times it's finished.
+ */
+class CountingOutputHandler : public clp_s::search::OutputHandler {
+public:
+    // Constructors
+    CountingOutputHandler(uint64_t& count, size_t& num_finishes)
+            : OutputHandler{false, false},
+              m_count{count},
+              m_num_finishes{num_finishes} {}
+
+    // Methods inherited from OutputHandler
+    void write(
+            [[maybe_unused]] std::string_view message,
+            [[maybe_unused]] clp_s::epochtime_t timestamp,
+            [[maybe_unused]] std::string_view archive_id,
+            [[maybe_unused]] int64_t log_event_idx
+    ) override {
+        FAIL("Count-only searches shouldn't write log events");
+    }
+
+    void write([[maybe_unused]] std::string_view message) override {
+        FAIL("Count-only searches shouldn't write log events");
+    }
+
+    void write_count(uint64_t count) override { m_count += count; }
+
+    clp_s::ErrorCode finish() override {
+        ++m_num_finishes;
+        return clp_s::ErrorCode::ErrorCodeSuccess;
+    }
+
+private:
+    uint64_t& m_count;
+    size_t& m_num_finishes;
+};
+
+/**
+ * Output handler that counts the results written to it and records whether it was ever called
+ * concurrently.
+ */
+class ConcurrencyCheckingOutputHandler : public clp_s::search::OutputHandler {
+public:
+    // Constructors
+    ConcurrencyCheckingOutputHandler(
+            uint64_t& num_results,
+            uint64_t& count,
+            std::atomic<bool>& was_called_concurrently
+    )
+            : OutputHandler{false, false},
+              m_num_results{num_results},
+              m_count{count},
+              m_was_called_concurrently{was_called_concurrently} {}
+
+    // Methods inherited from OutputHandler
+    void write(
+            [[maybe_unused]] std::string_view message,
+            [[maybe_unused]] clp_s::epochtime_t timestamp,
+            [[maybe_unused]] std::string_view archive_id,
+            [[maybe_unused]] int64_t log_event_idx
+    ) override {
+        check_exclusive_call([&]() { ++m_num_results; });
+    }
+
+    void write([[maybe_unused]] std::string_view message) override {
+        check_exclusive_call([&]() { ++m_num_results; });
+    }
+
+    void write_count(uint64_t count) override {
+        check_exclusive_call([&]() { m_count += count; });
+    }
+
+private:
+    /**
+     * Runs the given function, recording whether another call is in progress at the same time.
+     * @param func
+     */
+    void check_exclusive_call(std::function<void()> const& func) {
+        if (m_is_in_call.exchange(true)) {
+            m_was_called_concurrently = true;
+        }
+        // Widen the window in which an unserialized call would overlap this one
+        std::this_thread::yield();
+        func();
+        m_is_in_call = false;
+    }
+
+    uint64_t& m_num_results;
+    uint64_t& m_count;
+    std::atomic<bool>& m_was_called_concurrently;
+    std::atomic<bool> m_is_in_call{false};
+};
+
+/**
+ * Output handler that only keeps the results with the latest timestamps until it's finished, like
+ * the results cache output handler, and counts every result written to it.
+ */
+class LatestResultsOutputHandler : public clp_s::search::OutputHandler {
+public:
+    // Constructors
+    LatestResultsOutputHandler(
+            uint64_t max_num_results,
+            std::vector<clp_s::epochtime_t>& kept_timestamps,
+            uint64_t& num_written_results
+    )
+            : OutputHandler{true, true},
+              m_max_num_results{max_num_results},
+              m_latest_results_tracker{max_num_results},
+              m_kept_timestamps{kept_timestamps},
+              m_num_written_results{num_written_results} {}
+
+    // Methods inherited from OutputHandler
+    void write(
+            [[maybe_unused]] std::string_view message,
+            clp_s::epochtime_t timestamp,
+            [[maybe_unused]] std::string_view archive_id,
+            [[maybe_unused]] int64_t log_event_idx
+    ) override {
+        ++m_num_written_results;
+        if (false == m_latest_results_tracker.add(timestamp)) {
+            return;
+        }
+        if (m_latest_timestamps.size() >= m_max_num_results) {
+            m_latest_timestamps.pop();
+        }
+        m_latest_timestamps.push(timestamp);
+    }
+
+    void write(std::string_view message) override { write(message, 0, {}, 0); }
+
+    clp_s::ErrorCode finish() override {
+        while (false == m_latest_timestamps.empty()) {
+            m_kept_timestamps.push_back(m_latest_timestamps.top());
+            m_latest_timestamps.pop();
+        }
+        return clp_s::ErrorCode::ErrorCodeSuccess;
+    }
+
+    [[nodiscard]] bool keeps_only_latest_results() const override { return true; }
+
+    [[nodiscard]] std::optional<clp_s::epochtime_t> get_latest_results_cutoff() const override {
+        return m_latest_results_tracker.get_cutoff();
+    }
+
+private:
+    uint64_t m_max_num_results;
+    clp_s::search::LatestResultsTracker m_latest_results_tracker;
+    std::priority_queue<clp_s::epochtime_t, std::vector<clp_s::epochtime_t>, std::greater<>>
+            m_latest_timestamps;
+    std::vector<clp_s::epochtime_t>& m_kept_timestamps;
+    uint64_t& m_num_written_results;
+};
+
+/**
+ * Query runner that checks that filtering a table in one batch selects the same messages as
+ * filtering it one message at a time.
+ */
+class BatchCheckingQueryRunner : public clp_s::search::QueryRunner {
+public:
+    // Constructors
+    using QueryRunner::QueryRunner;
+
+    // Methods
+    /**
+     * Filters every message of the table the runner was last initialized with, both in one batch
+     * and one message at a time, and requires that the results agree.
+     * @param num_messages
+     * @return The number of messages selected
+     */
+    auto check_batch_filter(uint64_t num_messages) -> uint64_t {
+        std::vector<uint8_t> selection(num_messages);
+        filter_batch(0, selection);
+        uint64_t num_selected{0};
+        for (uint64_t i = 0; i < num_messages; ++i) {
+            bool const is_selected = 0 != selection[i];
+            REQUIRE(filter(i) == is_selected);
+            if (is_selected) {
+                ++num_selected;
+            }
+        }
+        return num_selected;
+    }
+};
+
 auto get_test_input_path_relative_to_tests_dir() -> std::filesystem::path;
 auto get_test_input_local_path() -> std::string;
-void
-search(std::string const& query, bool ignore_case, std::vector<int64_t> const& expected_results);
+/**
+ * @return The paths of every archive in the test archive directory
+ */
+auto get_test_archive_paths() -> std::vector<clp_s::Path>;
+/**
+ * Parses a query without standardizing it, like `clp-s` does before searching.
+ * @param query
+ * @return The parsed query
+ */
+auto parse_kql_query(std::string const& query) -> std::shared_ptr<clp_s::search::ast::Expression>;
+auto parse_query(std::string const& query) -> std::shared_ptr<clp_s::search::ast::Expression>;
+/**
+ * Applies the passes that `clp-s` runs on every query before searching an archive.
+ * @param expr
+ * @return The standardized expression
+ */
+auto standardize_query(std::shared_ptr<clp_s::search::ast::Expression> expr)
+        -> std::shared_ptr<clp_s::search::ast::Expression>;
+/**
+ * @param column
+ * @param op
+ * @param operand
+ * @param inverted
+ * @return A standardized query containing a single filter
+ */
+auto create_filter_query(
+        std::string const& column,
+        clp_s::search::ast::FilterOperation op,
+        std::shared_ptr<clp_s::search::ast::Literal> operand,
+        bool inverted
+) -> std::shared_ptr<clp_s::search::ast::Expression>;
+/**
+ * Searches every archive in the test archive directory like `clp-s s` does.
+ * @param option
+ * @param query
+ * @param metadata_cache
+ * @param output_handler
+ * @return Whether the search succeeded
+ */
+auto search_test_archives(
+        clp_s::ArchiveSearchOption const& option,
+        std::string const& query,
+        std::shared_ptr<clp_s::ArchiveMetadataCache> const& metadata_cache,
+        std::unique_ptr<clp_s::search::OutputHandler> output_handler
+) -> bool;
+void search(
+        std::string const& query,
+        bool ignore_case,
+        size_t num_threads,
+        std::shared_ptr<clp_s::ArchiveMetadataCache> const& metadata_cache,
+        std::vector<int64_t> const& expected_results
+);
+auto count(std::string const& query, size_t num_threads) -> uint64_t;
+
+/**
+ * Writes an input file with four tables whose timestamps are in [1000, 1009], [2000, 2009],
+ * [3000, 3009], and [3005, 3005] respectively.
+ */
+void write_latest_results_input_file();
+
+/**
+ * Writes an input file with two tables that each contain integer, float, boolean, date string, clp
+ * string, and var string columns, with some columns of one table having a different type in the
+ * other.
+ */
+void write_batch_filter_input_file();
+
+/**
+ * Filters every table in the test archive directory that the query may match with a
+ * `BatchCheckingQueryRunner`.
+ * @param expr
+ * @return The number of messages selected
+ */
+auto check_batch_filter(std::shared_ptr<clp_s::search::ast::Expression> const& expr) -> uint64_t;
 void validate_results(
         std::vector<clp_s::search::VectorOutputHandler::QueryResult> const& results,
         std::vector<int64_t> const& expected_results
@@ -56,6 +335,115 @@ auto get_test_input_local_path() -> std::string {
     return (tests_dir / get_test_input_path_relative_to_tests_dir()).string();
 }
 
+auto get_test_archive_paths() -> std::vector<clp_s::Path> {
+    std::vector<clp_s::Path> archive_paths;
+    for (auto const& entry : std::filesystem::directory_iterator(cTestSearchArchiveDirectory)) {
+        archive_paths.push_back(
+                clp_s::Path{.source{clp_s::InputSource::Filesystem}, .path{entry.path().string()}}
+        );
+    }
+    return archive_paths;
+}
+
+void write_latest_results_input_file() {
+    constexpr int64_t cNumRecordsPerTable{10};
+    constexpr int64_t cNumTiedRecords{3};
+    std::ofstream input_file{std::string{cTestLatestResultsInputFile}};
+    REQUIRE(input_file.is_open());
+    for (int64_t i = 0; i < cNumRecordsPerTable; ++i) {
+        input_file << fmt::format("{{\"{}\": {}, \"a\": {}}}\n", cTestTimestampKey, 1000 + i, i);
+        input_file << fmt::format("{{\"{}\": {}, \"b\": {}}}\n", cTestTimestampKey, 2000 + i, i);
+        input_file << fmt::format("{{\"{}\": {}, \"c\": {}}}\n", cTestTimestampKey, 3000 + i, i);
+    }
+    for (int64_t i = 0; i < cNumTiedRecords; ++i) {
+        input_file << fmt::format("{{\"{}\": 3005, \"d\": {}}}\n", cTestTimestampKey, i);
+    }
+}
+
+void write_batch_filter_input_file() {
+    constexpr int64_t cNumRecords{200};
+    constexpr int64_t cOtherTablePeriod{4};
+    constexpr int64_t cNoVariablesPeriod{7};
+    std::ofstream input_file{std::string{cTestBatchFilterInputFile}};
+    REQUIRE(input_file.is_open());
+    for (int64_t i = 0; i < cNumRecords; ++i) {
+        auto const timestamp = fmt::format("2024-01-01T00:{:02}:{:02}.000", i / 60, i % 60);
+        if (0 == i % cOtherTablePeriod) {
+            input_file << fmt::format(
+                    "{{\"{}\": {}, \"{}\": \"{}\", \"int\": {}.5, \"bool\": \"true\", "
+                    "\"clp\": {}, \"var\": \"v{} took {} ms\"}}\n",
+                    cTestIdxKey,
+                    i,
+                    cTestTimestampKey,
+                    timestamp,
+                    i % 10,
+                    i % 10,
+                    i % 3,
+                    i
+            );
+            continue;
+        }
+        auto const clp = 0 == i % cNoVariablesPeriod
+                                 ? std::string{"no variables here"}
+                                 : fmt::format("Task {} took {} ms", i % 5, i);
+        input_file << fmt::format(
+                "{{\"{}\": {}, \"{}\": \"{}\", \"int\": {}, \"float\": {}.5, "
+                "\"bool\": {}, \"clp\": \"{}\", \"var\": \"v{}\"}}\n",
+                cTestIdxKey,
+                i,
+                cTestTimestampKey,
+                timestamp,
+                i % 10,
+                i % 10,
+                0 == i % 3 ? "true" : "false",
+                clp,
+                i % 3
+        );
+    }
+}
+
+auto check_batch_filter(std::shared_ptr<clp_s::search::ast::Expression> const& expr) -> uint64_t {
+    uint64_t num_selected{0};
+    for (auto const& entry : std::filesystem::directory_iterator(cTestSearchArchiveDirectory)) {
+        auto archive_reader = std::make_shared<clp_s::ArchiveReader>();
+        archive_reader->open(
+                clp_s::Path{.source{clp_s::InputSource::Filesystem}, .path{entry.path().string()}},
+                clp_s::NetworkAuthOption{}
+        );
+
+        auto archive_expr = expr->copy();
+        auto match_pass = std::make_shared<clp_s::search::SchemaMatch>(
+                archive_reader->get_schema_tree(),
+                archive_reader->get_schema_map()
+        );
+        archive_expr = match_pass->run(archive_expr);
+        if (nullptr == archive_expr) {
+            archive_reader->close();
+            continue;
+        }
+
+        archive_reader->read_metadata();
+        archive_reader->read_variable_dictionary();
+        archive_reader->read_log_type_dictionary();
+        archive_reader->open_packed_streams();
+
+        BatchCheckingQueryRunner query_runner{match_pass, archive_expr, archive_reader, false};
+        query_runner.global_init();
+        for (auto const schema_id : archive_reader->get_schema_ids()) {
+            if (false == match_pass->schema_matched(schema_id)
+                || clp_s::EvaluatedValue::False == query_runner.schema_init(schema_id))
+            {
+                continue;
+            }
+            auto& reader = archive_reader->read_schema_table(schema_id, false, false);
+            reader.initialize_filter(&query_runner);
+            num_selected += query_runner.check_batch_filter(reader.get_num_messages());
+        }
+        archive_reader->close();
+    }
+    return num_selected;
+}
+
 void validate_results(
         std::vector<clp_s::search::VectorOutputHandler::QueryResult> const& results,
         std::vector<int64_t> const& expected_results
@@ -76,14 +464,20 @@ void validate_results(
     REQUIRE(results.size() == expected_results.size());
 }
 
-void
-search(std::string const& query, bool ignore_case, std::vector<int64_t> const& expected_results) {
-    REQUIRE(expected_results.size() > 0);
+auto parse_kql_query(std::string const& query) -> std::shared_ptr<clp_s::search::ast::Expression> {
     auto query_stream = std::istringstream{query};
     auto expr = clp_s::search::kql::parse_kql_expression(query_stream);
     REQUIRE(nullptr != expr);
     REQUIRE(nullptr == std::dynamic_pointer_cast<clp_s::search::ast::EmptyExpr>(expr));
+    return expr;
+}
 
+auto parse_query(std::string const& query) -> std::shared_ptr<clp_s::search::ast::Expression> {
+    return standardize_query(parse_kql_query(query));
+}
+
+auto standardize_query(std::shared_ptr<clp_s::search::ast::Expression> expr)
+        -> std::shared_ptr<clp_s::search::ast::Expression> {
     clp_s::search::ast::OrOfAndForm standardize_pass;
     expr = standardize_pass.run(expr);
     REQUIRE(nullptr != expr);
@@ -95,43 +489,76 @@ search(std::string const& query, bool ignore_case, std::vector<int64_t> const& e
     clp_s::search::ast::ConvertToExists convert_pass;
     expr = convert_pass.run(expr);
     REQUIRE(nullptr != expr);
+    return expr;
+}
 
-    std::vector<clp_s::search::VectorOutputHandler::QueryResult> results;
-    for (auto const& entry : std::filesystem::directory_iterator(cTestSearchArchiveDirectory)) {
-        auto archive_reader = std::make_shared<clp_s::ArchiveReader>();
-        auto archive_path = clp_s::Path{
-                .source{clp_s::InputSource::Filesystem},
-                .path{entry.path().string()}
-        };
-        archive_reader->open(archive_path, clp_s::NetworkAuthOption{});
-
-        auto archive_expr = expr->copy();
-
-        auto timestamp_dict = archive_reader->get_timestamp_dictionary();
-        clp_s::search::EvaluateTimestampIndex timestamp_index_pass(timestamp_dict);
-        REQUIRE(clp_s::EvaluatedValue::False != timestamp_index_pass.run(archive_expr));
+auto create_filter_query(
+        std::string const& column,
+        clp_s::search::ast::FilterOperation op,
+        std::shared_ptr<clp_s::search::ast::Literal> operand,
+        bool inverted
+) -> std::shared_ptr<clp_s::search::ast::Expression> {
+    auto descriptor = clp_s::search::ast::ColumnDescriptor::create_from_escaped_tokens(
+            {column},
+            clp_s::constants::cDefaultNamespace
+    );
+    return standardize_query(
+            clp_s::search::ast::FilterExpr::create(descriptor, op, operand, inverted)
+    );
+}
 
-        auto match_pass = std::make_shared<clp_s::search::SchemaMatch>(
-                archive_reader->get_schema_tree(),
-                archive_reader->get_schema_map()
-        );
-        archive_expr = match_pass->run(archive_expr);
-        REQUIRE(nullptr != archive_expr);
-
-        auto output_handler = std::make_unique<clp_s::search::VectorOutputHandler>(results);
-        clp_s::search::Output output_pass(
-                match_pass,
-                archive_expr,
-                archive_reader,
-                std::move(output_handler),
-                ignore_case
-        );
-        output_pass.filter();
-        archive_reader->close();
-    }
+auto search_test_archives(
+        clp_s::ArchiveSearchOption const& option,
+        std::string const& query,
+        std::shared_ptr<clp_s::ArchiveMetadataCache> const& metadata_cache,
+        std::unique_ptr<clp_s::search::OutputHandler> output_handler
+) -> bool {
+    return clp_s::search_archives(
+            option,
+            query,
+            parse_kql_query(query),
+            get_test_archive_paths(),
+            metadata_cache,
+            std::move(output_handler)
+    );
+}
 
+void search(
+        std::string const& query,
+        bool ignore_case,
+        size_t num_threads,
+        std::shared_ptr<clp_s::ArchiveMetadataCache> const& metadata_cache,
+        std::vector<int64_t> const& expected_results
+) {
+    REQUIRE(expected_results.size() > 0);
+    clp_s::ArchiveSearchOption option;
+    option.ignore_case = ignore_case;
+    option.num_threads = num_threads;
+    std::vector<clp_s::search::VectorOutputHandler::QueryResult> results;
+    REQUIRE(search_test_archives(
+            option,
+            query,
+            metadata_cache,
+            std::make_unique<clp_s::search::VectorOutputHandler>(results)
+    ));
     validate_results(results, expected_results);
 }
+
+auto count(std::string const& query, size_t num_threads) -> uint64_t {
+    clp_s::ArchiveSearchOption option;
+    option.num_threads = num_threads;
+    uint64_t num_matches{0};
+    size_t num_finishes{0};
+    REQUIRE(search_test_archives(
+            option,
+            query,
+            nullptr,
+            std::make_unique<CountingOutputHandler>(num_matches, num_finishes)
+    ));
+    // One count is output for the whole search rather than one per archive
+    REQUIRE(1 == num_finishes);
+    return num_matches;
+}
 }  // namespace
 
 TEST_CASE("clp-s-search", "[clp-s][search]") {
@@ -152,6 +579,8 @@ TEST_CASE("clp-s-search", "[clp-s][search]") {
     };
     auto structurize_arrays = GENERATE(true, false);
     auto single_file_archive = GENERATE(true, false);
+    auto num_threads = GENERATE(size_t{1}, size_t{4});
+    auto use_metadata_cache = GENERATE(true, false);
 
     TestOutputCleaner const test_cleanup{{std::string{cTestSearchArchiveDirectory}}};
 
@@ -160,10 +589,487 @@ TEST_CASE("clp-s-search", "[clp-s][search]") {
             std::string{cTestSearchArchiveDirectory},
             single_file_archive,
             structurize_arrays,
-            clp_s::CommandLineArguments::FileType::Json
+            clp_s::CommandLineArguments::FileType::Json,
+            1
+    ));
+
+    constexpr size_t cMetadataCacheSize{64ULL * 1024 * 1024};
+    std::shared_ptr<clp_s::ArchiveMetadataCache> metadata_cache;
+    if (use_metadata_cache) {
+        metadata_cache = std::make_shared<clp_s::ArchiveMetadataCache>(cMetadataCacheSize);
+    }
+    for (auto const& [query, expected_results] : queries_and_results) {
+        REQUIRE_NOTHROW(search(query, false, num_threads, metadata_cache, expected_results));
+    }
+
+    if (use_metadata_cache) {
+        // Each archive's metadata is only read by its first search
+        auto const num_archives = metadata_cache->get_num_cached_archives();
+        REQUIRE(num_archives > 0);
+        REQUIRE(num_archives == metadata_cache->get_num_misses());
+        REQUIRE(metadata_cache->get_num_hits() == (queries_and_results.size() - 1) * num_archives);
+    }
+}
+
+TEST_CASE("clp-s-search-count", "[clp-s][search]") {
+    std::vector<std::pair<std::string, std::vector<int64_t>>> queries_and_results{
+            // Every table with an `idx` column matches in full, so no messages are evaluated
+            {R"aa(idx: *)aa", {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}},
+            // Only some of the messages in the table of `msg` values match
+            {R"aa(idx >= 5)aa", {5, 6, 7, 8, 9}},
+            {R"aa(msg: "*Abc123*")aa", {1, 2, 3, 5, 6}},
+            // Some tables match in full while others only match in part
+            {R"aa(a: * OR idx > 6)aa", {0, 7, 8, 9}}
+    };
+    auto single_file_archive = GENERATE(true, false);
+    auto num_threads = GENERATE(size_t{1}, size_t{4});
+
+    TestOutputCleaner const test_cleanup{{std::string{cTestSearchArchiveDirectory}}};
+
+    REQUIRE_NOTHROW(compress_archive(
+            get_test_input_local_path(),
+            std::string{cTestSearchArchiveDirectory},
+            single_file_archive,
+            true,
+            clp_s::CommandLineArguments::FileType::Json,
+            1
     ));
 
     for (auto const& [query, expected_results] : queries_and_results) {
-        REQUIRE_NOTHROW(search(query, false, expected_results));
+        INFO(query);
+        // The count must match the number of records that a search marshals
+        REQUIRE_NOTHROW(search(query, false, num_threads, nullptr, expected_results));
+        REQUIRE(expected_results.size() == count(query, num_threads));
+    }
+}
+
+TEST_CASE("clp-s-search-concurrent-archives", "[clp-s][search]") {
+    constexpr size_t cMetadataCacheSize{64ULL * 1024 * 1024};
+    constexpr size_t cNumArchives{3};
+    constexpr std::string_view cQuery{R"aa(msg: "*Abc123*")aa"};
+    std::set<int64_t> const expected_results{1, 2, 3, 5, 6};
+    auto num_concurrent_archives = GENERATE(size_t{1}, size_t{3});
+    auto num_threads = GENERATE(size_t{1}, size_t{4});
+    auto max_num_results = GENERATE(uint64_t{0}, uint64_t{4});
+
+    TestOutputCleaner const test_cleanup{{std::string{cTestSearchArchiveDirectory}}};
+
+    for (size_t i = 0; i < cNumArchives; ++i) {
+        REQUIRE_NOTHROW(compress_archive(
+                get_test_input_local_path(),
+                std::string{cTestSearchArchiveDirectory},
+                false,
+                true,
+                clp_s::CommandLineArguments::FileType::Json,
+                1
+        ));
+    }
+
+    clp_s::ArchiveSearchOption option;
+    option.num_threads = num_threads;
+    option.num_concurrent_archives = num_concurrent_archives;
+    option.max_num_results = max_num_results;
+
+    // Every archive is opened through the cache, so its misses count the archives searched
+    auto const metadata_cache = std::make_shared<clp_s::ArchiveMetadataCache>(cMetadataCacheSize);
+    std::vector<clp_s::search::VectorOutputHandler::QueryResult> results;
+    REQUIRE(search_test_archives(
+            option,
+            std::string{cQuery},
+            metadata_cache,
+            std::make_unique<clp_s::search::VectorOutputHandler>(results)
+    ));
+    std::multiset<int64_t> result_idxs;
+    for (auto const& result : results) {
+        result_idxs.insert(nlohmann::json::parse(result.message)[cTestIdxKey].get<int64_t>());
+    }
+
+    if (0 == max_num_results) {
+        // Every archive contributes all of its matches
+        REQUIRE(cNumArchives * expected_results.size() == results.size());
+        for (auto const idx : expected_results) {
+            REQUIRE(cNumArchives == result_idxs.count(idx));
+        }
+        REQUIRE(cNumArchives == metadata_cache->get_num_misses());
+    } else {
+        // Results beyond the limit are dropped, no matter which archives they come from
+        REQUIRE(max_num_results == results.size());
+        for (auto const idx : result_idxs) {
+            REQUIRE(expected_results.contains(idx));
+        }
+        if (1 == num_concurrent_archives) {
+            // The first archive reaches the limit, so the others aren't opened
+            REQUIRE(1 == metadata_cache->get_num_misses());
+        }
+    }
+
+    // Every archive's count goes to the one handler, which is finished once for the whole search
+    uint64_t num_matches{0};
+    size_t num_finishes{0};
+    REQUIRE(search_test_archives(
+            option,
+            std::string{cQuery},
+            nullptr,
+            std::make_unique<CountingOutputHandler>(num_matches, num_finishes)
+    ));
+    REQUIRE(cNumArchives * expected_results.size() == num_matches);
+    REQUIRE(1 == num_finishes);
+}
+
+TEST_CASE("clp-s-search-archive-errors", "[clp-s][search]") {
+    constexpr size_t cNumArchives{2};
+    constexpr std::string_view cQuery{R"aa(msg: "*Abc123*")aa"};
+    auto num_concurrent_archives = GENERATE(size_t{1}, size_t{3});
+
+    TestOutputCleaner const test_cleanup{{std::string{cTestSearchArchiveDirectory}}};
+
+    for (size_t i = 0; i < cNumArchives; ++i) {
+        REQUIRE_NOTHROW(compress_archive(
+                get_test_input_local_path(),
+                std::string{cTestSearchArchiveDirectory},
+                false,
+                true,
+                clp_s::CommandLineArguments::FileType::Json,
+                1
+        ));
+    }
+
+    clp_s::ArchiveSearchOption option;
+    option.num_concurrent_archives = num_concurrent_archives;
+
+    SECTION("Missing archive") {
+        auto archive_paths = get_test_archive_paths();
+        archive_paths.insert(
+                archive_paths.begin() + 1,
+                clp_s::Path{
+                        .source{clp_s::InputSource::Filesystem},
+                        .path{fmt::format("{}/missing-archive", cTestSearchArchiveDirectory)}
+                }
+        );
+        std::vector<clp_s::search::VectorOutputHandler::QueryResult> results;
+        REQUIRE(false
+                == clp_s::search_archives(
+                        option,
+                        std::string{cQuery},
+                        parse_kql_query(std::string{cQuery}),
+                        archive_paths,
+                        nullptr,
+                        std::make_unique<clp_s::search::VectorOutputHandler>(results)
+                ));
+    }
+
+    SECTION("Timestamp filter without a timestamp column") {
+        option.begin_ts = 0;
+        std::vector<clp_s::search::VectorOutputHandler::QueryResult> results;
+        REQUIRE(false
+                == search_test_archives(
+                        option,
+                        std::string{cQuery},
+                        nullptr,
+                        std::make_unique<clp_s::search::VectorOutputHandler>(results)
+                ));
+        REQUIRE(results.empty());
+    }
+}
+
+TEST_CASE("clp-s-search-timestamp-filters", "[clp-s][search]") {
+    constexpr size_t cNumArchives{2};
+    struct TestCase {
+        std::string query;
+        std::optional<clp_s::epochtime_t> begin_ts;
+        std::optional<clp_s::epochtime_t> end_ts;
+        size_t num_results_per_archive;
+    };
+    // The timestamp conditions are added to each archive's copy of the normalized query, so the
+    // combined query has to be normalized again, e.g., to distribute them over a disjunction
+    std::vector<TestCase> const test_cases{
+            {R"aa(a: * OR b: *)aa", 1005, 2004, 10},
+            {R"aa(NOT c: *)aa", 3000, std::nullopt, 3},
+            {R"aa(c > 4)aa", std::nullopt, 3007, 3},
+            {R"aa(a: * OR c: *)aa", 3010, 4000, 0}
+    };
+    auto num_concurrent_archives = GENERATE(size_t{1}, size_t{2});
+    auto num_threads = GENERATE(size_t{1}, size_t{4});
+
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestSearchArchiveDirectory}, std::string{cTestLatestResultsInputFile}}
+    };
+
+    write_latest_results_input_file();
+    for (size_t i = 0; i < cNumArchives; ++i) {
+        REQUIRE_NOTHROW(compress_archive(
+                std::string{cTestLatestResultsInputFile},
+                std::string{cTestSearchArchiveDirectory},
+                false,
+                true,
+                clp_s::CommandLineArguments::FileType::Json,
+                1,
+                std::string{cTestTimestampKey}
+        ));
+    }
+
+    for (auto const& test_case : test_cases) {
+        INFO(test_case.query);
+        clp_s::ArchiveSearchOption option;
+        option.begin_ts = test_case.begin_ts;
+        option.end_ts = test_case.end_ts;
+        option.num_threads = num_threads;
+        option.num_concurrent_archives = num_concurrent_archives;
+        std::vector<clp_s::search::VectorOutputHandler::QueryResult> results;
+        REQUIRE(search_test_archives(
+                option,
+                test_case.query,
+                nullptr,
+                std::make_unique<clp_s::search::VectorOutputHandler>(results)
+        ));
+        REQUIRE(cNumArchives * test_case.num_results_per_archive == results.size());
+        for (auto const& result : results) {
+            auto const timestamp = nlohmann::json::parse(result.message)[cTestTimestampKey]
+                                           .get<clp_s::epochtime_t>();
+            REQUIRE(timestamp >= test_case.begin_ts.value_or(clp_s::cEpochTimeMin));
+            REQUIRE(timestamp <= test_case.end_ts.value_or(clp_s::cEpochTimeMax));
+        }
+    }
+}
+
+TEST_CASE("clp-s-search-shared-output-handler", "[clp-s][search]") {
+    constexpr size_t cNumThreads{8};
+    constexpr uint64_t cNumResultsPerThread{1000};
+    auto max_num_results = GENERATE(uint64_t{0}, uint64_t{2500});
+
+    uint64_t num_results{0};
+    uint64_t count{0};
+    std::atomic<bool> was_called_concurrently{false};
+    clp_s::search::SharedOutputHandler shared_output_handler{
+            std::make_unique<ConcurrencyCheckingOutputHandler>(
+                    num_results,
+                    count,
+                    was_called_concurrently
+            ),
+            max_num_results
+    };
+
+    {
+        clp_s::ThreadPool thread_pool{cNumThreads};
+        for (size_t i = 0; i < cNumThreads; ++i) {
+            thread_pool.submit([&](size_t) {
+                auto output_handler = shared_output_handler.create_view();
+                for (uint64_t j = 0; j < cNumResultsPerThread; ++j) {
+                    output_handler->write("{}", 0, "", static_cast<int64_t>(j));
+                }
+                output_handler->write_count(1);
+                output_handler->flush();
+            });
+        }
+        thread_pool.wait();
+    }
+
+    REQUIRE(false == was_called_concurrently.load());
+    // Counts aren't limited
+    REQUIRE(cNumThreads == count);
+    if (0 == max_num_results) {
+        REQUIRE(cNumThreads * cNumResultsPerThread == num_results);
+        REQUIRE(false == shared_output_handler.is_result_limit_reached());
+    } else {
+        REQUIRE(max_num_results == num_results);
+        REQUIRE(shared_output_handler.is_result_limit_reached());
+    }
+    REQUIRE(clp_s::ErrorCode::ErrorCodeSuccess == shared_output_handler.finish());
+}
+
+TEST_CASE("clp-s-search-latest-results-tracker", "[clp-s][search]") {
+    REQUIRE(false == clp_s::search::LatestResultsTracker{0}.add(5));
+
+    clp_s::search::LatestResultsTracker tracker{3};
+    REQUIRE(tracker.add(5));
+    REQUIRE(tracker.add(7));
+    REQUIRE(false == tracker.get_cutoff().has_value());
+    REQUIRE(tracker.add(5));
+    REQUIRE(std::optional<clp_s::epochtime_t>{5} == tracker.get_cutoff());
+
+    // Results that tie with the cutoff are dropped, since the results written first are kept
+    REQUIRE(false == tracker.add(5));
+    REQUIRE(false == tracker.add(4));
+    REQUIRE(std::optional<clp_s::epochtime_t>{5} == tracker.get_cutoff());
+
+    // Later results evict the earliest kept result
+    REQUIRE(tracker.add(6));
+    REQUIRE(std::optional<clp_s::epochtime_t>{5} == tracker.get_cutoff());
+    REQUIRE(tracker.add(8));
+    REQUIRE(std::optional<clp_s::epochtime_t>{6} == tracker.get_cutoff());
+}
+
+TEST_CASE("clp-s-search-latest-results", "[clp-s][search]") {
+    constexpr uint64_t cMaxNumResults{5};
+    constexpr size_t cMetadataCacheSize{64ULL * 1024 * 1024};
+    constexpr uint64_t cNumRecords{33};
+    constexpr uint64_t cNumRecordsInLatestTable{10};
+    std::vector<clp_s::epochtime_t> const expected_latest_timestamps{3009, 3008, 3007, 3006, 3005};
+    auto num_threads = GENERATE(size_t{1}, size_t{4});
+    // Archives written before table statistics existed only have the timestamp dictionary
+    auto has_table_statistics = GENERATE(true, false);
+
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestSearchArchiveDirectory}, std::string{cTestLatestResultsInputFile}}
+    };
+
+    write_latest_results_input_file();
+    REQUIRE_NOTHROW(compress_archive(
+            std::string{cTestLatestResultsInputFile},
+            std::string{cTestSearchArchiveDirectory},
+            false,
+            true,
+            clp_s::CommandLineArguments::FileType::Json,
+            1,
+            std::string{cTestTimestampKey}
+    ));
+
+    auto const metadata_cache = std::make_shared<clp_s::ArchiveMetadataCache>(cMetadataCacheSize);
+    for (auto const& entry : std::filesystem::directory_iterator(cTestSearchArchiveDirectory)) {
+        auto const archive_path = clp_s::Path{
+                .source{clp_s::InputSource::Filesystem},
+                .path{entry.path().string()}
+        };
+
+        // Opening the archive caches its metadata, from which the table statistics can be removed
+        std::string archive_id;
+        {
+            clp_s::ArchiveReader archive_reader;
+            archive_reader.set_metadata_cache(metadata_cache);
+            archive_reader.open(archive_path, clp_s::NetworkAuthOption{});
+            archive_id = archive_reader.get_archive_id();
+            archive_reader.close();
+        }
+        if (false == has_table_statistics) {
+            auto metadata
+                    = std::make_shared<clp_s::ArchiveMetadata>(*metadata_cache->get(archive_id));
+            metadata->id_to_table_statistics = nullptr;
+            metadata_cache->put(archive_id, std::move(metadata));
+        }
+
+        std::multiset<std::pair<clp_s::epochtime_t, clp_s::epochtime_t>> timestamp_ranges;
+        {
+            clp_s::ArchiveReader archive_reader;
+            archive_reader.set_metadata_cache(metadata_cache);
+            archive_reader.open(archive_path, clp_s::NetworkAuthOption{});
+            for (auto const schema_id : archive_reader.get_schema_ids()) {
+                auto const timestamp_range = archive_reader.get_timestamp_range(schema_id);
+                REQUIRE(timestamp_range.has_value());
+                timestamp_ranges.emplace(timestamp_range->min, timestamp_range->max);
+            }
+            archive_reader.close();
+        }
+        if (has_table_statistics) {
+            REQUIRE(timestamp_ranges
+                    == std::multiset<std::pair<clp_s::epochtime_t, clp_s::epochtime_t>>{
+                            {1000, 1009},
+                            {2000, 2009},
+                            {3000, 3009},
+                            {3005, 3005}
+                    });
+        } else {
+            // Every table falls back to the range of the timestamp column across the archive
+            REQUIRE(timestamp_ranges
+                    == std::multiset<std::pair<clp_s::epochtime_t, clp_s::epochtime_t>>{
+                            {1000, 3009},
+                            {1000, 3009},
+                            {1000, 3009},
+                            {1000, 3009}
+                    });
+        }
+
+        std::vector<clp_s::epochtime_t> kept_timestamps;
+        uint64_t num_written_results{0};
+        clp_s::ArchiveSearchOption option;
+        option.num_threads = num_threads;
+        auto const query = fmt::format("{} >= 0", cTestTimestampKey);
+        REQUIRE(clp_s::search_archives(
+                option,
+                query,
+                parse_kql_query(query),
+                {archive_path},
+                metadata_cache,
+                std::make_unique<LatestResultsOutputHandler>(
+                        cMaxNumResults,
+                        kept_timestamps,
+                        num_written_results
+                )
+        ));
+
+        // Only the latest results across every table are output, and results that tie with the
+        // cutoff don't displace them
+        std::sort(kept_timestamps.begin(), kept_timestamps.end(), std::greater<>{});
+        REQUIRE(expected_latest_timestamps == kept_timestamps);
+
+        if (has_table_statistics) {
+            // Once the table with the latest timestamps has been searched, no other table can
+            // contain a result later than the cutoff, including the table that ties with it
+            REQUIRE(cNumRecordsInLatestTable == num_written_results);
+        } else {
+            // Without table statistics, no table can be ruled out
+            REQUIRE(cNumRecords == num_written_results);
+        }
+    }
+}
+
+TEST_CASE("clp-s-search-batch-filter", "[clp-s][search]") {
+    using clp_s::search::ast::BooleanLiteral;
+    using clp_s::search::ast::FilterOperation;
+    using clp_s::search::ast::Integral;
+    using clp_s::search::ast::Literal;
+    using clp_s::search::ast::StringLiteral;
+
+    // 2024-01-01T00:01:00.000
+    constexpr int64_t cTimestamp{1'704'067'260'000};
+    std::vector<std::pair<std::string, std::shared_ptr<Literal>>> const filters{
+            {"int", Integral::create_from_int(3)},
+            {"float", Integral::create_from_float(3.5)},
+            {"bool", BooleanLiteral::create_from_bool(true)},
+            {std::string{cTestTimestampKey}, Integral::create_from_int(cTimestamp)},
+            // Matches messages through a subquery that requires a wildcard match
+            {"clp", StringLiteral::create("Task 2 took *")},
+            // Matches messages through a subquery without variables
+            {"clp", StringLiteral::create("no variables here")},
+            // Matches no logtype, so the filter has no clp query
+            {"clp", StringLiteral::create("unseen message")},
+            {"var", StringLiteral::create("v1")},
+            {"var", StringLiteral::create("v1 took *")}
+    };
+    std::vector<std::string> const queries{
+            R"aa(int > 3)aa",
+            R"aa(float <= 5.5)aa",
+            fmt::format("{} >= {}", cTestTimestampKey, cTimestamp),
+            R"aa(NOT clp: "Task 1 took *")aa",
+            R"aa(int: 3 AND NOT var: v2)aa",
+            R"aa(bool: true OR clp: "no variables here")aa",
+            R"aa(NOT (int < 5 OR clp: "Task 4 took *"))aa"
+    };
+
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestSearchArchiveDirectory}, std::string{cTestBatchFilterInputFile}}
+    };
+
+    write_batch_filter_input_file();
+    REQUIRE_NOTHROW(compress_archive(
+            std::string{cTestBatchFilterInputFile},
+            std::string{cTestSearchArchiveDirectory},
+            false,
+            true,
+            clp_s::CommandLineArguments::FileType::Json,
+            1,
+            std::string{cTestTimestampKey}
+    ));
+
+    for (auto const& [column, operand] : filters) {
+        for (auto const op : {FilterOperation::EQ, FilterOperation::NEQ}) {
+            for (auto const inverted : {false, true}) {
+                CAPTURE(column, op, inverted);
+                check_batch_filter(create_filter_query(column, op, operand, inverted));
+            }
+        }
+    }
+    for (auto const& query : queries) {
+        CAPTURE(query);
+        REQUIRE(check_batch_filter(parse_query(query)) > 0);
     }
 }
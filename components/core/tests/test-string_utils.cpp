@@ -1,7 +1,6 @@
+#include <array>
 #include <iostream>
 
-#include <boost/foreach.hpp>
-#include <boost/range/combine.hpp>
 #include <catch2/catch.hpp>
 #include <string_utils/string_utils.hpp>
 
@@ -14,8 +13,177 @@ using std::chrono::high_resolution_clock;
 using std::cout;
 using std::endl;
 using std::string;
+using std::string_view;
 using std::vector;
 
+namespace {
+// The byte-at-a-time matcher that wildcard_match_unsafe_case_sensitive used before its searches
+// were vectorized (with escapes no longer treating every later '?' as a literal). It's kept as a
+// reference for correctness and performance comparisons.
+inline bool byte_at_a_time_advance_tame_to_next_match(
+        char const*& tame_current,
+        char const*& tame_bookmark,
+        char const* tame_end,
+        char const*& wild_current
+) {
+    auto w = *wild_current;
+    if ('?' != w) {
+        // No need to check for '*' since the caller ensures wild doesn't
+        // contain consecutive '*'
+
+        // Handle escaped characters
+        if ('\\' == w) {
+            ++wild_current;
+            // This is safe without a bounds check since this the caller ensures
+            // there are no dangling escape characters
+            w = *wild_current;
+        }
+
+        // Advance tame_current until it matches wild_current
+        while (true) {
+            if (tame_end == tame_current) {
+                // Wild group is longer than last group in tame, so can't match
+                // e.g. "*abc" doesn't match "zab"
+                return false;
+            }
+            auto t = *tame_current;
+            if (t == w) {
+                break;
+            }
+            ++tame_current;
+        }
+    }
+
+    tame_bookmark = tame_current;
+
+    return true;
+}
+
+bool byte_at_a_time_wildcard_match(string_view tame, string_view wild) {
+    auto const tame_length = tame.length();
+    auto const wild_length = wild.length();
+    char const* tame_current = tame.data();
+    char const* wild_current = wild.data();
+    char const* tame_bookmark = nullptr;
+    char const* wild_bookmark = nullptr;
+    char const* tame_end = tame_current + tame_length;
+    char const* wild_end = wild_current + wild_length;
+
+    // Handle wild or tame being empty
+    if (0 == wild_length) {
+        return 0 == tame_length;
+    } else {
+        if (0 == tame_length) {
+            return "*" == wild;
+        }
+    }
+
+    char w;
+    char t;
+    while (true) {
+        w = *wild_current;
+        if ('*' == w) {
+            ++wild_current;
+            if (wild_end == wild_current) {
+                // Trailing '*' means everything remaining in tame will match
+                return true;
+            }
+
+            // Set wild and tame bookmarks
+            wild_bookmark = wild_current;
+            if (false
+                == byte_at_a_time_advance_tame_to_next_match(
+                        tame_current,
+                        tame_bookmark,
+                        tame_end,
+                        wild_current
+                ))
+            {
+                return false;
+            }
+        } else {
+            // Handle escaped characters
+            bool is_escaped = false;
+            if ('\\' == w) {
+                is_escaped = true;
+                ++wild_current;
+                // This is safe without a bounds check since this the caller
+                // ensures there are no dangling escape characters
+                w = *wild_current;
+            }
+
+            // Handle a mismatch
+            t = *tame_current;
+            if (!((false == is_escaped && '?' == w) || t == w)) {
+                if (nullptr == wild_bookmark) {
+                    // No bookmark to return to
+                    return false;
+                }
+
+                wild_current = wild_bookmark;
+                tame_current = tame_bookmark + 1;
+                if (false
+                    == byte_at_a_time_advance_tame_to_next_match(
+                            tame_current,
+                            tame_bookmark,
+                            tame_end,
+                            wild_current
+                    ))
+                {
+                    return false;
+                }
+            }
+        }
+
+        ++tame_current;
+        ++wild_current;
+
+        // Handle reaching the end of tame or wild
+        if (tame_end == tame_current) {
+            return (wild_end == wild_current
+                    || ('*' == *wild_current && (wild_current + 1) == wild_end));
+        } else {
+            if (wild_end == wild_current) {
+                if (nullptr == wild_bookmark) {
+                    // No bookmark to return to
+                    return false;
+                } else {
+                    wild_current = wild_bookmark;
+                    tame_current = tame_bookmark + 1;
+                    if (false
+                        == byte_at_a_time_advance_tame_to_next_match(
+                                tame_current,
+                                tame_bookmark,
+                                tame_end,
+                                wild_current
+                        ))
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @param tame
+ * @param wild
+ * @param case_sensitive_match
+ * @return Whether the two strings match, according to the byte-at-a-time matcher
+ */
+bool byte_at_a_time_wildcard_match(string_view tame, string_view wild, bool case_sensitive_match) {
+    if (case_sensitive_match) {
+        return byte_at_a_time_wildcard_match(tame, wild);
+    }
+    string lowercase_tame(tame);
+    clp::string_utils::to_lower(lowercase_tame);
+    string lowercase_wild(wild);
+    clp::string_utils::to_lower(lowercase_wild);
+    return byte_at_a_time_wildcard_match(lowercase_tame, lowercase_wild);
+}
+}  // namespace
+
 TEST_CASE("to_lower", "[to_lower]") {
     string str = "test123TEST";
     clp::string_utils::to_lower(str);
@@ -282,6 +450,38 @@ SCENARIO("Test case sensitive wild card match in all possible ways", "[wildcard]
             tameString = "ab?d", wildString = "\\ab?d";
             REQUIRE(wildcard_match_unsafe_case_sensitive(tameString, wildString) == true);
         }
+
+        GIVEN("\"?\" after an escaped character") {
+            tameString = "a*b", wildString = "\\a*?";
+            REQUIRE(wildcard_match_unsafe_case_sensitive(tameString, wildString) == true);
+
+            tameString = "*x", wildString = "\\*?";
+            REQUIRE(wildcard_match_unsafe_case_sensitive(tameString, wildString) == true);
+
+            tameString = "?x", wildString = "\\??";
+            REQUIRE(wildcard_match_unsafe_case_sensitive(tameString, wildString) == true);
+
+            tameString = "ab?cd", wildString = "*\\?c?";
+            REQUIRE(wildcard_match_unsafe_case_sensitive(tameString, wildString) == true);
+
+            tameString = "A?Bc", wildString = "a\\?b?";
+            REQUIRE(wildcard_match_unsafe(tameString, wildString, false) == true);
+        }
+    }
+
+    WHEN("Match unexpected when escape character(s) are used") {
+        GIVEN("Escaped \"?\" before \"?\"") {
+            tameString = "ax", wildString = "\\??";
+            REQUIRE(wildcard_match_unsafe_case_sensitive(tameString, wildString) == false);
+
+            tameString = "abxcd", wildString = "*\\?c?";
+            REQUIRE(wildcard_match_unsafe_case_sensitive(tameString, wildString) == false);
+        }
+
+        GIVEN("Escaped \"?\" after \"?\"") {
+            tameString = "**", wildString = "?\\?";
+            REQUIRE(wildcard_match_unsafe_case_sensitive(tameString, wildString) == false);
+        }
     }
 
     WHEN("Case wild card match is case insensitive") {
@@ -452,67 +652,169 @@ SCENARIO("Test case sensitive wild card match in all possible ways", "[wildcard]
     }
 }
 
+TEST_CASE("wildcard_match_unsafe_matches_byte_at_a_time", "[wildcard]") {
+    // Exhaustively compare against the byte-at-a-time matcher over short strings drawn from a small
+    // alphabet, which covers overlapping groups, case differences, and escaped wildcards
+    constexpr std::array cTameChars{'a', 'A', 'b', 'B', '?', '*', '\\', '1'};
+    constexpr std::array cWildTokens{"a", "A", "b", "?", "*", "\\?", "\\*", "\\\\", "1"};
+    constexpr size_t cMaxTameLength = 4;
+    constexpr size_t cMaxNumWildTokens = 3;
+
+    vector<string> tames{""};
+    for (size_t i = 0; i < tames.size(); ++i) {
+        if (tames[i].length() == cMaxTameLength) {
+            continue;
+        }
+        for (auto const c : cTameChars) {
+            tames.emplace_back(tames[i] + c);
+        }
+    }
+
+    vector<vector<string_view>> wild_token_sequences{{}};
+    vector<string> wilds;
+    for (size_t i = 0; i < wild_token_sequences.size(); ++i) {
+        auto const tokens = wild_token_sequences[i];
+        string wild;
+        for (auto const token : tokens) {
+            wild += token;
+        }
+        // The matcher requires wildcard strings without consecutive '*'
+        if (string::npos == wild.find("**")) {
+            wilds.emplace_back(wild);
+        }
+        if (tokens.size() == cMaxNumWildTokens) {
+            continue;
+        }
+        for (auto const* token : cWildTokens) {
+            auto extended_tokens = tokens;
+            extended_tokens.emplace_back(token);
+            wild_token_sequences.emplace_back(std::move(extended_tokens));
+        }
+    }
+
+    for (auto const& wild : wilds) {
+        for (auto const& tame : tames) {
+            for (auto const case_sensitive_match : {true, false}) {
+                // Only assert on mismatches since there are millions of combinations
+                if (byte_at_a_time_wildcard_match(tame, wild, case_sensitive_match)
+                    != wildcard_match_unsafe(tame, wild, case_sensitive_match))
+                {
+                    CAPTURE(tame, wild, case_sensitive_match);
+                    REQUIRE(false);
+                }
+            }
+        }
+    }
+
+    // Long strings exercise the word-at-a-time searches, including matches near word boundaries
+    string const long_tame = string(37, 'x') + "Needle" + string(21, 'y') + "nEEDLE";
+    for (auto const* wild : {"*needle*", "*NEEDLE", "*x?Needle*y?n*", "*needle*needle*", "*z*"}) {
+        for (auto const case_sensitive_match : {true, false}) {
+            CAPTURE(wild, case_sensitive_match);
+            REQUIRE(byte_at_a_time_wildcard_match(long_tame, wild, case_sensitive_match)
+                    == wildcard_match_unsafe(long_tame, wild, case_sensitive_match));
+        }
+    }
+}
+
 SCENARIO("Test wild card performance", "[wildcard performance]") {
     // This test is to ensure there is no performance regression
-    // We use our current implementation vs the next best implementation as a reference
-    // If performance becomes slower than our next best implementation, then it is considered a fail
+    // We use the byte-at-a-time implementation that the current implementation replaced as a
+    // reference. Both implementations are timed over realistic log lines, both case-sensitively
+    // and case-insensitively.
 
     high_resolution_clock::time_point t1, t2;
-    string tameStr, wildStr;
 
-    int const nReps = 1'000'000;
-    int testReps;
+    int const nReps = 100'000;
     bool allPassed_currentImplementation = true;
-    bool allPassed_nextBestImplementation = true;
+    bool allPassed_byteAtATimeImplementation = true;
 
     /***********************************************************************************************
      * Inputs Begin
      **********************************************************************************************/
     vector<string> tameVec, wildVec;
+    // Whether each input matches case-sensitively and case-insensitively
+    vector<bool> caseSensitiveMatchVec, caseInsensitiveMatchVec;
 
     // Typical apache log
-    tameVec.push_back(
+    tameVec.emplace_back(
             "64.242.88.10 - - [07/Mar/2004:16:06:51 -0800]"
             " \"GET /twiki/bin/rdiff/TWiki/NewUserTemplate?rev1=1.3&rev2=1.2 HTTP/1.1\" 200 4523"
     );
-    wildVec.push_back("*64.242.88.10*Mar/2004*GET*200*");
+    wildVec.emplace_back("*64.242.88.10*Mar/2004*GET*200*");
+    caseSensitiveMatchVec.push_back(true);
+    caseInsensitiveMatchVec.push_back(true);
+
+    // Typical Java application log
+    tameVec.emplace_back(
+            "2023-03-27 00:26:35.719 INFO [main] org.apache.hadoop.yarn.server.nodemanager"
+            ".containermanager.ContainerManagerImpl: Start request for"
+            " container_1679876543210_0042_01_000003 by user hadoop"
+    );
+    wildVec.emplace_back("*INFO*ContainerManagerImpl*container_*_0042_*");
+    caseSensitiveMatchVec.push_back(true);
+    caseInsensitiveMatchVec.push_back(true);
+
+    // Typical JSON log
+    tameVec.emplace_back(
+            R"({"timestamp":"2023-03-27T00:26:35.719Z","level":"ERROR","service":"payments",)"
+            R"("message":"Failed to charge card ending in 4242: upstream timeout after 3000 ms"})"
+    );
+    wildVec.emplace_back("*\"level\":\"error\"*upstream timeout*");
+    caseSensitiveMatchVec.push_back(false);
+    caseInsensitiveMatchVec.push_back(true);
+
+    // Typical syslog line that doesn't match
+    tameVec.emplace_back(
+            "Mar 27 00:26:35 host-17 sshd[20413]: Accepted publickey for deploy from 10.0.4.17"
+            " port 52814 ssh2: RSA SHA256:4aVf1Bq2c3D4e5F6g7H8i9J0kLmNoPqRsTuVwXyZ"
+    );
+    wildVec.emplace_back("*sshd*Failed password*");
+    caseSensitiveMatchVec.push_back(false);
+    caseInsensitiveMatchVec.push_back(false);
 
     /***********************************************************************************************
      * Inputs End
      **********************************************************************************************/
 
-    // Profile current implementation
-    testReps = nReps;
-    t1 = high_resolution_clock::now();
-    while (testReps--) {
-        BOOST_FOREACH (boost::tie(tameStr, wildStr), boost::combine(tameVec, wildVec)) {
-            allPassed_currentImplementation
-                    &= wildcard_match_unsafe_case_sensitive(tameStr, wildStr);
-        }
-    }
-    t2 = high_resolution_clock::now();
-    duration<double> timeSpan_currentImplementation = t2 - t1;
-
-    // Profile next best implementation
-    testReps = nReps;
-    t1 = high_resolution_clock::now();
-    while (testReps--) {
-        // Replace this part with slow implementation
-        BOOST_FOREACH (boost::tie(tameStr, wildStr), boost::combine(tameVec, wildVec)) {
-            allPassed_currentImplementation
-                    &= wildcard_match_unsafe_case_sensitive(tameStr, wildStr);
-        }
-    }
-    t2 = high_resolution_clock::now();
-    duration<double> timeSpan_nextBestImplementation = t2 - t1;
-    REQUIRE(allPassed_currentImplementation == true);
-
-    if (allPassed_currentImplementation) {
-        cout << "Passed performance test in " << (timeSpan_currentImplementation.count() * 1000)
-             << " milliseconds." << endl;
-    } else {
-        cout << "Failed performance test in " << (timeSpan_currentImplementation.count() * 1000)
-             << " milliseconds." << endl;
+    for (auto const case_sensitive_match : {true, false}) {
+        auto const& expectedMatchVec
+                = case_sensitive_match ? caseSensitiveMatchVec : caseInsensitiveMatchVec;
+
+        // Profile current implementation
+        t1 = high_resolution_clock::now();
+        for (int rep = 0; rep < nReps; ++rep) {
+            for (size_t i = 0; i < tameVec.size(); ++i) {
+                allPassed_currentImplementation
+                        &= wildcard_match_unsafe(tameVec[i], wildVec[i], case_sensitive_match)
+                           == expectedMatchVec[i];
+            }
+        }
+        t2 = high_resolution_clock::now();
+        duration<double> timeSpan_currentImplementation = t2 - t1;
+
+        // Profile byte-at-a-time implementation
+        t1 = high_resolution_clock::now();
+        for (int rep = 0; rep < nReps; ++rep) {
+            for (size_t i = 0; i < tameVec.size(); ++i) {
+                allPassed_byteAtATimeImplementation
+                        &= byte_at_a_time_wildcard_match(
+                                   tameVec[i],
+                                   wildVec[i],
+                                   case_sensitive_match
+                           )
+                           == expectedMatchVec[i];
+            }
+        }
+        t2 = high_resolution_clock::now();
+        duration<double> timeSpan_byteAtATimeImplementation = t2 - t1;
+
+        REQUIRE(allPassed_currentImplementation == true);
+        REQUIRE(allPassed_byteAtATimeImplementation == true);
+        cout << "Passed " << (case_sensitive_match ? "case-sensitive" : "case-insensitive")
+             << " performance test in " << (timeSpan_currentImplementation.count() * 1000)
+             << " milliseconds (byte-at-a-time implementation took "
+             << (timeSpan_byteAtATimeImplementation.count() * 1000) << " milliseconds)." << endl;
     }
 }
 